@@ -0,0 +1,120 @@
+//
+//  vector_benchmark.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "takram/math/fused.h"
+#include "takram/math/random.h"
+#include "takram/math/vector.h"
+
+namespace {
+
+using takram::math::Vec3f;
+using takram::math::Vec3d;
+
+constexpr std::size_t count = 1 << 16;
+constexpr int repeats = 200;
+
+template <class Function>
+void measure(const std::string& name, Function function) {
+  const auto start = std::chrono::steady_clock::now();
+  double checksum{};
+  for (int i = 0; i < repeats; ++i) {
+    checksum += function();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const std::chrono::duration<double, std::nano> elapsed = end - start;
+  std::cout << std::left << std::setw(32) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(3)
+            << elapsed.count() / (count * repeats) << " ns/vector"
+            << "  (" << checksum << ")" << std::endl;
+}
+
+}  // namespace
+
+int main() {
+  auto& random = takram::math::Random<>::shared();
+  std::vector<Vec3f> a(count);
+  std::vector<Vec3f> b(count);
+  std::vector<Vec3d> c(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    a[i] = Vec3f::random(-1, 1, &random);
+    b[i] = Vec3f::random(-1, 1, &random);
+    c[i] = Vec3d::random(-1, 1, &random);
+  }
+  std::vector<Vec3d> result(count);
+  const auto sum = [&result] {
+    double value{};
+    for (const auto& vector : result) {
+      value += vector.x;
+    }
+    return value;
+  };
+
+  measure("a + (b - a) * t", [&] {
+    for (std::size_t i = 0; i < count; ++i) {
+      result[i] = a[i] + (b[i] - a[i]) * 0.25f;
+    }
+    return sum();
+  });
+  measure("multiplyAdd(b - a, t, a)", [&] {
+    for (std::size_t i = 0; i < count; ++i) {
+      result[i] = multiplyAdd(b[i] - a[i], 0.25f, a[i]);
+    }
+    return sum();
+  });
+  measure("a * b + c", [&] {
+    for (std::size_t i = 0; i < count; ++i) {
+      result[i] = a[i] * b[i] + c[i];
+    }
+    return sum();
+  });
+  measure("multiplyAdd(a, b, c)", [&] {
+    for (std::size_t i = 0; i < count; ++i) {
+      result[i] = multiplyAdd(a[i], b[i], c[i]);
+    }
+    return sum();
+  });
+  measure("a * s + c * t", [&] {
+    for (std::size_t i = 0; i < count; ++i) {
+      result[i] = a[i] * 0.75f + c[i] * 0.25;
+    }
+    return sum();
+  });
+  measure("combine(a, s, c, t)", [&] {
+    for (std::size_t i = 0; i < count; ++i) {
+      result[i] = combine(a[i], 0.75f, c[i], 0.25);
+    }
+    return sum();
+  });
+  return 0;
+}
@@ -0,0 +1,42 @@
+//
+//  takram/math.cppm
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+// Primary module interface of takram.math. The partitions include the headers
+// in their global module fragments and export the public names, so that the
+// headers remain the single source of the definitions. Each partition also
+// instantiates the int, float and double specializations that the aliases
+// name, which lets importers reuse them instead of instantiating the class
+// templates in every translation unit.
+
+export module takram.math;
+
+export import :circle;
+export import :line;
+export import :random;
+export import :rectangle;
+export import :size;
+export import :triangle;
+export import :vector;
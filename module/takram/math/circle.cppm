@@ -0,0 +1,65 @@
+//
+//  takram/math/circle.cppm
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+module;
+
+#include "takram/math/circle.h"
+
+export module takram.math:circle;
+
+export namespace takram {
+namespace math {
+
+using math::Circle;
+using math::operator==;
+using math::operator!=;
+using math::operator<;
+using math::operator>;
+using math::operator<=;
+using math::operator>=;
+using math::Circle2;
+using math::Circle2i;
+using math::Circle2f;
+using math::Circle2d;
+
+}  // namespace math
+
+using math::Circle2;
+using math::Circle2i;
+using math::Circle2f;
+using math::Circle2d;
+
+}  // namespace takram
+
+namespace takram {
+namespace math {
+
+template class Circle<int, 2>;
+template class Circle<float, 2>;
+template class Circle<double, 2>;
+
+}  // namespace math
+}  // namespace takram
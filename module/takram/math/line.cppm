@@ -0,0 +1,74 @@
+//
+//  takram/math/line.cppm
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+module;
+
+#include "takram/math/line.h"
+
+export module takram.math:line;
+
+export namespace takram {
+namespace math {
+
+using math::operator==;
+using math::operator!=;
+using math::operator<<;
+using math::Line;
+using math::Line2;
+using math::Line2i;
+using math::Line2f;
+using math::Line2d;
+using math::Line3;
+using math::Line3i;
+using math::Line3f;
+using math::Line3d;
+
+}  // namespace math
+
+using math::Line;
+using math::Line2;
+using math::Line2i;
+using math::Line2f;
+using math::Line2d;
+using math::Line3;
+using math::Line3i;
+using math::Line3f;
+using math::Line3d;
+
+}  // namespace takram
+
+namespace takram {
+namespace math {
+
+template class Line<int, 2>;
+template class Line<float, 2>;
+template class Line<double, 2>;
+template class Line<int, 3>;
+template class Line<float, 3>;
+template class Line<double, 3>;
+
+}  // namespace math
+}  // namespace takram
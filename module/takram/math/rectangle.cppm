@@ -0,0 +1,77 @@
+//
+//  takram/math/rectangle.cppm
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+module;
+
+#include "takram/math/rectangle.h"
+
+export module takram.math:rectangle;
+
+export namespace takram {
+namespace math {
+
+using math::operator==;
+using math::operator!=;
+using math::operator<;
+using math::operator>;
+using math::operator<=;
+using math::operator>=;
+using math::operator<<;
+using math::Rect;
+using math::Rect2;
+using math::Rect2i;
+using math::Rect2f;
+using math::Rect2d;
+using math::Rectangle;
+using math::Rectangle2;
+using math::Rectangle2i;
+using math::Rectangle2f;
+using math::Rectangle2d;
+
+}  // namespace math
+
+using math::Rect;
+using math::Rect2;
+using math::Rect2i;
+using math::Rect2f;
+using math::Rect2d;
+using math::Rectangle;
+using math::Rectangle2;
+using math::Rectangle2i;
+using math::Rectangle2f;
+using math::Rectangle2d;
+
+}  // namespace takram
+
+namespace takram {
+namespace math {
+
+template class Rect<int, 2>;
+template class Rect<float, 2>;
+template class Rect<double, 2>;
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,136 @@
+//
+//  takram/math/vector.cppm
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+module;
+
+#include "takram/math/axis.h"
+#include "takram/math/constants.h"
+#include "takram/math/promotion.h"
+#include "takram/math/random.h"
+#include "takram/math/vector.h"
+
+export module takram.math:vector;
+
+// Vectors are exported together with the axis, constant and promotion
+// helpers that the other partitions build on.
+export namespace takram {
+namespace math {
+
+using math::Axis;
+using math::Promote;
+using math::pi;
+using math::half_pi;
+using math::third_pi;
+using math::quarter_pi;
+using math::two_pi;
+using math::tau;
+using math::e;
+using math::degree;
+using math::radian;
+using math::operator+;
+using math::operator-;
+using math::operator*;
+using math::operator/;
+using math::operator==;
+using math::operator!=;
+using math::operator<;
+using math::operator>;
+using math::operator<=;
+using math::operator>=;
+using math::operator<<;
+using math::Vec;
+using math::Vec2;
+using math::Vec2i;
+using math::Vec2f;
+using math::Vec2d;
+using math::Vec3;
+using math::Vec3i;
+using math::Vec3f;
+using math::Vec3d;
+using math::Vec4;
+using math::Vec4i;
+using math::Vec4f;
+using math::Vec4d;
+using math::Vector;
+using math::Vector2;
+using math::Vector2i;
+using math::Vector2f;
+using math::Vector2d;
+using math::Vector3;
+using math::Vector3i;
+using math::Vector3f;
+using math::Vector3d;
+using math::Vector4;
+using math::Vector4i;
+using math::Vector4f;
+using math::Vector4d;
+
+}  // namespace math
+
+using math::Vec;
+using math::Vec2;
+using math::Vec2i;
+using math::Vec2f;
+using math::Vec2d;
+using math::Vec3;
+using math::Vec3i;
+using math::Vec3f;
+using math::Vec3d;
+using math::Vec4;
+using math::Vec4i;
+using math::Vec4f;
+using math::Vec4d;
+using math::Vector;
+using math::Vector2;
+using math::Vector2i;
+using math::Vector2f;
+using math::Vector2d;
+using math::Vector3;
+using math::Vector3i;
+using math::Vector3f;
+using math::Vector3d;
+using math::Vector4;
+using math::Vector4i;
+using math::Vector4f;
+using math::Vector4d;
+
+}  // namespace takram
+
+namespace takram {
+namespace math {
+
+template class Vec<int, 2>;
+template class Vec<float, 2>;
+template class Vec<double, 2>;
+template class Vec<int, 3>;
+template class Vec<float, 3>;
+template class Vec<double, 3>;
+template class Vec<int, 4>;
+template class Vec<float, 4>;
+template class Vec<double, 4>;
+
+}  // namespace math
+}  // namespace takram
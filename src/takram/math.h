@@ -38,16 +38,42 @@ extern const unsigned char version_string[];
 }  // namespace takram
 
 #include "takram/math/axis.h"
+#include "takram/math/blend.h"
+#include "takram/math/bounding.h"
+#include "takram/math/buffer_layout.h"
+#include "takram/math/camera.h"
 #include "takram/math/circle.h"
+#include "takram/math/color.h"
 #include "takram/math/constants.h"
+#include "takram/math/decomposition.h"
+#include "takram/math/distortion.h"
+#include "takram/math/ellipse.h"
+#include "takram/math/fitting.h"
 #include "takram/math/functions.h"
+#include "takram/math/fused.h"
+#include "takram/math/fwd.h"
+#include "takram/math/gjk.h"
+#include "takram/math/homography.h"
+#include "takram/math/icp.h"
+#include "takram/math/kd_tree.h"
 #include "takram/math/line.h"
+#include "takram/math/matrix.h"
+#include "takram/math/neighbors.h"
+#include "takram/math/oriented_rectangle.h"
 #include "takram/math/promotion.h"
 #include "takram/math/random.h"
+#include "takram/math/rasterize.h"
 #include "takram/math/rectangle.h"
 #include "takram/math/roots.h"
 #include "takram/math/size.h"
+#include "takram/math/skinning.h"
+#include "takram/math/span.h"
+#include "takram/math/statistics.h"
+#include "takram/math/stroke.h"
+#include "takram/math/support.h"
+#include "takram/math/traversal.h"
 #include "takram/math/triangle.h"
 #include "takram/math/vector.h"
+#include "takram/math/voxelizer.h"
 
 #endif  // TAKRAM_MATH_H_
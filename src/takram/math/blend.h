@@ -0,0 +1,499 @@
+//
+//  takram/math/blend.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_BLEND_H_
+#define TAKRAM_MATH_BLEND_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+
+#include "takram/math/enablers.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+enum class CompositeOperation : int {
+  CLEAR = 0,
+  SOURCE = 1,
+  DESTINATION = 2,
+  SOURCE_OVER = 3,
+  DESTINATION_OVER = 4,
+  SOURCE_IN = 5,
+  DESTINATION_IN = 6,
+  SOURCE_OUT = 7,
+  DESTINATION_OUT = 8,
+  SOURCE_ATOP = 9,
+  DESTINATION_ATOP = 10,
+  XOR = 11
+};
+
+enum class BlendMode : int {
+  NORMAL = 0,
+  MULTIPLY = 1,
+  SCREEN = 2,
+  OVERLAY = 3
+};
+
+// Colors are RGBA with premultiplied alpha, either floating-point with
+// components in [0, 1] or 8-bit with components in [0, 255]. 8-bit colors are
+// computed with integers and rounded to the nearest, while floating-point
+// colors are left unclamped.
+//
+// composite() applies one of the Porter-Duff operators, and blend() places
+// the source over the destination with a separable blend mode. The batch
+// versions write into the destination in place. The region versions address
+// pixel (x, y) at buffer[y * stride + x] in every buffer and process the
+// pixels inside the region.
+
+template <class T>
+class BlendLayer final {
+ public:
+  using Type = T;
+
+ public:
+  BlendLayer() : pixels(), stride(), mode(BlendMode::NORMAL) {}
+  BlendLayer(const Vec4<T> *pixels,
+             std::ptrdiff_t stride,
+             BlendMode mode = BlendMode::NORMAL)
+      : pixels(pixels), stride(stride), mode(mode) {}
+
+  // Copy semantics
+  BlendLayer(const BlendLayer&) = default;
+  BlendLayer& operator=(const BlendLayer&) = default;
+
+ public:
+  const Vec4<T> *pixels;
+  std::ptrdiff_t stride;
+  BlendMode mode;
+};
+
+template <class T>
+Vec4<T> composite(const Vec4<T>& source,
+                  const Vec4<T>& destination,
+                  CompositeOperation operation);
+template <class T>
+Vec4<T> blend(const Vec4<T>& source,
+              const Vec4<T>& destination,
+              BlendMode mode);
+
+template <class InputIterator, class ForwardIterator>
+ForwardIterator composite(InputIterator first,
+                          InputIterator last,
+                          ForwardIterator destination,
+                          CompositeOperation operation);
+template <class InputIterator, class ForwardIterator>
+ForwardIterator blend(InputIterator first,
+                      InputIterator last,
+                      ForwardIterator destination,
+                      BlendMode mode);
+
+template <class T>
+void composite(const Vec4<T> *source,
+               std::ptrdiff_t source_stride,
+               Vec4<T> *destination,
+               std::ptrdiff_t destination_stride,
+               const Rect2i& region,
+               CompositeOperation operation);
+template <class T>
+void blend(const Vec4<T> *source,
+           std::ptrdiff_t source_stride,
+           Vec4<T> *destination,
+           std::ptrdiff_t destination_stride,
+           const Rect2i& region,
+           BlendMode mode);
+
+// Blends the layers in order from the bottom, reading and writing each pixel
+// of the destination only once.
+template <class InputIterator, class T>
+void blend(InputIterator first,
+           InputIterator last,
+           Vec4<T> *destination,
+           std::ptrdiff_t destination_stride,
+           const Rect2i& region);
+
+#pragma mark -
+
+namespace blending {
+
+template <class T, class = void>
+struct Channel;
+
+template <class T>
+struct Channel<T, EnableIfFloating<T>> {
+  using Value = T;
+  static constexpr Value one() { return 1; }
+  static Value multiply(Value a, Value b) { return a * b; }
+  static T store(Value value) { return value; }
+};
+
+template <class T>
+struct Channel<T, EnableIfIntegral<T>> {
+  static_assert(std::is_same<T, std::uint8_t>::value,
+                "Integral channels must be 8-bit");
+  using Value = int;
+  static constexpr Value one() { return 255; }
+
+  // Exact rounded division of the product by 255
+  static Value multiply(Value a, Value b) {
+    const Value value = a * b + 128;
+    return (value + (value >> 8)) >> 8;
+  }
+
+  static T store(Value value) {
+    return static_cast<T>(std::max(0, std::min(value, 255)));
+  }
+};
+
+template <CompositeOperation Operation, class T>
+inline Vec4<T> composite(const Vec4<T>& source, const Vec4<T>& destination) {
+  using C = Channel<T>;
+  using V = typename C::Value;
+  const V one = C::one();
+  const V sa = source.w;
+  const V da = destination.w;
+  V fs{};
+  V fd{};
+  switch (Operation) {
+    case CompositeOperation::CLEAR: break;
+    case CompositeOperation::SOURCE: fs = one; break;
+    case CompositeOperation::DESTINATION: fd = one; break;
+    case CompositeOperation::SOURCE_OVER: fs = one; fd = one - sa; break;
+    case CompositeOperation::DESTINATION_OVER: fs = one - da; fd = one; break;
+    case CompositeOperation::SOURCE_IN: fs = da; break;
+    case CompositeOperation::DESTINATION_IN: fd = sa; break;
+    case CompositeOperation::SOURCE_OUT: fs = one - da; break;
+    case CompositeOperation::DESTINATION_OUT: fd = one - sa; break;
+    case CompositeOperation::SOURCE_ATOP: fs = da; fd = one - sa; break;
+    case CompositeOperation::DESTINATION_ATOP: fs = one - da; fd = sa; break;
+    case CompositeOperation::XOR: fs = one - da; fd = one - sa; break;
+  }
+  Vec4<T> result;
+  for (int i = 0; i < 4; ++i) {
+    result.at(i) = C::store(C::multiply(fs, source.at(i)) +
+                            C::multiply(fd, destination.at(i)));
+  }
+  return result;
+}
+
+template <BlendMode Mode, class T>
+inline Vec4<T> blend(const Vec4<T>& source, const Vec4<T>& destination) {
+  using C = Channel<T>;
+  using V = typename C::Value;
+  const V one = C::one();
+  const V sa = source.w;
+  const V da = destination.w;
+  Vec4<T> result;
+  for (int i = 0; i < 3; ++i) {
+    const V s = source.at(i);
+    const V d = destination.at(i);
+    V value;
+    switch (Mode) {
+      case BlendMode::NORMAL:
+        value = s + C::multiply(d, one - sa);
+        break;
+      case BlendMode::MULTIPLY:
+        value = (C::multiply(s, one - da) + C::multiply(d, one - sa) +
+                 C::multiply(s, d));
+        break;
+      case BlendMode::SCREEN:
+        value = s + d - C::multiply(s, d);
+        break;
+      case BlendMode::OVERLAY:
+        value = C::multiply(s, one - da) + C::multiply(d, one - sa);
+        if (2 * d <= da) {
+          value += 2 * C::multiply(s, d);
+        } else {
+          value += C::multiply(sa, da) - 2 * C::multiply(da - d, sa - s);
+        }
+        break;
+    }
+    result.at(i) = C::store(value);
+  }
+  result.w = C::store(sa + da - C::multiply(sa, da));
+  return result;
+}
+
+template <CompositeOperation Operation, class T>
+inline void compositeRow(const Vec4<T> *source,
+                         Vec4<T> *destination,
+                         std::ptrdiff_t size) {
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    destination[i] = composite<Operation>(source[i], destination[i]);
+  }
+}
+
+template <BlendMode Mode, class T>
+inline void blendRow(const Vec4<T> *source,
+                     Vec4<T> *destination,
+                     std::ptrdiff_t size) {
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    destination[i] = blend<Mode>(source[i], destination[i]);
+  }
+}
+
+// Dispatches once per row so that the inner loops are free of branches on the
+// operator or the mode.
+template <class T>
+inline void compositeRow(const Vec4<T> *source,
+                         Vec4<T> *destination,
+                         std::ptrdiff_t size,
+                         CompositeOperation operation) {
+  using O = CompositeOperation;
+  switch (operation) {
+    case O::CLEAR: compositeRow<O::CLEAR>(source, destination, size); break;
+    case O::SOURCE: compositeRow<O::SOURCE>(source, destination, size); break;
+    case O::DESTINATION: break;
+    case O::SOURCE_OVER:
+      compositeRow<O::SOURCE_OVER>(source, destination, size);
+      break;
+    case O::DESTINATION_OVER:
+      compositeRow<O::DESTINATION_OVER>(source, destination, size);
+      break;
+    case O::SOURCE_IN:
+      compositeRow<O::SOURCE_IN>(source, destination, size);
+      break;
+    case O::DESTINATION_IN:
+      compositeRow<O::DESTINATION_IN>(source, destination, size);
+      break;
+    case O::SOURCE_OUT:
+      compositeRow<O::SOURCE_OUT>(source, destination, size);
+      break;
+    case O::DESTINATION_OUT:
+      compositeRow<O::DESTINATION_OUT>(source, destination, size);
+      break;
+    case O::SOURCE_ATOP:
+      compositeRow<O::SOURCE_ATOP>(source, destination, size);
+      break;
+    case O::DESTINATION_ATOP:
+      compositeRow<O::DESTINATION_ATOP>(source, destination, size);
+      break;
+    case O::XOR: compositeRow<O::XOR>(source, destination, size); break;
+    default:
+      assert(false);
+      break;
+  }
+}
+
+template <class T>
+inline void blendRow(const Vec4<T> *source,
+                     Vec4<T> *destination,
+                     std::ptrdiff_t size,
+                     BlendMode mode) {
+  switch (mode) {
+    case BlendMode::NORMAL:
+      blendRow<BlendMode::NORMAL>(source, destination, size);
+      break;
+    case BlendMode::MULTIPLY:
+      blendRow<BlendMode::MULTIPLY>(source, destination, size);
+      break;
+    case BlendMode::SCREEN:
+      blendRow<BlendMode::SCREEN>(source, destination, size);
+      break;
+    case BlendMode::OVERLAY:
+      blendRow<BlendMode::OVERLAY>(source, destination, size);
+      break;
+    default:
+      assert(false);
+      break;
+  }
+}
+
+}  // namespace blending
+
+#pragma mark Pixels
+
+template <class T>
+inline Vec4<T> composite(const Vec4<T>& source,
+                         const Vec4<T>& destination,
+                         CompositeOperation operation) {
+  Vec4<T> result(destination);
+  blending::compositeRow(&source, &result, 1, operation);
+  return result;
+}
+
+template <class T>
+inline Vec4<T> blend(const Vec4<T>& source,
+                     const Vec4<T>& destination,
+                     BlendMode mode) {
+  Vec4<T> result(destination);
+  blending::blendRow(&source, &result, 1, mode);
+  return result;
+}
+
+#pragma mark Ranges
+
+template <class InputIterator, class ForwardIterator>
+inline ForwardIterator composite(InputIterator first,
+                                 InputIterator last,
+                                 ForwardIterator destination,
+                                 CompositeOperation operation) {
+  for (; first != last; ++first, ++destination) {
+    *destination = composite(*first, *destination, operation);
+  }
+  return destination;
+}
+
+template <class InputIterator, class ForwardIterator>
+inline ForwardIterator blend(InputIterator first,
+                             InputIterator last,
+                             ForwardIterator destination,
+                             BlendMode mode) {
+  for (; first != last; ++first, ++destination) {
+    *destination = blend(*first, *destination, mode);
+  }
+  return destination;
+}
+
+#pragma mark Regions
+
+template <class T>
+inline void composite(const Vec4<T> *source,
+                      std::ptrdiff_t source_stride,
+                      Vec4<T> *destination,
+                      std::ptrdiff_t destination_stride,
+                      const Rect2i& region,
+                      CompositeOperation operation) {
+  const std::ptrdiff_t x = region.minX();
+  const std::ptrdiff_t width = region.maxX() - region.minX();
+  for (std::ptrdiff_t y = region.minY(); y < region.maxY(); ++y) {
+    blending::compositeRow(source + y * source_stride + x,
+                           destination + y * destination_stride + x,
+                           width, operation);
+  }
+}
+
+template <class T>
+inline void blend(const Vec4<T> *source,
+                  std::ptrdiff_t source_stride,
+                  Vec4<T> *destination,
+                  std::ptrdiff_t destination_stride,
+                  const Rect2i& region,
+                  BlendMode mode) {
+  const std::ptrdiff_t x = region.minX();
+  const std::ptrdiff_t width = region.maxX() - region.minX();
+  for (std::ptrdiff_t y = region.minY(); y < region.maxY(); ++y) {
+    blending::blendRow(source + y * source_stride + x,
+                       destination + y * destination_stride + x,
+                       width, mode);
+  }
+}
+
+template <class InputIterator, class T>
+inline void blend(InputIterator first,
+                  InputIterator last,
+                  Vec4<T> *destination,
+                  std::ptrdiff_t destination_stride,
+                  const Rect2i& region) {
+  // Rows are processed in spans small enough to stay in the cache while every
+  // layer is blended into them.
+  constexpr std::ptrdiff_t span = 64;
+  Vec4<T> pixels[span];
+  for (std::ptrdiff_t y = region.minY(); y < region.maxY(); ++y) {
+    for (std::ptrdiff_t x = region.minX(); x < region.maxX(); x += span) {
+      const auto size = std::min<std::ptrdiff_t>(span, region.maxX() - x);
+      Vec4<T> *target = destination + y * destination_stride + x;
+      std::copy(target, target + size, pixels);
+      for (auto layer = first; layer != last; ++layer) {
+        blending::blendRow(layer->pixels + y * layer->stride + x,
+                           pixels, size, layer->mode);
+      }
+      std::copy(pixels, pixels + size, target);
+    }
+  }
+}
+
+#pragma mark Stream
+
+inline std::ostream& operator<<(std::ostream& os,
+                                CompositeOperation operation) {
+  switch (operation) {
+    case CompositeOperation::CLEAR: os << "clear"; break;
+    case CompositeOperation::SOURCE: os << "source"; break;
+    case CompositeOperation::DESTINATION: os << "destination"; break;
+    case CompositeOperation::SOURCE_OVER: os << "source over"; break;
+    case CompositeOperation::DESTINATION_OVER: os << "destination over"; break;
+    case CompositeOperation::SOURCE_IN: os << "source in"; break;
+    case CompositeOperation::DESTINATION_IN: os << "destination in"; break;
+    case CompositeOperation::SOURCE_OUT: os << "source out"; break;
+    case CompositeOperation::DESTINATION_OUT: os << "destination out"; break;
+    case CompositeOperation::SOURCE_ATOP: os << "source atop"; break;
+    case CompositeOperation::DESTINATION_ATOP: os << "destination atop"; break;
+    case CompositeOperation::XOR: os << "xor"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+inline std::ostream& operator<<(std::ostream& os, BlendMode mode) {
+  switch (mode) {
+    case BlendMode::NORMAL: os << "normal"; break;
+    case BlendMode::MULTIPLY: os << "multiply"; break;
+    case BlendMode::SCREEN: os << "screen"; break;
+    case BlendMode::OVERLAY: os << "overlay"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+}  // namespace math
+
+using math::CompositeOperation;
+using math::BlendMode;
+using math::BlendLayer;
+using math::composite;
+using math::blend;
+
+}  // namespace takram
+
+template <>
+struct std::hash<takram::math::CompositeOperation> {
+  std::size_t operator()(const takram::math::CompositeOperation& value) const {
+    return static_cast<std::underlying_type<
+        takram::math::CompositeOperation>::type>(value);
+  }
+};
+
+template <>
+struct std::hash<takram::math::BlendMode> {
+  std::size_t operator()(const takram::math::BlendMode& value) const {
+    return static_cast<std::underlying_type<
+        takram::math::BlendMode>::type>(value);
+  }
+};
+
+#endif  // TAKRAM_MATH_BLEND_H_
@@ -0,0 +1,278 @@
+//
+//  takram/math/bounding.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_BOUNDING_H_
+#define TAKRAM_MATH_BOUNDING_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "takram/math/constants.h"
+#include "takram/math/matrix.h"
+#include "takram/math/oriented_rectangle.h"
+#include "takram/math/promotion.h"
+#include "takram/math/statistics.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Writes the convex hull of the points in counterclockwise order without
+// collinear points, by Andrew's monotone chain.
+template <class InputIterator, class OutputIterator>
+OutputIterator convexHull(InputIterator first,
+                          InputIterator last,
+                          OutputIterator result);
+
+// Minimum-area rectangle enclosing the points, found by rotating calipers
+// over their convex hull in linear time after the hull.
+template <class InputIterator>
+OrientedRect2<Promote<typename std::iterator_traits<InputIterator>::
+    value_type::Type>>
+minimumAreaRect(InputIterator first, InputIterator last);
+
+// Box enclosing the points, aligned with their principal axes. Refinement
+// replaces each pair of axes by the minimum-area rectangle of the points
+// projected onto their plane whenever it reduces the volume, which fixes the
+// loose boxes that principal axes give for uniformly distributed points.
+template <class ForwardIterator>
+OrientedRect3<Promote<typename std::iterator_traits<ForwardIterator>::
+    value_type::Type>>
+principalAxesRect(ForwardIterator first,
+                  ForwardIterator last,
+                  bool refine = false);
+
+// Writes the indices of the rectangles that intersect the query.
+template <class InputIterator, class OutputIterator, class T, int D>
+OutputIterator intersections(InputIterator first,
+                             InputIterator last,
+                             const OrientedRect<T, D>& query,
+                             OutputIterator result);
+
+#pragma mark -
+
+template <class InputIterator, class OutputIterator>
+inline OutputIterator convexHull(InputIterator first,
+                                 InputIterator last,
+                                 OutputIterator result) {
+  using Point = typename std::iterator_traits<InputIterator>::value_type;
+  std::vector<Point> points(first, last);
+  std::sort(points.begin(), points.end(), [](const Point& a,
+                                             const Point& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+  });
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+  if (points.size() < 3) {
+    return std::copy(points.begin(), points.end(), result);
+  }
+  std::vector<Point> hull(2 * points.size());
+  std::size_t size = 0;
+  const auto turns = [&hull, &size](const Point& point) {
+    const auto& a = hull[size - 2];
+    const auto& b = hull[size - 1];
+    return (b - a).cross(point - a) > 0;
+  };
+  // Lower chain, then upper chain
+  for (const auto& point : points) {
+    while (size >= 2 && !turns(point)) {
+      --size;
+    }
+    hull[size++] = point;
+  }
+  const std::size_t lower = size + 1;
+  for (auto itr = std::next(points.rbegin()); itr != points.rend(); ++itr) {
+    while (size >= lower && !turns(*itr)) {
+      --size;
+    }
+    hull[size++] = *itr;
+  }
+  return std::copy(hull.begin(), hull.begin() + (size - 1), result);
+}
+
+template <class InputIterator>
+inline OrientedRect2<Promote<typename std::iterator_traits<InputIterator>::
+    value_type::Type>>
+minimumAreaRect(InputIterator first, InputIterator last) {
+  using T = typename std::iterator_traits<InputIterator>::value_type::Type;
+  using R = Promote<T>;
+  std::vector<Vec2<R>> hull;
+  convexHull(first, last, std::back_inserter(hull));
+  const std::size_t size = hull.size();
+  if (size < 2) {
+    return size ? OrientedRect2<R>(hull.front(), Vec2<R>()) :
+                  OrientedRect2<R>();
+  }
+  if (size == 2) {
+    const auto direction = hull[1] - hull[0];
+    return OrientedRect2<R>((hull[0] + hull[1]) / 2,
+                            Vec2<R>(direction.magnitude() / 2, R()),
+                            std::atan2(direction.y, direction.x));
+  }
+  // The hull lies to the left of each counterclockwise edge. Calipers track
+  // the farthest vertex along the edge, away from it, and against it.
+  const auto next = [size](std::size_t index) {
+    return index + 1 < size ? index + 1 : 0;
+  };
+  OrientedRect2<R> result;
+  R min_area = std::numeric_limits<R>::infinity();
+  std::size_t right = 0;
+  std::size_t top = 0;
+  std::size_t left = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto& origin = hull[i];
+    const auto u = (hull[next(i)] - origin).normalized();
+    const Vec2<R> v(-u.y, u.x);
+    if (!i) {
+      right = top = left = next(i);
+    }
+    while ((hull[next(right)] - origin).dot(u) >
+           (hull[right] - origin).dot(u)) {
+      right = next(right);
+    }
+    if (!i) {
+      top = right;
+    }
+    while ((hull[next(top)] - origin).dot(v) >
+           (hull[top] - origin).dot(v)) {
+      top = next(top);
+    }
+    if (!i) {
+      left = top;
+    }
+    while ((hull[next(left)] - origin).dot(u) <
+           (hull[left] - origin).dot(u)) {
+      left = next(left);
+    }
+    const R max_u = (hull[right] - origin).dot(u);
+    const R min_u = std::min((hull[left] - origin).dot(u), R());
+    const R max_v = (hull[top] - origin).dot(v);
+    const R area = (max_u - min_u) * max_v;
+    if (area < min_area) {
+      min_area = area;
+      result.set(origin + u * ((max_u + min_u) / 2) + v * (max_v / 2),
+                 Vec2<R>((max_u - min_u) / 2, max_v / 2),
+                 std::atan2(u.y, u.x));
+    }
+  }
+  return result;
+}
+
+namespace bounding {
+
+template <class R, class ForwardIterator>
+inline OrientedRect3<R> fitAxes(ForwardIterator first,
+                                ForwardIterator last,
+                                const Mat3<R>& axes) {
+  const Mat3<R> transposed = axes.transposed();
+  Vec3<R> min(std::numeric_limits<R>::infinity());
+  Vec3<R> max(-std::numeric_limits<R>::infinity());
+  for (; first != last; ++first) {
+    const Vec3<R> local = transposed * Vec3<R>(*first);
+    for (int i = 0; i < 3; ++i) {
+      min[i] = std::min(min[i], local[i]);
+      max[i] = std::max(max[i], local[i]);
+    }
+  }
+  return OrientedRect3<R>(axes * ((min + max) / 2), (max - min) / 2, axes);
+}
+
+}  // namespace bounding
+
+template <class ForwardIterator>
+inline OrientedRect3<Promote<typename std::iterator_traits<ForwardIterator>::
+    value_type::Type>>
+principalAxesRect(ForwardIterator first,
+                  ForwardIterator last,
+                  bool refine) {
+  using T = typename std::iterator_traits<ForwardIterator>::value_type::Type;
+  using R = Promote<T>;
+  if (first == last) {
+    return OrientedRect3<R>();
+  }
+  Mat3<R> axes;
+  PointStatistics3<T>(first, last).principalComponents(nullptr, &axes);
+  auto result = bounding::fitAxes(first, last, axes);
+  if (!refine) {
+    return result;
+  }
+  std::vector<Vec2<R>> projected;
+  for (int k = 0; k < 3; ++k) {
+    const int i = (k + 1) % 3;
+    const int j = (k + 2) % 3;
+    const Vec3<R> u = result.axes.column(i);
+    const Vec3<R> v = result.axes.column(j);
+    projected.clear();
+    for (auto itr = first; itr != last; ++itr) {
+      const Vec3<R> point(*itr);
+      projected.emplace_back(point.dot(u), point.dot(v));
+    }
+    const auto rect = minimumAreaRect(projected.begin(), projected.end());
+    // Rotating by a multiple of a right angle only permutes the pair of axes,
+    // which can then be accepted on rounding alone and leave another pair
+    // unrefined. Rotate by the remainder within a quarter turn instead.
+    const R angle = rect.angle -
+        std::round(rect.angle / half_pi<R>()) * half_pi<R>();
+    const R cosine = std::cos(angle);
+    const R sine = std::sin(angle);
+    Mat3<R> rotated = result.axes;
+    rotated.setColumn(i, u * cosine + v * sine);
+    rotated.setColumn(j, v * cosine - u * sine);
+    const auto candidate = bounding::fitAxes(first, last, rotated);
+    if (candidate.volume() < result.volume()) {
+      result = candidate;
+    }
+  }
+  return result;
+}
+
+template <class InputIterator, class OutputIterator, class T, int D>
+inline OutputIterator intersections(InputIterator first,
+                                    InputIterator last,
+                                    const OrientedRect<T, D>& query,
+                                    OutputIterator result) {
+  for (std::size_t index = 0; first != last; ++first, ++index) {
+    if (query.intersects(*first)) {
+      *result++ = index;
+    }
+  }
+  return result;
+}
+
+}  // namespace math
+
+using math::convexHull;
+using math::minimumAreaRect;
+using math::principalAxesRect;
+using math::intersections;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_BOUNDING_H_
@@ -0,0 +1,260 @@
+//
+//  takram/math/buffer_layout.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_BUFFER_LAYOUT_H_
+#define TAKRAM_MATH_BUFFER_LAYOUT_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+
+#include "takram/math/line.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/triangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+enum class BufferLayout : int {
+  STD140 = 0,
+  STD430 = 1
+};
+
+// Describes how a value is laid out in an array of a GPU buffer block. A
+// vector of two components is aligned to twice the size of its component, and
+// vectors of three or four components to four times. Lines, rectangles and
+// triangles are structures of vectors, which are aligned to their largest
+// member. std140 additionally rounds the alignment of array elements and
+// structures up to that of a vec4.
+//
+// size is the number of bytes the value occupies, stride is the distance
+// between consecutive elements of an array, and packed is true when the
+// in-memory representation is already identical to the element of the array
+// including its padding, in which case arrays are copied as a whole.
+template <class T, BufferLayout Layout, class = void>
+struct BufferTraits;
+
+template <BufferLayout Layout, class T>
+constexpr std::size_t bufferSize(std::size_t count);
+
+// Writes the values in the range into consecutive array elements of the
+// destination, filling padding with zeros, and returns the end of the written
+// bytes. Each element is assembled in full before it is stored.
+template <BufferLayout Layout, class InputIterator>
+void * writeBuffer(InputIterator first, InputIterator last, void *destination);
+
+#pragma mark -
+
+namespace buffer_layout {
+
+constexpr std::size_t roundUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+constexpr std::size_t elementAlignment(BufferLayout layout,
+                                       std::size_t alignment) {
+  return (layout == BufferLayout::STD140 && alignment < 16 ?
+          16 : alignment);
+}
+
+// Structure of count members of the same vector type
+template <class Member, int Count, BufferLayout Layout>
+struct Aggregate {
+  using MemberTraits = BufferTraits<Member, Layout>;
+  static constexpr const std::size_t offset = roundUp(
+      MemberTraits::size, MemberTraits::alignment);
+  static constexpr const std::size_t alignment = elementAlignment(
+      Layout, MemberTraits::alignment);
+  static constexpr const std::size_t size =
+      offset * (Count - 1) + MemberTraits::size;
+  static constexpr const std::size_t stride = roundUp(size, alignment);
+  static constexpr const bool packed = (
+      offset == sizeof(Member) &&
+      stride == sizeof(Member) * Count &&
+      MemberTraits::size == sizeof(Member));
+
+  template <class... Members>
+  static void write(unsigned char *destination, const Members&... members) {
+    static_assert(sizeof...(Members) == Count, "Wrong number of members");
+    const Member values[]{members...};
+    for (int i = 0; i < Count; ++i) {
+      MemberTraits::write(values[i], destination + offset * i);
+    }
+  }
+};
+
+template <BufferLayout Layout, class T>
+inline void * write(const T *first,
+                    const T *last,
+                    unsigned char *destination,
+                    std::true_type) {
+  const std::size_t size = (last - first) * sizeof(T);
+  if (size) {
+    std::memcpy(destination, first, size);
+  }
+  return destination + size;
+}
+
+template <BufferLayout Layout, class InputIterator>
+inline void * write(InputIterator first,
+                    InputIterator last,
+                    unsigned char *destination,
+                    std::false_type) {
+  using T = typename std::iterator_traits<InputIterator>::value_type;
+  using Traits = BufferTraits<T, Layout>;
+  for (; first != last; ++first, destination += Traits::stride) {
+    unsigned char element[Traits::stride]{};
+    Traits::write(*first, element);
+    std::memcpy(destination, element, Traits::stride);
+  }
+  return destination;
+}
+
+}  // namespace buffer_layout
+
+#pragma mark Traits
+
+template <class T, int D, BufferLayout Layout>
+struct BufferTraits<Vec<T, D>, Layout, typename std::enable_if<
+    std::is_arithmetic<T>::value && 2 <= D && D <= 4>::type> {
+  static constexpr const std::size_t size = sizeof(T) * D;
+  static constexpr const std::size_t alignment = sizeof(T) * (D == 2 ? 2 : 4);
+  static constexpr const std::size_t stride = buffer_layout::roundUp(
+      size, buffer_layout::elementAlignment(Layout, alignment));
+  static constexpr const bool packed = (stride == sizeof(Vec<T, D>));
+
+  static void write(const Vec<T, D>& value, unsigned char *destination) {
+    std::memcpy(destination, value.pointer(), size);
+  }
+};
+
+template <class T, BufferLayout Layout>
+struct BufferTraits<Rect2<T>, Layout>
+    : buffer_layout::Aggregate<Vec2<T>, 2, Layout> {
+  static_assert(!BufferTraits::packed ||
+                (sizeof(Rect2<T>) == BufferTraits::stride &&
+                 offsetof(Rect2<T>, size) == BufferTraits::offset),
+                "Rectangle must be laid out as its array element");
+
+  static void write(const Rect2<T>& value, unsigned char *destination) {
+    buffer_layout::Aggregate<Vec2<T>, 2, Layout>::write(
+        destination, value.origin, value.size.vector);
+  }
+};
+
+template <class T, int D, BufferLayout Layout>
+struct BufferTraits<Line<T, D>, Layout>
+    : buffer_layout::Aggregate<Vec<T, D>, 2, Layout> {
+  using Value = Line<T, D>;
+  static_assert(!BufferTraits::packed ||
+                (sizeof(Value) == BufferTraits::stride &&
+                 offsetof(Value, b) == BufferTraits::offset),
+                "Line must be laid out as its array element");
+
+  static void write(const Line<T, D>& value, unsigned char *destination) {
+    buffer_layout::Aggregate<Vec<T, D>, 2, Layout>::write(
+        destination, value.a, value.b);
+  }
+};
+
+template <class T, int D, BufferLayout Layout>
+struct BufferTraits<Triangle<T, D>, Layout>
+    : buffer_layout::Aggregate<Vec<T, D>, 3, Layout> {
+  using Value = Triangle<T, D>;
+  static_assert(!BufferTraits::packed ||
+                (sizeof(Value) == BufferTraits::stride &&
+                 offsetof(Value, b) == BufferTraits::offset &&
+                 offsetof(Value, c) == BufferTraits::offset * 2),
+                "Triangle must be laid out as its array element");
+
+  static void write(const Triangle<T, D>& value, unsigned char *destination) {
+    buffer_layout::Aggregate<Vec<T, D>, 3, Layout>::write(
+        destination, value.a, value.b, value.c);
+  }
+};
+
+#pragma mark Writing
+
+template <BufferLayout Layout, class T>
+constexpr std::size_t bufferSize(std::size_t count) {
+  return BufferTraits<T, Layout>::stride * count;
+}
+
+template <BufferLayout Layout, class InputIterator>
+inline void * writeBuffer(InputIterator first,
+                          InputIterator last,
+                          void *destination) {
+  using T = typename std::iterator_traits<InputIterator>::value_type;
+  using Traits = BufferTraits<T, Layout>;
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Value type must be trivially copyable");
+  static_assert(Traits::size <= Traits::stride,
+                "Value must fit in an array element");
+  static_assert(!Traits::packed || sizeof(T) == Traits::stride,
+                "Packed value must be the size of an array element");
+  using Contiguous = std::integral_constant<bool,
+      (std::is_pointer<InputIterator>::value && Traits::packed)>;
+  return buffer_layout::write<Layout>(
+      first, last, static_cast<unsigned char *>(destination), Contiguous());
+}
+
+#pragma mark Stream
+
+inline std::ostream& operator<<(std::ostream& os, BufferLayout layout) {
+  switch (layout) {
+    case BufferLayout::STD140: os << "std140"; break;
+    case BufferLayout::STD430: os << "std430"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+}  // namespace math
+
+using math::BufferLayout;
+using math::BufferTraits;
+using math::bufferSize;
+using math::writeBuffer;
+
+}  // namespace takram
+
+template <>
+struct std::hash<takram::math::BufferLayout> {
+  std::size_t operator()(const takram::math::BufferLayout& value) const {
+    return static_cast<std::underlying_type<
+        takram::math::BufferLayout>::type>(value);
+  }
+};
+
+#endif  // TAKRAM_MATH_BUFFER_LAYOUT_H_
@@ -0,0 +1,347 @@
+//
+//  takram/math/camera.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_CAMERA_H_
+#define TAKRAM_MATH_CAMERA_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+
+#include "takram/math/constants.h"
+#include "takram/math/line.h"
+#include "takram/math/matrix.h"
+#include "takram/math/promotion.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+enum class CameraProjection : int {
+  PERSPECTIVE = 0,
+  ORTHOGRAPHIC = 1
+};
+
+// Right-handed camera looking down its negative z axis, with clip space in the
+// convention of OpenGL. Screen coordinates lie in the viewport with y pointing
+// down, and depths in screen coordinates range from 0 at the near plane to 1
+// at the far plane. The view and projection matrices, their product and its
+// inverse are recomputed whenever a parameter changes, so that projection and
+// unprojection each cost a single matrix multiplication.
+template <class T>
+class Camera final {
+ public:
+  using Type = T;
+
+ public:
+  Camera();
+
+  // Copy semantics
+  Camera(const Camera&) = default;
+  Camera& operator=(const Camera&) = default;
+
+  // Parameters
+  CameraProjection projection() const { return projection_; }
+  void setProjection(CameraProjection value);
+  T fieldOfView() const { return field_of_view_; }
+  void setFieldOfView(T value);
+  T height() const { return height_; }
+  void setHeight(T value);
+  T nearPlane() const { return near_; }
+  T farPlane() const { return far_; }
+  void setClipping(T near_plane, T far_plane);
+  const Rect2<T>& viewport() const { return viewport_; }
+  void setViewport(const Rect2<T>& value);
+  Promote<T> aspect() const;
+
+  // View
+  const Vec3<T>& eye() const { return eye_; }
+  const Vec3<T>& target() const { return target_; }
+  const Vec3<T>& up() const { return up_; }
+  void lookAt(const Vec3<T>& eye, const Vec3<T>& target, const Vec3<T>& up);
+
+  // Matrices
+  const Mat4<T>& viewMatrix() const { return view_; }
+  const Mat4<T>& projectionMatrix() const { return projection_matrix_; }
+  const Mat4<T>& viewProjectionMatrix() const { return view_projection_; }
+  const Mat4<T>& inverseMatrix() const { return inverse_; }
+
+  // Projection to screen coordinates and depth. The batch version writes
+  // whether each point lies beyond the near plane to the mask.
+  template <class U = T>
+  Vec3<Promote<T, U>> project(const Vec3<U>& point) const;
+  template <class InputIterator, class OutputIterator, class MaskIterator>
+  OutputIterator project(InputIterator first,
+                         InputIterator last,
+                         OutputIterator result,
+                         MaskIterator mask) const;
+
+  // Unprojection from screen coordinates and depth
+  template <class U = T>
+  Vec3<Promote<T, U>> unproject(const Vec3<U>& point) const;
+  template <class InputIterator, class OutputIterator>
+  OutputIterator unproject(InputIterator first,
+                           InputIterator last,
+                           OutputIterator result) const;
+  template <class U = T>
+  Line3<Promote<T, U>> ray(const Vec2<U>& point) const;
+
+ private:
+  void update();
+
+ private:
+  CameraProjection projection_;
+  T field_of_view_;
+  T height_;
+  T near_;
+  T far_;
+  Rect2<T> viewport_;
+  Vec3<T> eye_;
+  Vec3<T> target_;
+  Vec3<T> up_;
+  Mat4<T> view_;
+  Mat4<T> projection_matrix_;
+  Mat4<T> view_projection_;
+  Mat4<T> inverse_;
+};
+
+using Cameraf = Camera<float>;
+using Camerad = Camera<double>;
+
+#pragma mark -
+
+template <class T>
+inline Camera<T>::Camera()
+    : projection_(CameraProjection::PERSPECTIVE),
+      field_of_view_(pi<T>() / 3),
+      height_(2),
+      near_(T(0.1)),
+      far_(1000),
+      viewport_(0, 0, 1, 1),
+      eye_(0, 0, 1),
+      target_(),
+      up_(0, 1, 0) {
+  update();
+}
+
+#pragma mark Parameters
+
+template <class T>
+inline void Camera<T>::setProjection(CameraProjection value) {
+  projection_ = value;
+  update();
+}
+
+template <class T>
+inline void Camera<T>::setFieldOfView(T value) {
+  assert(0 < value && value < pi<T>());
+  field_of_view_ = value;
+  update();
+}
+
+template <class T>
+inline void Camera<T>::setHeight(T value) {
+  assert(value > 0);
+  height_ = value;
+  update();
+}
+
+template <class T>
+inline void Camera<T>::setClipping(T near_plane, T far_plane) {
+  assert(near_plane != far_plane);
+  assert(projection_ == CameraProjection::ORTHOGRAPHIC || near_plane > 0);
+  near_ = near_plane;
+  far_ = far_plane;
+  update();
+}
+
+template <class T>
+inline void Camera<T>::setViewport(const Rect2<T>& value) {
+  assert(!value.empty());
+  viewport_ = value;
+  update();
+}
+
+template <class T>
+inline Promote<T> Camera<T>::aspect() const {
+  return static_cast<Promote<T>>(viewport_.width) / viewport_.height;
+}
+
+#pragma mark View
+
+template <class T>
+inline void Camera<T>::lookAt(const Vec3<T>& eye,
+                              const Vec3<T>& target,
+                              const Vec3<T>& up) {
+  assert(eye != target);
+  eye_ = eye;
+  target_ = target;
+  up_ = up;
+  update();
+}
+
+template <class T>
+inline void Camera<T>::update() {
+  const Vec3<T> z = (eye_ - target_).normalized();
+  const Vec3<T> x = up_.cross(z).normalized();
+  const Vec3<T> y = z.cross(x);
+  view_ = Mat4<T>({
+    x.x, x.y, x.z, -x.dot(eye_),
+    y.x, y.y, y.z, -y.dot(eye_),
+    z.x, z.y, z.z, -z.dot(eye_),
+    0, 0, 0, 1
+  });
+  const T n = near_;
+  const T f = far_;
+  if (projection_ == CameraProjection::PERSPECTIVE) {
+    const T scale = 1 / std::tan(field_of_view_ / 2);
+    projection_matrix_ = Mat4<T>({
+      scale / aspect(), 0, 0, 0,
+      0, scale, 0, 0,
+      0, 0, (f + n) / (n - f), 2 * f * n / (n - f),
+      0, 0, -1, 0
+    });
+  } else {
+    projection_matrix_ = Mat4<T>({
+      2 / (height_ * aspect()), 0, 0, 0,
+      0, 2 / height_, 0, 0,
+      0, 0, 2 / (n - f), (f + n) / (n - f),
+      0, 0, 0, 1
+    });
+  }
+  view_projection_ = projection_matrix_ * view_;
+  inverse_ = view_projection_.inverted();
+}
+
+#pragma mark Projection
+
+template <class T>
+template <class U>
+inline Vec3<Promote<T, U>> Camera<T>::project(const Vec3<U>& point) const {
+  using R = Promote<T, U>;
+  const Vec4<R> clip = view_projection_ * Vec4<R>(point.x, point.y, point.z, 1);
+  const R x = clip.x / clip.w;
+  const R y = clip.y / clip.w;
+  const R z = clip.z / clip.w;
+  return Vec3<R>(viewport_.x + (x + 1) / 2 * viewport_.width,
+                 viewport_.y + (1 - y) / 2 * viewport_.height,
+                 (z + 1) / 2);
+}
+
+template <class T>
+template <class InputIterator, class OutputIterator, class MaskIterator>
+inline OutputIterator Camera<T>::project(InputIterator first,
+                                         InputIterator last,
+                                         OutputIterator result,
+                                         MaskIterator mask) const {
+  using R = Promote<T>;
+  const auto& m = view_projection_;
+  const R sx = viewport_.width / R(2);
+  const R sy = viewport_.height / R(2);
+  const R ox = viewport_.x + sx;
+  const R oy = viewport_.y + sy;
+  for (; first != last; ++first, ++result, ++mask) {
+    const Vec3<R> point(*first);
+    const Vec4<R> clip = m * Vec4<R>(point.x, point.y, point.z, 1);
+    *mask = clip.w > 0 && clip.z >= -clip.w;
+    const R w = 1 / clip.w;
+    *result = Vec3<R>(ox + sx * clip.x * w,
+                      oy - sy * clip.y * w,
+                      (clip.z * w + 1) / 2);
+  }
+  return result;
+}
+
+#pragma mark Unprojection
+
+template <class T>
+template <class U>
+inline Vec3<Promote<T, U>> Camera<T>::unproject(const Vec3<U>& point) const {
+  using R = Promote<T, U>;
+  const Vec4<R> ndc(2 * (point.x - viewport_.x) / viewport_.width - 1,
+                    1 - 2 * (point.y - viewport_.y) / viewport_.height,
+                    2 * point.z - 1,
+                    1);
+  const Vec4<R> world = inverse_ * ndc;
+  return Vec3<R>(world.x / world.w, world.y / world.w, world.z / world.w);
+}
+
+template <class T>
+template <class InputIterator, class OutputIterator>
+inline OutputIterator Camera<T>::unproject(InputIterator first,
+                                           InputIterator last,
+                                           OutputIterator result) const {
+  for (; first != last; ++first, ++result) {
+    *result = unproject(*first);
+  }
+  return result;
+}
+
+template <class T>
+template <class U>
+inline Line3<Promote<T, U>> Camera<T>::ray(const Vec2<U>& point) const {
+  using R = Promote<T, U>;
+  return Line3<R>(unproject(Vec3<R>(point.x, point.y, 0)),
+                  unproject(Vec3<R>(point.x, point.y, 1)));
+}
+
+#pragma mark Stream
+
+inline std::ostream& operator<<(std::ostream& os,
+                                CameraProjection projection) {
+  switch (projection) {
+    case CameraProjection::PERSPECTIVE: os << "perspective"; break;
+    case CameraProjection::ORTHOGRAPHIC: os << "orthographic"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+}  // namespace math
+
+using math::CameraProjection;
+using math::Camera;
+using math::Cameraf;
+using math::Camerad;
+
+}  // namespace takram
+
+template <>
+struct std::hash<takram::math::CameraProjection> {
+  std::size_t operator()(const takram::math::CameraProjection& value) const {
+    return static_cast<std::underlying_type<
+        takram::math::CameraProjection>::type>(value);
+  }
+};
+
+#endif  // TAKRAM_MATH_CAMERA_H_
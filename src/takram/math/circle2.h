@@ -214,7 +214,7 @@ inline Circle2<T>& Circle<T, 2>::canonicalize() {
 
 template <class T>
 inline Circle2<Promote<T>> Circle<T, 2>::canonicalized() const {
-  return Circle2<Promote<T>>(*this).canonicalize();
+  return Circle2<Promote<T>>(Vec2<Promote<T>>(center), radius).canonicalize();
 }
 
 #pragma mark Containment
@@ -0,0 +1,563 @@
+//
+//  takram/math/color.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_COLOR_H_
+#define TAKRAM_MATH_COLOR_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+
+#include "takram/math/enablers.h"
+#include "takram/math/promotion.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Colors are RGB in Vec3 and RGBA in Vec4 with components in [0, 1]. Alpha
+// passes through every conversion unchanged. Hue, saturation, value and
+// lightness are all in [0, 1], CIELAB is relative to the D65 white point with
+// lightness in [0, 100], and both CIELAB and OKLab convert from and to linear
+// RGB with the primaries of sRGB.
+
+// sRGB transfer
+template <class T, EnableIfScalar<T> * = nullptr>
+Promote<T> srgbToLinear(T value);
+template <class T, EnableIfScalar<T> * = nullptr>
+Promote<T> linearToSrgb(T value);
+template <class T>
+Vec3<Promote<T>> srgbToLinear(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> srgbToLinear(const Vec4<T>& color);
+template <class T>
+Vec3<Promote<T>> linearToSrgb(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> linearToSrgb(const Vec4<T>& color);
+
+// The batch versions interpolate tables of the transfer functions, which stay
+// within 1e-4 of the exact functions in [0, 1], and evaluate the exact ones
+// outside that range.
+template <class InputIterator, class OutputIterator>
+OutputIterator srgbToLinear(InputIterator first,
+                            InputIterator last,
+                            OutputIterator result);
+template <class InputIterator, class OutputIterator>
+OutputIterator linearToSrgb(InputIterator first,
+                            InputIterator last,
+                            OutputIterator result);
+
+// HSV and HSL
+template <class T>
+Vec3<Promote<T>> rgbToHsv(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> rgbToHsv(const Vec4<T>& color);
+template <class T>
+Vec3<Promote<T>> hsvToRgb(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> hsvToRgb(const Vec4<T>& color);
+template <class T>
+Vec3<Promote<T>> rgbToHsl(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> rgbToHsl(const Vec4<T>& color);
+template <class T>
+Vec3<Promote<T>> hslToRgb(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> hslToRgb(const Vec4<T>& color);
+
+// CIELAB and OKLab
+template <class T>
+Vec3<Promote<T>> linearToLab(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> linearToLab(const Vec4<T>& color);
+template <class T>
+Vec3<Promote<T>> labToLinear(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> labToLinear(const Vec4<T>& color);
+template <class T>
+Vec3<Promote<T>> linearToOklab(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> linearToOklab(const Vec4<T>& color);
+template <class T>
+Vec3<Promote<T>> oklabToLinear(const Vec3<T>& color);
+template <class T>
+Vec4<Promote<T>> oklabToLinear(const Vec4<T>& color);
+
+// 8-bit packing, which clamps and rounds
+template <class T>
+Vec3<std::uint8_t> packColor(const Vec3<T>& color);
+template <class T>
+Vec4<std::uint8_t> packColor(const Vec4<T>& color);
+template <class T = float>
+Vec3<T> unpackColor(const Vec3<std::uint8_t>& color);
+template <class T = float>
+Vec4<T> unpackColor(const Vec4<std::uint8_t>& color);
+template <class InputIterator, class OutputIterator>
+OutputIterator packColor(InputIterator first,
+                         InputIterator last,
+                         OutputIterator result);
+template <class T = float, class InputIterator, class OutputIterator>
+OutputIterator unpackColor(InputIterator first,
+                           InputIterator last,
+                           OutputIterator result);
+
+#pragma mark -
+
+namespace colorspace {
+
+template <class T, class Function>
+inline Vec3<Promote<T>> apply(const Vec3<T>& color, Function function) {
+  return Vec3<Promote<T>>(function(color.x),
+                          function(color.y),
+                          function(color.z));
+}
+
+template <class T, class Function>
+inline Vec4<Promote<T>> apply(const Vec4<T>& color, Function function) {
+  return Vec4<Promote<T>>(function(color.x),
+                          function(color.y),
+                          function(color.z),
+                          color.w);
+}
+
+template <class T>
+inline Vec4<T> withAlpha(const Vec3<T>& color, T alpha) {
+  return Vec4<T>(color.x, color.y, color.z, alpha);
+}
+
+// Transfer function sampled at regular intervals in [0, 1]
+template <class T>
+class TransferTable final {
+ public:
+  static constexpr const int size = 4096;
+
+ public:
+  template <class Function>
+  explicit TransferTable(Function function) : function_(function) {
+    for (int i = 0; i <= size; ++i) {
+      values_[i] = function(static_cast<T>(i) / size);
+    }
+  }
+
+  T operator()(T value) const {
+    if (!(0 <= value && value <= 1)) {
+      return function_(value);
+    }
+    const T position = value * size;
+    const int index = std::min(static_cast<int>(position), size - 1);
+    const T fraction = position - index;
+    return values_[index] + (values_[index + 1] - values_[index]) * fraction;
+  }
+
+ private:
+  T (*function_)(T);
+  T values_[size + 1];
+};
+
+template <class T>
+inline T decode(T value) {
+  return srgbToLinear(value);
+}
+
+template <class T>
+inline T encode(T value) {
+  return linearToSrgb(value);
+}
+
+template <class T>
+inline const TransferTable<T>& decodingTable() {
+  static const TransferTable<T> table(&decode<T>);
+  return table;
+}
+
+template <class T>
+inline const TransferTable<T>& encodingTable() {
+  static const TransferTable<T> table(&encode<T>);
+  return table;
+}
+
+template <class T>
+inline Promote<T> hue(Promote<T> r, Promote<T> g, Promote<T> b,
+                      Promote<T> max, Promote<T> delta) {
+  using R = Promote<T>;
+  if (!delta) {
+    return R();
+  }
+  R hue;
+  if (max == r) {
+    hue = (g - b) / delta;
+  } else if (max == g) {
+    hue = (b - r) / delta + 2;
+  } else {
+    hue = (r - g) / delta + 4;
+  }
+  hue /= 6;
+  return hue < 0 ? hue + 1 : hue;
+}
+
+template <class T>
+inline T labForward(T value) {
+  const T delta = T(6) / 29;
+  return (value > delta * delta * delta ? std::cbrt(value) :
+          value / (3 * delta * delta) + T(4) / 29);
+}
+
+template <class T>
+inline T labInverse(T value) {
+  const T delta = T(6) / 29;
+  return (value > delta ? value * value * value :
+          3 * delta * delta * (value - T(4) / 29));
+}
+
+template <class T>
+inline std::uint8_t pack(T value) {
+  const auto clamped = std::max(T(), std::min(static_cast<T>(value), T(1)));
+  return static_cast<std::uint8_t>(clamped * 255 + T(0.5));
+}
+
+}  // namespace colorspace
+
+#pragma mark sRGB transfer
+
+template <class T, EnableIfScalar<T> *>
+inline Promote<T> srgbToLinear(T value) {
+  using R = Promote<T>;
+  return (value <= R(0.04045) ? value / R(12.92) :
+          std::pow((value + R(0.055)) / R(1.055), R(2.4)));
+}
+
+template <class T, EnableIfScalar<T> *>
+inline Promote<T> linearToSrgb(T value) {
+  using R = Promote<T>;
+  return (value <= R(0.0031308) ? value * R(12.92) :
+          R(1.055) * std::pow(static_cast<R>(value), 1 / R(2.4)) - R(0.055));
+}
+
+template <class T>
+inline Vec3<Promote<T>> srgbToLinear(const Vec3<T>& color) {
+  return colorspace::apply(color, [](T value) {
+    return srgbToLinear(value);
+  });
+}
+
+template <class T>
+inline Vec4<Promote<T>> srgbToLinear(const Vec4<T>& color) {
+  return colorspace::apply(color, [](T value) {
+    return srgbToLinear(value);
+  });
+}
+
+template <class T>
+inline Vec3<Promote<T>> linearToSrgb(const Vec3<T>& color) {
+  return colorspace::apply(color, [](T value) {
+    return linearToSrgb(value);
+  });
+}
+
+template <class T>
+inline Vec4<Promote<T>> linearToSrgb(const Vec4<T>& color) {
+  return colorspace::apply(color, [](T value) {
+    return linearToSrgb(value);
+  });
+}
+
+template <class InputIterator, class OutputIterator>
+inline OutputIterator srgbToLinear(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result) {
+  using T = Promote<typename std::iterator_traits<
+      InputIterator>::value_type::Type>;
+  const auto& table = colorspace::decodingTable<T>();
+  for (; first != last; ++first, ++result) {
+    *result = colorspace::apply(*first, table);
+  }
+  return result;
+}
+
+template <class InputIterator, class OutputIterator>
+inline OutputIterator linearToSrgb(InputIterator first,
+                                   InputIterator last,
+                                   OutputIterator result) {
+  using T = Promote<typename std::iterator_traits<
+      InputIterator>::value_type::Type>;
+  const auto& table = colorspace::encodingTable<T>();
+  for (; first != last; ++first, ++result) {
+    *result = colorspace::apply(*first, table);
+  }
+  return result;
+}
+
+#pragma mark HSV and HSL
+
+template <class T>
+inline Vec3<Promote<T>> rgbToHsv(const Vec3<T>& color) {
+  using R = Promote<T>;
+  const R r = color.x;
+  const R g = color.y;
+  const R b = color.z;
+  const R max = std::max(r, std::max(g, b));
+  const R delta = max - std::min(r, std::min(g, b));
+  return Vec3<R>(colorspace::hue<T>(r, g, b, max, delta),
+                 max ? delta / max : R(),
+                 max);
+}
+
+template <class T>
+inline Vec4<Promote<T>> rgbToHsv(const Vec4<T>& color) {
+  return colorspace::withAlpha(rgbToHsv(Vec3<T>(color)),
+                               Promote<T>(color.w));
+}
+
+template <class T>
+inline Vec3<Promote<T>> hsvToRgb(const Vec3<T>& color) {
+  using R = Promote<T>;
+  const R h = (color.x - std::floor(color.x)) * 6;
+  const R s = color.y;
+  const R v = color.z;
+  const int sector = std::min(static_cast<int>(h), 5);
+  const R f = h - sector;
+  const R p = v * (1 - s);
+  const R q = v * (1 - s * f);
+  const R t = v * (1 - s * (1 - f));
+  switch (sector) {
+    case 0: return Vec3<R>(v, t, p);
+    case 1: return Vec3<R>(q, v, p);
+    case 2: return Vec3<R>(p, v, t);
+    case 3: return Vec3<R>(p, q, v);
+    case 4: return Vec3<R>(t, p, v);
+    default: return Vec3<R>(v, p, q);
+  }
+}
+
+template <class T>
+inline Vec4<Promote<T>> hsvToRgb(const Vec4<T>& color) {
+  return colorspace::withAlpha(hsvToRgb(Vec3<T>(color)),
+                               Promote<T>(color.w));
+}
+
+template <class T>
+inline Vec3<Promote<T>> rgbToHsl(const Vec3<T>& color) {
+  using R = Promote<T>;
+  const R r = color.x;
+  const R g = color.y;
+  const R b = color.z;
+  const R max = std::max(r, std::max(g, b));
+  const R min = std::min(r, std::min(g, b));
+  const R delta = max - min;
+  const R l = (max + min) / 2;
+  return Vec3<R>(colorspace::hue<T>(r, g, b, max, delta),
+                 delta ? delta / (1 - std::abs(2 * l - 1)) : R(),
+                 l);
+}
+
+template <class T>
+inline Vec4<Promote<T>> rgbToHsl(const Vec4<T>& color) {
+  return colorspace::withAlpha(rgbToHsl(Vec3<T>(color)),
+                               Promote<T>(color.w));
+}
+
+template <class T>
+inline Vec3<Promote<T>> hslToRgb(const Vec3<T>& color) {
+  using R = Promote<T>;
+  const R h = (color.x - std::floor(color.x)) * 6;
+  const R l = color.z;
+  const R c = (1 - std::abs(2 * l - 1)) * color.y;
+  const R x = c * (1 - std::abs(std::fmod(h, R(2)) - 1));
+  const R m = l - c / 2;
+  switch (std::min(static_cast<int>(h), 5)) {
+    case 0: return Vec3<R>(c + m, x + m, m);
+    case 1: return Vec3<R>(x + m, c + m, m);
+    case 2: return Vec3<R>(m, c + m, x + m);
+    case 3: return Vec3<R>(m, x + m, c + m);
+    case 4: return Vec3<R>(x + m, m, c + m);
+    default: return Vec3<R>(c + m, m, x + m);
+  }
+}
+
+template <class T>
+inline Vec4<Promote<T>> hslToRgb(const Vec4<T>& color) {
+  return colorspace::withAlpha(hslToRgb(Vec3<T>(color)),
+                               Promote<T>(color.w));
+}
+
+#pragma mark CIELAB and OKLab
+
+template <class T>
+inline Vec3<Promote<T>> linearToLab(const Vec3<T>& color) {
+  using R = Promote<T>;
+  const R r = color.x;
+  const R g = color.y;
+  const R b = color.z;
+  const R x = (R(0.4124564) * r + R(0.3575761) * g + R(0.1804375) * b);
+  const R y = (R(0.2126729) * r + R(0.7151522) * g + R(0.0721750) * b);
+  const R z = (R(0.0193339) * r + R(0.1191920) * g + R(0.9503041) * b);
+  const R fx = colorspace::labForward(x / R(0.95047));
+  const R fy = colorspace::labForward(y);
+  const R fz = colorspace::labForward(z / R(1.08883));
+  return Vec3<R>(116 * fy - 16, 500 * (fx - fy), 200 * (fy - fz));
+}
+
+template <class T>
+inline Vec4<Promote<T>> linearToLab(const Vec4<T>& color) {
+  return colorspace::withAlpha(linearToLab(Vec3<T>(color)),
+                               Promote<T>(color.w));
+}
+
+template <class T>
+inline Vec3<Promote<T>> labToLinear(const Vec3<T>& color) {
+  using R = Promote<T>;
+  const R fy = (color.x + R(16)) / 116;
+  const R x = colorspace::labInverse(fy + color.y / R(500)) * R(0.95047);
+  const R y = colorspace::labInverse(fy);
+  const R z = colorspace::labInverse(fy - color.z / R(200)) * R(1.08883);
+  return Vec3<R>(R(3.2404542) * x - R(1.5371385) * y - R(0.4985314) * z,
+                 R(-0.9692660) * x + R(1.8760108) * y + R(0.0415560) * z,
+                 R(0.0556434) * x - R(0.2040259) * y + R(1.0572252) * z);
+}
+
+template <class T>
+inline Vec4<Promote<T>> labToLinear(const Vec4<T>& color) {
+  return colorspace::withAlpha(labToLinear(Vec3<T>(color)),
+                               Promote<T>(color.w));
+}
+
+template <class T>
+inline Vec3<Promote<T>> linearToOklab(const Vec3<T>& color) {
+  using R = Promote<T>;
+  const R r = color.x;
+  const R g = color.y;
+  const R b = color.z;
+  const R l = std::cbrt(R(0.4122214708) * r + R(0.5363325363) * g +
+                        R(0.0514459929) * b);
+  const R m = std::cbrt(R(0.2119034982) * r + R(0.6806995451) * g +
+                        R(0.1073969566) * b);
+  const R s = std::cbrt(R(0.0883024619) * r + R(0.2817188376) * g +
+                        R(0.6299787005) * b);
+  return Vec3<R>(R(0.2104542553) * l + R(0.7936177850) * m -
+                 R(0.0040720468) * s,
+                 R(1.9779984951) * l - R(2.4285922050) * m +
+                 R(0.4505937099) * s,
+                 R(0.0259040371) * l + R(0.7827717662) * m -
+                 R(0.8086757660) * s);
+}
+
+template <class T>
+inline Vec4<Promote<T>> linearToOklab(const Vec4<T>& color) {
+  return colorspace::withAlpha(linearToOklab(Vec3<T>(color)),
+                               Promote<T>(color.w));
+}
+
+template <class T>
+inline Vec3<Promote<T>> oklabToLinear(const Vec3<T>& color) {
+  using R = Promote<T>;
+  const R l = color.x + R(0.3963377774) * color.y + R(0.2158037573) * color.z;
+  const R m = color.x - R(0.1055613458) * color.y - R(0.0638541728) * color.z;
+  const R s = color.x - R(0.0894841775) * color.y - R(1.2914855480) * color.z;
+  const R l3 = l * l * l;
+  const R m3 = m * m * m;
+  const R s3 = s * s * s;
+  return Vec3<R>(R(4.0767416621) * l3 - R(3.3077115913) * m3 +
+                 R(0.2309699292) * s3,
+                 R(-1.2684380046) * l3 + R(2.6097574011) * m3 -
+                 R(0.3413193965) * s3,
+                 R(-0.0041960863) * l3 - R(0.7034186147) * m3 +
+                 R(1.7076147010) * s3);
+}
+
+template <class T>
+inline Vec4<Promote<T>> oklabToLinear(const Vec4<T>& color) {
+  return colorspace::withAlpha(oklabToLinear(Vec3<T>(color)),
+                               Promote<T>(color.w));
+}
+
+#pragma mark 8-bit packing
+
+template <class T>
+inline Vec3<std::uint8_t> packColor(const Vec3<T>& color) {
+  return Vec3<std::uint8_t>(colorspace::pack(color.x),
+                            colorspace::pack(color.y),
+                            colorspace::pack(color.z));
+}
+
+template <class T>
+inline Vec4<std::uint8_t> packColor(const Vec4<T>& color) {
+  return Vec4<std::uint8_t>(colorspace::pack(color.x),
+                            colorspace::pack(color.y),
+                            colorspace::pack(color.z),
+                            colorspace::pack(color.w));
+}
+
+template <class T>
+inline Vec3<T> unpackColor(const Vec3<std::uint8_t>& color) {
+  return Vec3<T>(color.x / T(255), color.y / T(255), color.z / T(255));
+}
+
+template <class T>
+inline Vec4<T> unpackColor(const Vec4<std::uint8_t>& color) {
+  return Vec4<T>(color.x / T(255), color.y / T(255),
+                 color.z / T(255), color.w / T(255));
+}
+
+template <class InputIterator, class OutputIterator>
+inline OutputIterator packColor(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result) {
+  for (; first != last; ++first, ++result) {
+    *result = packColor(*first);
+  }
+  return result;
+}
+
+template <class T, class InputIterator, class OutputIterator>
+inline OutputIterator unpackColor(InputIterator first,
+                                  InputIterator last,
+                                  OutputIterator result) {
+  for (; first != last; ++first, ++result) {
+    *result = unpackColor<T>(*first);
+  }
+  return result;
+}
+
+}  // namespace math
+
+using math::srgbToLinear;
+using math::linearToSrgb;
+using math::rgbToHsv;
+using math::hsvToRgb;
+using math::rgbToHsl;
+using math::hslToRgb;
+using math::linearToLab;
+using math::labToLinear;
+using math::linearToOklab;
+using math::oklabToLinear;
+using math::packColor;
+using math::unpackColor;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_COLOR_H_
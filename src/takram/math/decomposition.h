@@ -0,0 +1,379 @@
+//
+//  takram/math/decomposition.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_DECOMPOSITION_H_
+#define TAKRAM_MATH_DECOMPOSITION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "takram/math/constants.h"
+#include "takram/math/matrix.h"
+#include "takram/math/promotion.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Closed-form eigen decomposition of symmetric matrices. Eigenvalues are
+// sorted in descending order, and the corresponding unit eigenvectors are the
+// columns of a rotation matrix.
+template <class T>
+void decomposeSymmetric(const Mat2<T>& matrix,
+                        Vec2<Promote<T>> *values,
+                        Mat2<Promote<T>> *vectors);
+template <class T>
+void decomposeSymmetric(const Mat3<T>& matrix,
+                        Vec3<Promote<T>> *values,
+                        Mat3<Promote<T>> *vectors);
+
+// Cyclic Jacobi eigen decomposition of a symmetric matrix with a fixed number
+// of sweeps and no data-dependent exits, so that every matrix in a batch costs
+// the same. It is slower than the closed form for a single matrix but stays
+// accurate when eigenvalues are nearly repeated.
+template <class T>
+void decomposeJacobi(const Mat3<T>& matrix,
+                     Vec3<Promote<T>> *values,
+                     Mat3<Promote<T>> *vectors,
+                     int sweeps = 5);
+template <class InputIterator, class ValueIterator, class VectorIterator>
+void decomposeJacobi(InputIterator first,
+                     InputIterator last,
+                     ValueIterator values,
+                     VectorIterator vectors,
+                     int sweeps = 5);
+
+// Singular value decomposition matrix = u * diag(sigma) * transpose(v) after
+// McAdams et al. The right singular vectors come from a Jacobi decomposition
+// of the normal matrix, and the left ones from Givens QR of matrix * v. Both u
+// and v are rotations, and the smallest singular value carries the sign of the
+// determinant.
+template <class T>
+void decomposeSingular(const Mat3<T>& matrix,
+                       Mat3<Promote<T>> *u,
+                       Vec3<Promote<T>> *sigma,
+                       Mat3<Promote<T>> *v,
+                       int sweeps = 5);
+template <class InputIterator, class UIterator, class SigmaIterator,
+          class VIterator>
+void decomposeSingular(InputIterator first,
+                       InputIterator last,
+                       UIterator u,
+                       SigmaIterator sigma,
+                       VIterator v,
+                       int sweeps = 5);
+
+// Polar decomposition matrix = rotation * stretch, where stretch is symmetric.
+template <class T>
+void decomposePolar(const Mat3<T>& matrix,
+                    Mat3<Promote<T>> *rotation,
+                    Mat3<Promote<T>> *stretch,
+                    int sweeps = 5);
+template <class InputIterator, class RotationIterator, class StretchIterator>
+void decomposePolar(InputIterator first,
+                    InputIterator last,
+                    RotationIterator rotation,
+                    StretchIterator stretch,
+                    int sweeps = 5);
+
+#pragma mark -
+
+template <class T>
+inline void decomposeSymmetric(const Mat2<T>& matrix,
+                               Vec2<Promote<T>> *values,
+                               Mat2<Promote<T>> *vectors) {
+  using R = Promote<T>;
+  const R a = matrix(0, 0);
+  const R b = matrix(0, 1);
+  const R d = matrix(1, 1);
+  const R mean = (a + d) / 2;
+  const R radius = std::hypot((a - d) / 2, b);
+  const R angle = std::atan2(2 * b, a - d) / 2;
+  const R cosine = std::cos(angle);
+  const R sine = std::sin(angle);
+  if (values) {
+    values->set(mean + radius, mean - radius);
+  }
+  if (vectors) {
+    vectors->set({cosine, -sine, sine, cosine});
+  }
+}
+
+template <class T>
+inline void decomposeSymmetric(const Mat3<T>& matrix,
+                               Vec3<Promote<T>> *values,
+                               Mat3<Promote<T>> *vectors) {
+  using R = Promote<T>;
+  const Mat3<R> m(matrix);
+  R e[3];
+  const R off = m(0, 1) * m(0, 1) + m(0, 2) * m(0, 2) + m(1, 2) * m(1, 2);
+  const R q = m.trace() / 3;
+  const R p2 = ((m(0, 0) - q) * (m(0, 0) - q) +
+                (m(1, 1) - q) * (m(1, 1) - q) +
+                (m(2, 2) - q) * (m(2, 2) - q) + 2 * off);
+  if (!p2) {
+    if (values) {
+      values->set(q, q, q);
+    }
+    if (vectors) {
+      *vectors = Mat3<R>::identity();
+    }
+    return;
+  }
+  // Trigonometric solution of the characteristic equation (Smith)
+  const R p = std::sqrt(p2 / 6);
+  const R r = ((m - Mat3<R>(q)) / p).determinant() / 2;
+  const R phi = std::acos(std::max(R(-1), std::min(r, R(1)))) / 3;
+  e[0] = q + 2 * p * std::cos(phi);
+  e[2] = q + 2 * p * std::cos(phi + 2 * pi<R>() / 3);
+  e[1] = std::max(e[2], std::min(3 * q - e[0] - e[2], e[0]));
+  if (values) {
+    values->set(e[0], e[1], e[2]);
+  }
+  if (!vectors) {
+    return;
+  }
+  // Solve the eigenvector of the most isolated eigenvalue from the null space
+  // of (m - e I), and the remaining two in its orthogonal complement.
+  const bool first = e[0] - e[1] >= e[1] - e[2];
+  const R isolated = first ? e[0] : e[2];
+  const Vec3<R> r0 = m[0] - Vec3<R>(isolated, 0, 0);
+  const Vec3<R> r1 = m[1] - Vec3<R>(0, isolated, 0);
+  const Vec3<R> r2 = m[2] - Vec3<R>(0, 0, isolated);
+  Vec3<R> w = r0.cross(r1);
+  if (r0.cross(r2).magnitudeSquared() > w.magnitudeSquared()) {
+    w = r0.cross(r2);
+  }
+  if (r1.cross(r2).magnitudeSquared() > w.magnitudeSquared()) {
+    w = r1.cross(r2);
+  }
+  if (w.empty()) {
+    w.set(1, 0, 0);
+  }
+  w.normalize();
+  Vec3<R> u = std::abs(w.x) > std::abs(w.y) ? Vec3<R>(-w.z, 0, w.x)
+                                            : Vec3<R>(0, w.z, -w.y);
+  u.normalize();
+  const Vec3<R> v = w.cross(u);
+  const Vec3<R> mu = m * u;
+  const Vec3<R> mv = m * v;
+  Mat2<R> reduced;
+  decomposeSymmetric(Mat2<R>({u.dot(mu), u.dot(mv), u.dot(mv), v.dot(mv)}),
+                     nullptr, &reduced);
+  const Vec3<R> major = u * reduced(0, 0) + v * reduced(1, 0);
+  const Vec3<R> minor = u * reduced(0, 1) + v * reduced(1, 1);
+  if (first) {
+    *vectors = Mat3<R>::fromColumns({w, major, minor});
+  } else {
+    *vectors = Mat3<R>::fromColumns({major, minor, w});
+  }
+  if (vectors->determinant() < 0) {
+    vectors->setColumn(2, -vectors->column(2));
+  }
+}
+
+namespace decomposition {
+
+// Applies the Jacobi rotation that annihilates the off-diagonal element (p, q)
+// of the symmetric matrix, and accumulates it into the vectors.
+template <class T>
+inline void rotateJacobi(Mat3<T> *matrix, Mat3<T> *vectors, int p, int q) {
+  Mat3<T>& m = *matrix;
+  Mat3<T>& v = *vectors;
+  const T apq = m(p, q);
+  const T theta = (m(q, q) - m(p, p)) / (2 * (apq ? apq : T(1)));
+  const T t = (apq ? (theta < 0 ? -1 : 1) /
+                     (std::abs(theta) + std::sqrt(theta * theta + 1)) : T());
+  const T c = 1 / std::sqrt(t * t + 1);
+  const T s = t * c;
+  const int r = 3 - p - q;
+  const T arp = m(r, p);
+  const T arq = m(r, q);
+  m(p, p) -= t * apq;
+  m(q, q) += t * apq;
+  m(p, q) = m(q, p) = T();
+  m(r, p) = m(p, r) = c * arp - s * arq;
+  m(r, q) = m(q, r) = s * arp + c * arq;
+  for (int i = 0; i < 3; ++i) {
+    const T vip = v(i, p);
+    const T viq = v(i, q);
+    v(i, p) = c * vip - s * viq;
+    v(i, q) = s * vip + c * viq;
+  }
+}
+
+// Applies the Givens rotation of rows i and j that annihilates the element
+// (j, k), and accumulates its transpose into q.
+template <class T>
+inline void rotateGivens(Mat3<T> *matrix, Mat3<T> *q, int i, int j, int k) {
+  Mat3<T>& m = *matrix;
+  const T a = m(i, k);
+  const T b = m(j, k);
+  const T r = std::hypot(a, b);
+  const T c = r ? a / r : T(1);
+  const T s = r ? b / r : T();
+  const auto row_i = m[i];
+  const auto row_j = m[j];
+  m[i] = row_i * c + row_j * s;
+  m[j] = row_j * c - row_i * s;
+  for (int l = 0; l < 3; ++l) {
+    const T qi = (*q)(l, i);
+    const T qj = (*q)(l, j);
+    (*q)(l, i) = c * qi + s * qj;
+    (*q)(l, j) = c * qj - s * qi;
+  }
+}
+
+}  // namespace decomposition
+
+template <class T>
+inline void decomposeJacobi(const Mat3<T>& matrix,
+                            Vec3<Promote<T>> *values,
+                            Mat3<Promote<T>> *vectors,
+                            int sweeps) {
+  using R = Promote<T>;
+  Mat3<R> m(matrix);
+  Mat3<R> v = Mat3<R>::identity();
+  for (int sweep = 0; sweep < sweeps; ++sweep) {
+    decomposition::rotateJacobi(&m, &v, 0, 1);
+    decomposition::rotateJacobi(&m, &v, 0, 2);
+    decomposition::rotateJacobi(&m, &v, 1, 2);
+  }
+  // Sort by descending eigenvalues with a three-element sorting network
+  Vec3<R> e = m.diagonal();
+  const auto order = [&e, &v](int i, int j) {
+    if (e[i] < e[j]) {
+      std::swap(e[i], e[j]);
+      const auto column = v.column(i);
+      v.setColumn(i, v.column(j));
+      v.setColumn(j, column);
+    }
+  };
+  order(0, 1);
+  order(1, 2);
+  order(0, 1);
+  if (v.determinant() < 0) {
+    v.setColumn(2, -v.column(2));
+  }
+  if (values) {
+    *values = e;
+  }
+  if (vectors) {
+    *vectors = v;
+  }
+}
+
+template <class InputIterator, class ValueIterator, class VectorIterator>
+inline void decomposeJacobi(InputIterator first,
+                            InputIterator last,
+                            ValueIterator values,
+                            VectorIterator vectors,
+                            int sweeps) {
+  for (; first != last; ++first, ++values, ++vectors) {
+    decomposeJacobi(*first, &*values, &*vectors, sweeps);
+  }
+}
+
+template <class T>
+inline void decomposeSingular(const Mat3<T>& matrix,
+                              Mat3<Promote<T>> *u,
+                              Vec3<Promote<T>> *sigma,
+                              Mat3<Promote<T>> *v,
+                              int sweeps) {
+  using R = Promote<T>;
+  const Mat3<R> m(matrix);
+  Mat3<R> right;
+  decomposeJacobi(m.transposed() * m, nullptr, &right, sweeps);
+  Mat3<R> b = m * right;
+  Mat3<R> q = Mat3<R>::identity();
+  decomposition::rotateGivens(&b, &q, 0, 1, 0);
+  decomposition::rotateGivens(&b, &q, 0, 2, 0);
+  decomposition::rotateGivens(&b, &q, 1, 2, 1);
+  if (u) {
+    *u = q;
+  }
+  if (sigma) {
+    *sigma = b.diagonal();
+  }
+  if (v) {
+    *v = right;
+  }
+}
+
+template <class InputIterator, class UIterator, class SigmaIterator,
+          class VIterator>
+inline void decomposeSingular(InputIterator first,
+                              InputIterator last,
+                              UIterator u,
+                              SigmaIterator sigma,
+                              VIterator v,
+                              int sweeps) {
+  for (; first != last; ++first, ++u, ++sigma, ++v) {
+    decomposeSingular(*first, &*u, &*sigma, &*v, sweeps);
+  }
+}
+
+template <class T>
+inline void decomposePolar(const Mat3<T>& matrix,
+                           Mat3<Promote<T>> *rotation,
+                           Mat3<Promote<T>> *stretch,
+                           int sweeps) {
+  using R = Promote<T>;
+  Mat3<R> u;
+  Vec3<R> sigma;
+  Mat3<R> v;
+  decomposeSingular(matrix, &u, &sigma, &v, sweeps);
+  if (rotation) {
+    *rotation = u * v.transposed();
+  }
+  if (stretch) {
+    *stretch = v * Mat3<R>::diagonal(sigma) * v.transposed();
+  }
+}
+
+template <class InputIterator, class RotationIterator, class StretchIterator>
+inline void decomposePolar(InputIterator first,
+                           InputIterator last,
+                           RotationIterator rotation,
+                           StretchIterator stretch,
+                           int sweeps) {
+  for (; first != last; ++first, ++rotation, ++stretch) {
+    decomposePolar(*first, &*rotation, &*stretch, sweeps);
+  }
+}
+
+}  // namespace math
+
+using math::decomposeSymmetric;
+using math::decomposeJacobi;
+using math::decomposeSingular;
+using math::decomposePolar;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_DECOMPOSITION_H_
@@ -0,0 +1,386 @@
+//
+//  takram/math/distortion.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_DISTORTION_H_
+#define TAKRAM_MATH_DISTORTION_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+#include "takram/math/promotion.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/size.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Brown-Conrady lens distortion with three radial and two tangential
+// coefficients, in the convention of OpenCV. Points are in pixels, and are
+// normalized by the focal length and the principal point before the model
+// applies.
+template <class T>
+class Distortion final {
+ public:
+  using Type = T;
+
+ public:
+  Distortion();
+  Distortion(const Vec2<T>& focal,
+             const Vec2<T>& center,
+             T k1, T k2, T p1, T p2, T k3 = T());
+
+  // Copy semantics
+  Distortion(const Distortion&) = default;
+  Distortion& operator=(const Distortion&) = default;
+
+  // Comparison
+  template <class V, class U = T>
+  bool equals(const Distortion<U>& other, V tolerance) const;
+
+  // Attributes
+  bool empty() const { return !k1 && !k2 && !k3 && !p1 && !p2; }
+
+  // Distortion
+  template <class U = T>
+  Vec2<Promote<T, U>> distort(const Vec2<U>& point) const;
+  template <class InputIterator, class OutputIterator>
+  OutputIterator distort(InputIterator first,
+                         InputIterator last,
+                         OutputIterator result) const;
+
+  // Undistortion by fixed-point iteration
+  template <class U = T>
+  Vec2<Promote<T, U>> undistort(const Vec2<U>& point,
+                                int iterations = 10) const;
+  template <class InputIterator, class OutputIterator>
+  OutputIterator undistort(InputIterator first,
+                           InputIterator last,
+                           OutputIterator result,
+                           int iterations = 10) const;
+
+ public:
+  Vec2<T> focal;
+  Vec2<T> center;
+  T k1;
+  T k2;
+  T k3;
+  T p1;
+  T p2;
+};
+
+// Undistortion precomputed on a grid of nodes spanning an image area, and
+// interpolated bilinearly between them. Points outside the area fall back to
+// the iterative undistortion.
+template <class T>
+class UndistortionMap final {
+ public:
+  using Type = T;
+
+ public:
+  UndistortionMap();
+  UndistortionMap(const Distortion<T>& distortion,
+                  const Rect2<T>& area,
+                  const Size2i& size,
+                  int iterations = 10);
+
+  // Copy semantics
+  UndistortionMap(const UndistortionMap&) = default;
+  UndistortionMap& operator=(const UndistortionMap&) = default;
+
+  // Construction
+  void build(const Distortion<T>& distortion,
+             const Rect2<T>& area,
+             const Size2i& size,
+             int iterations = 10);
+  void reset();
+
+  // Attributes
+  bool empty() const { return nodes_.empty(); }
+  const Distortion<T>& distortion() const { return distortion_; }
+  const Rect2<T>& area() const { return area_; }
+  const Size2i& size() const { return size_; }
+
+  // Undistortion
+  template <class U = T>
+  Vec2<Promote<T, U>> undistort(const Vec2<U>& point) const;
+  template <class InputIterator, class OutputIterator>
+  OutputIterator undistort(InputIterator first,
+                           InputIterator last,
+                           OutputIterator result) const;
+
+ private:
+  Distortion<T> distortion_;
+  Rect2<T> area_;
+  Size2i size_;
+  int iterations_;
+  std::vector<Vec2<T>> nodes_;
+};
+
+using Distortionf = Distortion<float>;
+using Distortiond = Distortion<double>;
+using UndistortionMapf = UndistortionMap<float>;
+using UndistortionMapd = UndistortionMap<double>;
+
+#pragma mark -
+
+template <class T>
+inline Distortion<T>::Distortion()
+    : focal(1, 1),
+      center(),
+      k1(),
+      k2(),
+      k3(),
+      p1(),
+      p2() {}
+
+template <class T>
+inline Distortion<T>::Distortion(const Vec2<T>& focal,
+                                 const Vec2<T>& center,
+                                 T k1, T k2, T p1, T p2, T k3)
+    : focal(focal),
+      center(center),
+      k1(k1),
+      k2(k2),
+      k3(k3),
+      p1(p1),
+      p2(p2) {}
+
+#pragma mark Comparison
+
+template <class T, class U>
+inline bool operator==(const Distortion<T>& lhs, const Distortion<U>& rhs) {
+  return (lhs.focal == rhs.focal && lhs.center == rhs.center &&
+          lhs.k1 == rhs.k1 && lhs.k2 == rhs.k2 && lhs.k3 == rhs.k3 &&
+          lhs.p1 == rhs.p1 && lhs.p2 == rhs.p2);
+}
+
+template <class T, class U>
+inline bool operator!=(const Distortion<T>& lhs, const Distortion<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T>
+template <class V, class U>
+inline bool Distortion<T>::equals(const Distortion<U>& other,
+                                  V tolerance) const {
+  return (focal.equals(other.focal, tolerance) &&
+          center.equals(other.center, tolerance) &&
+          std::abs(k1 - other.k1) <= tolerance &&
+          std::abs(k2 - other.k2) <= tolerance &&
+          std::abs(k3 - other.k3) <= tolerance &&
+          std::abs(p1 - other.p1) <= tolerance &&
+          std::abs(p2 - other.p2) <= tolerance);
+}
+
+#pragma mark Distortion
+
+template <class T>
+template <class U>
+inline Vec2<Promote<T, U>> Distortion<T>::distort(
+    const Vec2<U>& point) const {
+  using R = Promote<T, U>;
+  const R x = (point.x - center.x) / focal.x;
+  const R y = (point.y - center.y) / focal.y;
+  const R r2 = x * x + y * y;
+  const R radial = 1 + r2 * (k1 + r2 * (k2 + r2 * k3));
+  const R dx = 2 * p1 * x * y + p2 * (r2 + 2 * x * x);
+  const R dy = p1 * (r2 + 2 * y * y) + 2 * p2 * x * y;
+  return Vec2<R>(center.x + focal.x * (x * radial + dx),
+                 center.y + focal.y * (y * radial + dy));
+}
+
+template <class T>
+template <class InputIterator, class OutputIterator>
+inline OutputIterator Distortion<T>::distort(InputIterator first,
+                                             InputIterator last,
+                                             OutputIterator result) const {
+  for (; first != last; ++first, ++result) {
+    *result = distort(*first);
+  }
+  return result;
+}
+
+#pragma mark Undistortion
+
+template <class T>
+template <class U>
+inline Vec2<Promote<T, U>> Distortion<T>::undistort(const Vec2<U>& point,
+                                                    int iterations) const {
+  using R = Promote<T, U>;
+  const R xd = (point.x - center.x) / focal.x;
+  const R yd = (point.y - center.y) / focal.y;
+  R x = xd;
+  R y = yd;
+  for (int i = 0; i < iterations; ++i) {
+    const R r2 = x * x + y * y;
+    const R radial = 1 + r2 * (k1 + r2 * (k2 + r2 * k3));
+    const R dx = 2 * p1 * x * y + p2 * (r2 + 2 * x * x);
+    const R dy = p1 * (r2 + 2 * y * y) + 2 * p2 * x * y;
+    x = (xd - dx) / radial;
+    y = (yd - dy) / radial;
+  }
+  return Vec2<R>(center.x + focal.x * x, center.y + focal.y * y);
+}
+
+template <class T>
+template <class InputIterator, class OutputIterator>
+inline OutputIterator Distortion<T>::undistort(InputIterator first,
+                                               InputIterator last,
+                                               OutputIterator result,
+                                               int iterations) const {
+  for (; first != last; ++first, ++result) {
+    *result = undistort(*first, iterations);
+  }
+  return result;
+}
+
+#pragma mark Stream
+
+template <class T>
+inline std::ostream& operator<<(std::ostream& os,
+                                const Distortion<T>& distortion) {
+  return os << "( " << distortion.focal << ", " << distortion.center <<
+      ", " << distortion.k1 << ", " << distortion.k2 << ", " <<
+      distortion.p1 << ", " << distortion.p2 << ", " << distortion.k3 <<
+      " )";
+}
+
+#pragma mark -
+
+template <class T>
+inline UndistortionMap<T>::UndistortionMap()
+    : distortion_(),
+      area_(),
+      size_(),
+      iterations_() {}
+
+template <class T>
+inline UndistortionMap<T>::UndistortionMap(const Distortion<T>& distortion,
+                                           const Rect2<T>& area,
+                                           const Size2i& size,
+                                           int iterations) {
+  build(distortion, area, size, iterations);
+}
+
+#pragma mark Construction
+
+template <class T>
+inline void UndistortionMap<T>::build(const Distortion<T>& distortion,
+                                      const Rect2<T>& area,
+                                      const Size2i& size,
+                                      int iterations) {
+  assert(size.width >= 2 && size.height >= 2);
+  distortion_ = distortion;
+  area_ = area.canonicalized();
+  size_ = size;
+  iterations_ = iterations;
+  nodes_.resize(size.width * size.height);
+  const T dx = area_.width / (size.width - 1);
+  const T dy = area_.height / (size.height - 1);
+  auto node = nodes_.begin();
+  for (int j = 0; j < size.height; ++j) {
+    for (int i = 0; i < size.width; ++i, ++node) {
+      *node = distortion.undistort(
+          Vec2<T>(area_.x + dx * i, area_.y + dy * j), iterations);
+    }
+  }
+}
+
+template <class T>
+inline void UndistortionMap<T>::reset() {
+  *this = UndistortionMap();
+}
+
+#pragma mark Undistortion
+
+template <class T>
+template <class U>
+inline Vec2<Promote<T, U>> UndistortionMap<T>::undistort(
+    const Vec2<U>& point) const {
+  using R = Promote<T, U>;
+  assert(!empty());
+  const R u = (point.x - area_.x) / area_.width * (size_.width - 1);
+  const R v = (point.y - area_.y) / area_.height * (size_.height - 1);
+  if (!(u >= 0 && v >= 0 && u <= size_.width - 1 && v <= size_.height - 1)) {
+    return distortion_.undistort(point, iterations_);
+  }
+  const int i = std::min(static_cast<int>(u), size_.width - 2);
+  const int j = std::min(static_cast<int>(v), size_.height - 2);
+  const R s = u - i;
+  const R t = v - j;
+  const auto row = nodes_.begin() + j * size_.width + i;
+  const auto next = row + size_.width;
+  const Vec2<R> top = Vec2<R>(row[0]) * (1 - s) + Vec2<R>(row[1]) * s;
+  const Vec2<R> bottom = Vec2<R>(next[0]) * (1 - s) + Vec2<R>(next[1]) * s;
+  return top * (1 - t) + bottom * t;
+}
+
+template <class T>
+template <class InputIterator, class OutputIterator>
+inline OutputIterator UndistortionMap<T>::undistort(
+    InputIterator first,
+    InputIterator last,
+    OutputIterator result) const {
+  for (; first != last; ++first, ++result) {
+    *result = undistort(*first);
+  }
+  return result;
+}
+
+}  // namespace math
+
+using math::Distortion;
+using math::Distortionf;
+using math::Distortiond;
+using math::UndistortionMap;
+using math::UndistortionMapf;
+using math::UndistortionMapd;
+
+}  // namespace takram
+
+template <class T>
+struct std::hash<takram::math::Distortion<T>> {
+  std::size_t operator()(const takram::math::Distortion<T>& value) const {
+    std::hash<takram::math::Vec2<T>> vector_hash;
+    std::hash<T> hash;
+    return ((vector_hash(value.focal) << 0) ^
+            (vector_hash(value.center) << 1) ^
+            (hash(value.k1) << 2) ^
+            (hash(value.k2) << 3) ^
+            (hash(value.k3) << 4) ^
+            (hash(value.p1) << 5) ^
+            (hash(value.p2) << 6));
+  }
+};
+
+#endif  // TAKRAM_MATH_DISTORTION_H_
@@ -0,0 +1,274 @@
+//
+//  takram/math/ellipse2.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_ELLIPSE2_H_
+#define TAKRAM_MATH_ELLIPSE2_H_
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
+#include "takram/math/circle.h"
+#include "takram/math/constants.h"
+#include "takram/math/promotion.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T, int D>
+class Ellipse;
+
+template <class T>
+using Ellipse2 = Ellipse<T, 2>;
+
+// Radii are measured along the axes of the ellipse, which is rotated
+// counterclockwise by angle in radians about its center.
+template <class T>
+class Ellipse<T, 2> final {
+ public:
+  using Type = T;
+
+ public:
+  Ellipse();
+  Ellipse(const Vec2<T>& center, const Vec2<T>& radii, T angle = T());
+
+  // Explicit conversion
+  template <class U>
+  explicit Ellipse(const Circle2<U>& other);
+
+  // Copy semantics
+  Ellipse(const Ellipse& other) = default;
+  Ellipse& operator=(const Ellipse& other) = default;
+
+  // Mutators
+  void set(const Vec2<T>& center, const Vec2<T>& radii, T angle = T());
+  void reset();
+
+  // Comparison
+  template <class V, class U = T>
+  bool equals(const Ellipse2<U>& other, V tolerance) const;
+
+  // Attributes
+  bool empty() const { return !radii.x || !radii.y; }
+  Promote<T> area() const;
+  Promote<T> perimeter() const;
+  Rect2<Promote<T>> bounds() const;
+
+  // Containment
+  template <class U = T>
+  bool contains(const Vec2<U>& point) const;
+
+  // Sampling
+  Vec2<Promote<T>> point(Promote<T> parameter) const;
+  template <class OutputIterator>
+  OutputIterator sample(int count, OutputIterator result) const;
+
+ public:
+  union {
+    Vec2<T> center;
+    struct { T x; T y; };
+  };
+  Vec2<T> radii;
+  T angle;
+};
+
+using Ellipse2f = Ellipse2<float>;
+using Ellipse2d = Ellipse2<double>;
+
+#pragma mark -
+
+template <class T>
+inline Ellipse<T, 2>::Ellipse() : center(), radii(), angle() {}
+
+template <class T>
+inline Ellipse<T, 2>::Ellipse(const Vec2<T>& center,
+                              const Vec2<T>& radii,
+                              T angle)
+    : center(center),
+      radii(radii),
+      angle(angle) {}
+
+#pragma mark Explicit conversion
+
+template <class T>
+template <class U>
+inline Ellipse<T, 2>::Ellipse(const Circle2<U>& other)
+    : center(other.center),
+      radii(other.radius, other.radius),
+      angle() {}
+
+#pragma mark Mutators
+
+template <class T>
+inline void Ellipse<T, 2>::set(const Vec2<T>& center,
+                               const Vec2<T>& radii,
+                               T angle) {
+  this->center = center;
+  this->radii = radii;
+  this->angle = angle;
+}
+
+template <class T>
+inline void Ellipse<T, 2>::reset() {
+  *this = Ellipse();
+}
+
+#pragma mark Comparison
+
+template <class T, class U>
+inline bool operator==(const Ellipse2<T>& lhs, const Ellipse2<U>& rhs) {
+  return (lhs.center == rhs.center &&
+          lhs.radii == rhs.radii &&
+          lhs.angle == rhs.angle);
+}
+
+template <class T, class U>
+inline bool operator!=(const Ellipse2<T>& lhs, const Ellipse2<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T>
+template <class V, class U>
+inline bool Ellipse<T, 2>::equals(const Ellipse2<U>& other,
+                                  V tolerance) const {
+  return (center.equals(other.center, tolerance) &&
+          radii.equals(other.radii, tolerance) &&
+          std::abs(angle - other.angle) <= tolerance);
+}
+
+#pragma mark Attributes
+
+template <class T>
+inline Promote<T> Ellipse<T, 2>::area() const {
+  return pi<Promote<T>>() * radii.x * radii.y;
+}
+
+template <class T>
+inline Promote<T> Ellipse<T, 2>::perimeter() const {
+  // Ramanujan's second approximation
+  using R = Promote<T>;
+  const R a = std::abs(radii.x);
+  const R b = std::abs(radii.y);
+  if (!(a + b)) {
+    return R();
+  }
+  const R h = 3 * (a - b) * (a - b) / ((a + b) * (a + b));
+  return pi<R>() * (a + b) * (1 + h / (10 + std::sqrt(4 - h)));
+}
+
+template <class T>
+inline Rect2<Promote<T>> Ellipse<T, 2>::bounds() const {
+  using R = Promote<T>;
+  const R cosine = std::cos(angle);
+  const R sine = std::sin(angle);
+  const R width = std::hypot(radii.x * cosine, radii.y * sine);
+  const R height = std::hypot(radii.x * sine, radii.y * cosine);
+  return Rect2<R>(center.x - width, center.y - height, 2 * width, 2 * height);
+}
+
+#pragma mark Containment
+
+template <class T>
+template <class U>
+inline bool Ellipse<T, 2>::contains(const Vec2<U>& point) const {
+  using R = Promote<T, U>;
+  const R cosine = std::cos(angle);
+  const R sine = std::sin(angle);
+  const R dx = point.x - center.x;
+  const R dy = point.y - center.y;
+  const R u = (dx * cosine + dy * sine) / radii.x;
+  const R v = (dy * cosine - dx * sine) / radii.y;
+  return u * u + v * v <= 1;
+}
+
+#pragma mark Sampling
+
+template <class T>
+inline Vec2<Promote<T>> Ellipse<T, 2>::point(Promote<T> parameter) const {
+  using R = Promote<T>;
+  const R cosine = std::cos(angle);
+  const R sine = std::sin(angle);
+  const R u = radii.x * std::cos(parameter);
+  const R v = radii.y * std::sin(parameter);
+  return Vec2<R>(center.x + u * cosine - v * sine,
+                 center.y + u * sine + v * cosine);
+}
+
+template <class T>
+template <class OutputIterator>
+inline OutputIterator Ellipse<T, 2>::sample(int count,
+                                            OutputIterator result) const {
+  using R = Promote<T>;
+  const R cosine = std::cos(angle);
+  const R sine = std::sin(angle);
+  const R step = tau<R>() / count;
+  const R step_cosine = std::cos(step);
+  const R step_sine = std::sin(step);
+  R c = 1;
+  R s = 0;
+  for (int i = 0; i < count; ++i) {
+    const R u = radii.x * c;
+    const R v = radii.y * s;
+    *result++ = Vec2<R>(center.x + u * cosine - v * sine,
+                        center.y + u * sine + v * cosine);
+    const R next = c * step_cosine - s * step_sine;
+    s = s * step_cosine + c * step_sine;
+    c = next;
+  }
+  return result;
+}
+
+#pragma mark Stream
+
+template <class T>
+inline std::ostream& operator<<(std::ostream& os, const Ellipse2<T>& ellipse) {
+  return os << "( " << ellipse.center << ", " << ellipse.radii << ", " <<
+      ellipse.angle << " )";
+}
+
+}  // namespace math
+
+using math::Ellipse2;
+using math::Ellipse2f;
+using math::Ellipse2d;
+
+}  // namespace takram
+
+template <class T>
+struct std::hash<takram::math::Ellipse2<T>> {
+  std::size_t operator()(const takram::math::Ellipse2<T>& value) const {
+    std::hash<takram::math::Vec2<T>> hash;
+    return ((hash(value.center) << 0) ^
+            (hash(value.radii) << 1) ^
+            (std::hash<T>()(value.angle) << 2));
+  }
+};
+
+#endif  // TAKRAM_MATH_ELLIPSE2_H_
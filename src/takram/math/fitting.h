@@ -0,0 +1,830 @@
+//
+//  takram/math/fitting.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_FITTING_H_
+#define TAKRAM_MATH_FITTING_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "takram/math/circle.h"
+#include "takram/math/constants.h"
+#include "takram/math/decomposition.h"
+#include "takram/math/ellipse.h"
+#include "takram/math/line.h"
+#include "takram/math/matrix.h"
+#include "takram/math/promotion.h"
+#include "takram/math/roots.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+enum class CircleFit : int {
+  KASA = 0,
+  PRATT = 1
+};
+
+// Total least-squares line fitting. The fitted segment passes through the
+// centroid along the principal axis, and spans sqrt(3) standard deviations to
+// each side, which recovers the extent of evenly sampled segments. As in the
+// other fitters below, moments are kept in double precision relative to the
+// first point added.
+template <class T>
+class LineFitter final {
+ public:
+  using Type = T;
+
+ public:
+  LineFitter();
+  template <class InputIterator>
+  LineFitter(InputIterator first, InputIterator last);
+
+  // Copy semantics
+  LineFitter(const LineFitter&) = default;
+  LineFitter& operator=(const LineFitter&) = default;
+
+  // Accumulation
+  template <class U>
+  void add(const Vec2<U>& point);
+  template <class InputIterator>
+  void add(InputIterator first, InputIterator last);
+  void merge(const LineFitter& other);
+  void reset();
+  std::size_t count() const { return count_; }
+  const Vec2<T>& origin() const { return origin_; }
+
+  // Fitting
+  Line2<Promote<T>> line() const;
+
+ private:
+  using R = Promote<T>;
+  using Moment = Promote<T, double>;
+
+ private:
+  Vec2<T> origin_;
+  std::size_t count_;
+  Moment moments_[6];
+};
+
+// Algebraic circle fitting by the method of Kasa, or Pratt's method solved by
+// Newton iterations as given by Chernov. Pratt's fit is unbiased for arcs.
+template <class T>
+class CircleFitter final {
+ public:
+  using Type = T;
+
+ public:
+  CircleFitter();
+  template <class InputIterator>
+  CircleFitter(InputIterator first, InputIterator last);
+
+  // Copy semantics
+  CircleFitter(const CircleFitter&) = default;
+  CircleFitter& operator=(const CircleFitter&) = default;
+
+  // Accumulation
+  template <class U>
+  void add(const Vec2<U>& point);
+  template <class InputIterator>
+  void add(InputIterator first, InputIterator last);
+  void merge(const CircleFitter& other);
+  void reset();
+  std::size_t count() const { return count_; }
+  const Vec2<T>& origin() const { return origin_; }
+
+  // Fitting
+  Circle2<Promote<T>> circle(CircleFit method = CircleFit::PRATT) const;
+
+ private:
+  using R = Promote<T>;
+  using Moment = Promote<T, double>;
+
+ private:
+  Vec2<T> origin_;
+  std::size_t count_;
+  Moment moments_[9];
+};
+
+// Total least-squares plane fitting. The plane passes through the centroid,
+// and its normal is the axis of the least variance.
+template <class T>
+class PlaneFitter final {
+ public:
+  using Type = T;
+
+ public:
+  PlaneFitter();
+  template <class InputIterator>
+  PlaneFitter(InputIterator first, InputIterator last);
+
+  // Copy semantics
+  PlaneFitter(const PlaneFitter&) = default;
+  PlaneFitter& operator=(const PlaneFitter&) = default;
+
+  // Accumulation
+  template <class U>
+  void add(const Vec3<U>& point);
+  template <class InputIterator>
+  void add(InputIterator first, InputIterator last);
+  void merge(const PlaneFitter& other);
+  void reset();
+  std::size_t count() const { return count_; }
+  const Vec3<T>& origin() const { return origin_; }
+
+  // Fitting
+  Vec3<Promote<T>> centroid() const;
+  Vec3<Promote<T>> normal() const;
+
+ private:
+  using R = Promote<T>;
+  using Moment = Promote<T, double>;
+
+ private:
+  Vec3<T> origin_;
+  std::size_t count_;
+  Moment moments_[10];
+};
+
+// Direct least-squares ellipse fitting (Fitzgibbon, in the numerically stable
+// form of Halir and Flusser). Points are accumulated into the moments up to
+// the fourth order in constant space, so the design matrix is never built.
+// Moments are kept in double precision relative to the first point added,
+// which keeps them small for points far from zero such as pixel coordinates,
+// and merge() shifts the moments of the other fitter to this origin. Fitted
+// ellipses have their major axis along the angle, which lies in
+// (-pi / 2, pi / 2].
+template <class T>
+class EllipseFitter final {
+ public:
+  using Type = T;
+
+ public:
+  EllipseFitter();
+  template <class InputIterator>
+  EllipseFitter(InputIterator first, InputIterator last);
+
+  // Copy semantics
+  EllipseFitter(const EllipseFitter&) = default;
+  EllipseFitter& operator=(const EllipseFitter&) = default;
+
+  // Accumulation
+  template <class U>
+  void add(const Vec2<U>& point);
+  template <class InputIterator>
+  void add(InputIterator first, InputIterator last);
+  void merge(const EllipseFitter& other);
+  void reset();
+  std::size_t count() const { return count_; }
+  const Vec2<T>& origin() const { return origin_; }
+
+  // Fitting
+  Ellipse2<Promote<T>> ellipse() const;
+
+ private:
+  using R = Promote<T>;
+  using Moment = Promote<T, double>;
+
+  // Moments of x^i y^j for i + j <= 4, indexed by moment(i, j)
+  static int moment(int i, int j) { return (i + j) * (i + j + 1) / 2 + j; }
+
+ private:
+  Vec2<T> origin_;
+  std::size_t count_;
+  Moment moments_[15];
+};
+
+using LineFitterf = LineFitter<float>;
+using LineFitterd = LineFitter<double>;
+using CircleFitterf = CircleFitter<float>;
+using CircleFitterd = CircleFitter<double>;
+using PlaneFitterf = PlaneFitter<float>;
+using PlaneFitterd = PlaneFitter<double>;
+using EllipseFitterf = EllipseFitter<float>;
+using EllipseFitterd = EllipseFitter<double>;
+
+#pragma mark -
+
+#pragma mark Line fitting
+
+template <class T>
+inline LineFitter<T>::LineFitter() : origin_(), count_(), moments_() {}
+
+template <class T>
+template <class InputIterator>
+inline LineFitter<T>::LineFitter(InputIterator first, InputIterator last)
+    : origin_(),
+      count_(),
+      moments_() {
+  add(first, last);
+}
+
+template <class T>
+template <class U>
+inline void LineFitter<T>::add(const Vec2<U>& point) {
+  if (!count_) {
+    origin_ = point;
+  }
+  const Moment x = static_cast<Moment>(point.x) - origin_.x;
+  const Moment y = static_cast<Moment>(point.y) - origin_.y;
+  Moment *m = moments_;
+  m[0] += 1;
+  m[1] += x; m[2] += y;
+  m[3] += x * x; m[4] += x * y; m[5] += y * y;
+  ++count_;
+}
+
+template <class T>
+template <class InputIterator>
+inline void LineFitter<T>::add(InputIterator first, InputIterator last) {
+  for (; first != last; ++first) {
+    add(*first);
+  }
+}
+
+template <class T>
+inline void LineFitter<T>::merge(const LineFitter& other) {
+  if (!other.count_) {
+    return;
+  }
+  if (!count_) {
+    *this = other;
+    return;
+  }
+  // Shift the moments of the other fitter to this origin
+  const Moment a = static_cast<Moment>(other.origin_.x) - origin_.x;
+  const Moment b = static_cast<Moment>(other.origin_.y) - origin_.y;
+  const Moment *o = other.moments_;
+  Moment *m = moments_;
+  m[0] += o[0];
+  m[1] += o[1] + a * o[0];
+  m[2] += o[2] + b * o[0];
+  m[3] += o[3] + 2 * a * o[1] + a * a * o[0];
+  m[4] += o[4] + a * o[2] + b * o[1] + a * b * o[0];
+  m[5] += o[5] + 2 * b * o[2] + b * b * o[0];
+  count_ += other.count_;
+}
+
+template <class T>
+inline void LineFitter<T>::reset() {
+  *this = LineFitter();
+}
+
+template <class T>
+inline Line2<Promote<T>> LineFitter<T>::line() const {
+  using Result = Line2<Promote<T>>;
+  using R = Moment;
+  if (count_ < 2) {
+    return Result();
+  }
+  const R *m = moments_;
+  const Vec2<R> mean(m[1] / m[0], m[2] / m[0]);
+  const R xx = m[3] / m[0] - mean.x * mean.x;
+  const R xy = m[4] / m[0] - mean.x * mean.y;
+  const R yy = m[5] / m[0] - mean.y * mean.y;
+  const R angle = std::atan2(2 * xy, xx - yy) / 2;
+  const Vec2<R> direction(std::cos(angle), std::sin(angle));
+  const R variance = (xx * direction.x * direction.x +
+                      2 * xy * direction.x * direction.y +
+                      yy * direction.y * direction.y);
+  const Vec2<R> center = mean + origin_;
+  const Vec2<R> extent = direction * std::sqrt(3 * std::max(variance, R()));
+  return Result(Line2<R>(center - extent, center + extent));
+}
+
+#pragma mark Circle fitting
+
+template <class T>
+inline CircleFitter<T>::CircleFitter() : origin_(), count_(), moments_() {}
+
+template <class T>
+template <class InputIterator>
+inline CircleFitter<T>::CircleFitter(InputIterator first, InputIterator last)
+    : origin_(),
+      count_(),
+      moments_() {
+  add(first, last);
+}
+
+template <class T>
+template <class U>
+inline void CircleFitter<T>::add(const Vec2<U>& point) {
+  if (!count_) {
+    origin_ = point;
+  }
+  const Moment x = static_cast<Moment>(point.x) - origin_.x;
+  const Moment y = static_cast<Moment>(point.y) - origin_.y;
+  const Moment z = x * x + y * y;
+  Moment *m = moments_;
+  m[0] += 1;
+  m[1] += x; m[2] += y;
+  m[3] += x * x; m[4] += x * y; m[5] += y * y;
+  m[6] += x * z; m[7] += y * z; m[8] += z * z;
+  ++count_;
+}
+
+template <class T>
+template <class InputIterator>
+inline void CircleFitter<T>::add(InputIterator first, InputIterator last) {
+  for (; first != last; ++first) {
+    add(*first);
+  }
+}
+
+template <class T>
+inline void CircleFitter<T>::merge(const CircleFitter& other) {
+  if (!other.count_) {
+    return;
+  }
+  if (!count_) {
+    *this = other;
+    return;
+  }
+  // Shift the moments of the other fitter to this origin, where z expands to
+  // z + t with t = 2ax + 2by + c
+  const Moment a = static_cast<Moment>(other.origin_.x) - origin_.x;
+  const Moment b = static_cast<Moment>(other.origin_.y) - origin_.y;
+  const Moment c = a * a + b * b;
+  const Moment *o = other.moments_;
+  const Moment z = o[3] + o[5];
+  const Moment t = 2 * a * o[1] + 2 * b * o[2] + c * o[0];
+  Moment *m = moments_;
+  m[0] += o[0];
+  m[1] += o[1] + a * o[0];
+  m[2] += o[2] + b * o[0];
+  m[3] += o[3] + 2 * a * o[1] + a * a * o[0];
+  m[4] += o[4] + a * o[2] + b * o[1] + a * b * o[0];
+  m[5] += o[5] + 2 * b * o[2] + b * b * o[0];
+  m[6] += (o[6] + 2 * a * o[3] + 2 * b * o[4] + c * o[1] +
+           a * (z + t));
+  m[7] += (o[7] + 2 * a * o[4] + 2 * b * o[5] + c * o[2] +
+           b * (z + t));
+  m[8] += (o[8] + 4 * a * a * o[3] + 8 * a * b * o[4] + 4 * b * b * o[5] +
+           4 * a * o[6] + 4 * b * o[7] + 2 * c * z + c * t +
+           2 * c * (a * o[1] + b * o[2]));
+  count_ += other.count_;
+}
+
+template <class T>
+inline void CircleFitter<T>::reset() {
+  *this = CircleFitter();
+}
+
+template <class T>
+inline Circle2<Promote<T>> CircleFitter<T>::circle(CircleFit method) const {
+  using Result = Circle2<Promote<T>>;
+  using R = Moment;
+  if (count_ < 3) {
+    return Result();
+  }
+  // Central moments, where z is the squared distance from the centroid
+  const R *m = moments_;
+  const R n = m[0];
+  const R mx = m[1] / n;
+  const R my = m[2] / n;
+  const R xx = m[3] / n - mx * mx;
+  const R xy = m[4] / n - mx * my;
+  const R yy = m[5] / n - my * my;
+  const R z = xx + yy;
+  const R c = mx * mx + my * my;
+  const R sz = m[3] + m[5];
+  const R zz = (m[8] + 4 * mx * mx * m[3] + 4 * my * my * m[5] + c * c * n -
+                4 * mx * m[6] - 4 * my * m[7] + 2 * c * sz +
+                8 * mx * my * m[4] - 4 * c * mx * m[1] -
+                4 * c * my * m[2]) / n;
+  const R xz = (m[6] - 2 * mx * m[3] - 2 * my * m[4] + c * m[1] -
+                mx * (sz - 2 * mx * m[1] - 2 * my * m[2] + c * n)) / n;
+  const R yz = (m[7] - 2 * mx * m[4] - 2 * my * m[5] + c * m[2] -
+                my * (sz - 2 * mx * m[1] - 2 * my * m[2] + c * n)) / n;
+  const R covariance = xx * yy - xy * xy;
+  R root = 0;
+  if (method == CircleFit::PRATT) {
+    const R a2 = 4 * covariance - 3 * z * z - zz;
+    const R a1 = (zz * z + 4 * covariance * z -
+                  xz * xz - yz * yz - z * z * z);
+    const R a0 = (xz * xz * yy + yz * yz * xx - zz * covariance -
+                  2 * xz * yz * xy + z * z * covariance);
+    // The root lies below the smaller eigenvalue of the covariance, where the
+    // determinant vanishes. Fall back to Kasa's fit unless Newton converges
+    // monotonically inside that bracket.
+    const R bound = (z - std::sqrt(std::max(z * z - 4 * covariance, R()))) / 2;
+    R value = std::numeric_limits<R>::max();
+    bool converged = false;
+    for (int iteration = 0; iteration < 20; ++iteration) {
+      const R previous = value;
+      value = a0 + root * (a1 + root * (a2 + 4 * root * root));
+      if (std::abs(value) > std::abs(previous)) {
+        break;
+      }
+      const R derivative = a1 + root * (2 * a2 + 16 * root * root);
+      const R next = root - value / derivative;
+      if (!std::isfinite(next) || next < 0 || next >= bound) {
+        break;
+      }
+      if (std::abs(next - root) <=
+          std::numeric_limits<R>::epsilon() * std::abs(next)) {
+        root = next;
+        converged = true;
+        break;
+      }
+      root = next;
+    }
+    if (!converged) {
+      root = 0;
+    }
+  }
+  const R determinant = 2 * (root * root - root * z + covariance);
+  if (!determinant) {
+    return Result();
+  }
+  const Vec2<R> center((xz * (yy - root) - yz * xy) / determinant,
+                       (yz * (xx - root) - xz * xy) / determinant);
+  return Result(center + Vec2<R>(mx, my) + origin_,
+                std::sqrt(center.magnitudeSquared() + z + 2 * root));
+}
+
+#pragma mark Plane fitting
+
+template <class T>
+inline PlaneFitter<T>::PlaneFitter() : origin_(), count_(), moments_() {}
+
+template <class T>
+template <class InputIterator>
+inline PlaneFitter<T>::PlaneFitter(InputIterator first, InputIterator last)
+    : origin_(),
+      count_(),
+      moments_() {
+  add(first, last);
+}
+
+template <class T>
+template <class U>
+inline void PlaneFitter<T>::add(const Vec3<U>& point) {
+  if (!count_) {
+    origin_ = point;
+  }
+  const Moment x = static_cast<Moment>(point.x) - origin_.x;
+  const Moment y = static_cast<Moment>(point.y) - origin_.y;
+  const Moment z = static_cast<Moment>(point.z) - origin_.z;
+  Moment *m = moments_;
+  m[0] += 1;
+  m[1] += x; m[2] += y; m[3] += z;
+  m[4] += x * x; m[5] += x * y; m[6] += x * z;
+  m[7] += y * y; m[8] += y * z; m[9] += z * z;
+  ++count_;
+}
+
+template <class T>
+template <class InputIterator>
+inline void PlaneFitter<T>::add(InputIterator first, InputIterator last) {
+  for (; first != last; ++first) {
+    add(*first);
+  }
+}
+
+template <class T>
+inline void PlaneFitter<T>::merge(const PlaneFitter& other) {
+  if (!other.count_) {
+    return;
+  }
+  if (!count_) {
+    *this = other;
+    return;
+  }
+  // Shift the moments of the other fitter to this origin
+  const Vec3<Moment> d(static_cast<Moment>(other.origin_.x) - origin_.x,
+                       static_cast<Moment>(other.origin_.y) - origin_.y,
+                       static_cast<Moment>(other.origin_.z) - origin_.z);
+  const Moment *o = other.moments_;
+  const Moment *s = o + 1;
+  Moment *m = moments_;
+  m[0] += o[0];
+  for (int i = 0; i < 3; ++i) {
+    m[1 + i] += s[i] + d[i] * o[0];
+  }
+  // Second moments are stored in the upper triangle in row-major order
+  for (int i = 0, k = 4; i < 3; ++i) {
+    for (int j = i; j < 3; ++j, ++k) {
+      m[k] += o[k] + d[i] * s[j] + d[j] * s[i] + d[i] * d[j] * o[0];
+    }
+  }
+  count_ += other.count_;
+}
+
+template <class T>
+inline void PlaneFitter<T>::reset() {
+  *this = PlaneFitter();
+}
+
+template <class T>
+inline Vec3<Promote<T>> PlaneFitter<T>::centroid() const {
+  if (!count_) {
+    return Vec3<R>();
+  }
+  const Moment *m = moments_;
+  return Vec3<R>(Vec3<Moment>(m[1] / m[0], m[2] / m[0], m[3] / m[0]) +
+                 origin_);
+}
+
+template <class T>
+inline Vec3<Promote<T>> PlaneFitter<T>::normal() const {
+  using Result = Vec3<Promote<T>>;
+  using R = Moment;
+  if (count_ < 3) {
+    return Result();
+  }
+  const R *m = moments_;
+  const Vec3<R> mean(m[1] / m[0], m[2] / m[0], m[3] / m[0]);
+  const R xx = m[4] / m[0] - mean.x * mean.x;
+  const R xy = m[5] / m[0] - mean.x * mean.y;
+  const R xz = m[6] / m[0] - mean.x * mean.z;
+  const R yy = m[7] / m[0] - mean.y * mean.y;
+  const R yz = m[8] / m[0] - mean.y * mean.z;
+  const R zz = m[9] / m[0] - mean.z * mean.z;
+  Mat3<R> vectors;
+  decomposeSymmetric(Mat3<R>({xx, xy, xz, xy, yy, yz, xz, yz, zz}),
+                     nullptr, &vectors);
+  return Result(vectors.column(2));
+}
+
+#pragma mark Ellipse fitting
+
+template <class T>
+inline EllipseFitter<T>::EllipseFitter() : origin_(), count_(), moments_() {}
+
+template <class T>
+template <class InputIterator>
+inline EllipseFitter<T>::EllipseFitter(InputIterator first,
+                                       InputIterator last)
+    : origin_(),
+      count_(),
+      moments_() {
+  add(first, last);
+}
+
+template <class T>
+template <class U>
+inline void EllipseFitter<T>::add(const Vec2<U>& point) {
+  if (!count_) {
+    origin_ = point;
+  }
+  const Moment x = static_cast<Moment>(point.x) - origin_.x;
+  const Moment y = static_cast<Moment>(point.y) - origin_.y;
+  const Moment xx = x * x;
+  const Moment xy = x * y;
+  const Moment yy = y * y;
+  Moment *m = moments_;
+  m[0] += 1;
+  m[1] += x; m[2] += y;
+  m[3] += xx; m[4] += xy; m[5] += yy;
+  m[6] += xx * x; m[7] += xx * y; m[8] += xy * y; m[9] += yy * y;
+  m[10] += xx * xx; m[11] += xx * xy; m[12] += xx * yy; m[13] += xy * yy;
+  m[14] += yy * yy;
+  ++count_;
+}
+
+template <class T>
+template <class InputIterator>
+inline void EllipseFitter<T>::add(InputIterator first, InputIterator last) {
+  for (; first != last; ++first) {
+    add(*first);
+  }
+}
+
+template <class T>
+inline void EllipseFitter<T>::merge(const EllipseFitter& other) {
+  if (!other.count_) {
+    return;
+  }
+  if (!count_) {
+    *this = other;
+    return;
+  }
+  // Shift the moments of the other fitter to this origin by the binomial
+  // expansion of (x + dx)^i (y + dy)^j
+  const int binomial[5][5] = {
+    {1}, {1, 1}, {1, 2, 1}, {1, 3, 3, 1}, {1, 4, 6, 4, 1}
+  };
+  Moment dx[5] = {1};
+  Moment dy[5] = {1};
+  for (int i = 1; i < 5; ++i) {
+    dx[i] = dx[i - 1] * (static_cast<Moment>(other.origin_.x) - origin_.x);
+    dy[i] = dy[i - 1] * (static_cast<Moment>(other.origin_.y) - origin_.y);
+  }
+  for (int i = 0; i <= 4; ++i) {
+    for (int j = 0; i + j <= 4; ++j) {
+      Moment sum = 0;
+      for (int k = 0; k <= i; ++k) {
+        for (int l = 0; l <= j; ++l) {
+          sum += (binomial[i][k] * binomial[j][l] * dx[i - k] * dy[j - l] *
+                  other.moments_[moment(k, l)]);
+        }
+      }
+      moments_[moment(i, j)] += sum;
+    }
+  }
+  count_ += other.count_;
+}
+
+template <class T>
+inline void EllipseFitter<T>::reset() {
+  *this = EllipseFitter();
+}
+
+template <class T>
+inline Ellipse2<Promote<T>> EllipseFitter<T>::ellipse() const {
+  using Result = Ellipse2<Promote<T>>;
+  using R = Moment;
+  if (count_ < 5) {
+    return Result();
+  }
+  const auto m = [this](int i, int j) { return moments_[moment(i, j)]; };
+  // Scatter matrix of the design rows (x^2, xy, y^2 | x, y, 1), partitioned
+  // into the quadratic, mixed and linear blocks
+  const R s1[3][3] = {
+    {m(4, 0), m(3, 1), m(2, 2)},
+    {m(3, 1), m(2, 2), m(1, 3)},
+    {m(2, 2), m(1, 3), m(0, 4)}
+  };
+  const R s2[3][3] = {
+    {m(3, 0), m(2, 1), m(2, 0)},
+    {m(2, 1), m(1, 2), m(1, 1)},
+    {m(1, 2), m(0, 3), m(0, 2)}
+  };
+  const R s3[3][3] = {
+    {m(2, 0), m(1, 1), m(1, 0)},
+    {m(1, 1), m(0, 2), m(0, 1)},
+    {m(1, 0), m(0, 1), m(0, 0)}
+  };
+  // Adjugate of the symmetric linear block
+  const R inverse[3][3] = {
+    {s3[1][1] * s3[2][2] - s3[1][2] * s3[2][1],
+     s3[0][2] * s3[2][1] - s3[0][1] * s3[2][2],
+     s3[0][1] * s3[1][2] - s3[0][2] * s3[1][1]},
+    {s3[1][2] * s3[2][0] - s3[1][0] * s3[2][2],
+     s3[0][0] * s3[2][2] - s3[0][2] * s3[2][0],
+     s3[0][2] * s3[1][0] - s3[0][0] * s3[1][2]},
+    {s3[1][0] * s3[2][1] - s3[1][1] * s3[2][0],
+     s3[0][1] * s3[2][0] - s3[0][0] * s3[2][1],
+     s3[0][0] * s3[1][1] - s3[0][1] * s3[1][0]}
+  };
+  const R determinant = (s3[0][0] * inverse[0][0] +
+                         s3[0][1] * inverse[1][0] +
+                         s3[0][2] * inverse[2][0]);
+  if (!determinant) {
+    return Result();
+  }
+  // Linear coefficients in terms of the quadratic ones: -s3^-1 s2^T
+  R linear[3][3];
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      linear[i][j] = -(inverse[i][0] * s2[j][0] +
+                       inverse[i][1] * s2[j][1] +
+                       inverse[i][2] * s2[j][2]) / determinant;
+    }
+  }
+  R reduced[3][3];
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      reduced[i][j] = (s1[i][j] +
+                       s2[i][0] * linear[0][j] +
+                       s2[i][1] * linear[1][j] +
+                       s2[i][2] * linear[2][j]);
+    }
+  }
+  // Premultiply by the inverse of the constraint 4ac - b^2
+  const Vec3<R> rows[3] = {
+    Vec3<R>(reduced[2][0], reduced[2][1], reduced[2][2]) / 2,
+    -Vec3<R>(reduced[1][0], reduced[1][1], reduced[1][2]),
+    Vec3<R>(reduced[0][0], reduced[0][1], reduced[0][2]) / 2
+  };
+  const R trace = rows[0].x + rows[1].y + rows[2].z;
+  const R minors = (rows[0].x * rows[1].y - rows[0].y * rows[1].x +
+                    rows[0].x * rows[2].z - rows[0].z * rows[2].x +
+                    rows[1].y * rows[2].z - rows[1].z * rows[2].y);
+  const R product = rows[0].dot(rows[1].cross(rows[2]));
+  R eigenvalues[3];
+  const auto roots = solveCubic(R(1), -trace, minors, -product, eigenvalues);
+  Vec3<R> quadratic;
+  R best = 0;
+  for (unsigned int i = 0; i < roots; ++i) {
+    const Vec3<R> a = rows[0] - Vec3<R>(eigenvalues[i], 0, 0);
+    const Vec3<R> b = rows[1] - Vec3<R>(0, eigenvalues[i], 0);
+    const Vec3<R> c = rows[2] - Vec3<R>(0, 0, eigenvalues[i]);
+    Vec3<R> vector = a.cross(b);
+    if (a.cross(c).magnitudeSquared() > vector.magnitudeSquared()) {
+      vector = a.cross(c);
+    }
+    if (b.cross(c).magnitudeSquared() > vector.magnitudeSquared()) {
+      vector = b.cross(c);
+    }
+    vector.normalize();
+    const R constraint = 4 * vector.x * vector.z - vector.y * vector.y;
+    if (constraint > best) {
+      best = constraint;
+      quadratic = vector;
+    }
+  }
+  if (best <= 0) {
+    return Result();
+  }
+  const R a = quadratic.x;
+  const R b = quadratic.y;
+  const R c = quadratic.z;
+  const R d = linear[0][0] * a + linear[0][1] * b + linear[0][2] * c;
+  const R e = linear[1][0] * a + linear[1][1] * b + linear[1][2] * c;
+  const R f = linear[2][0] * a + linear[2][1] * b + linear[2][2] * c;
+  // Conic coefficients to center, radii and angle
+  const R denominator = b * b - 4 * a * c;
+  const R x = (2 * c * d - b * e) / denominator;
+  const R y = (2 * a * e - b * d) / denominator;
+  const R value = f + (d * x + e * y) / 2;
+  const R angle = std::atan2(b, a - c) / 2;
+  const R cosine = std::cos(angle);
+  const R sine = std::sin(angle);
+  const R major = a * cosine * cosine + b * sine * cosine + c * sine * sine;
+  const R minor = a * sine * sine - b * sine * cosine + c * cosine * cosine;
+  if (value * major >= 0 || value * minor >= 0) {
+    return Result();
+  }
+  // Put the major axis along the angle in (-pi / 2, pi / 2]
+  Vec2<R> radii(std::sqrt(-value / major), std::sqrt(-value / minor));
+  R rotation = angle;
+  if (radii.x < radii.y) {
+    std::swap(radii.x, radii.y);
+    rotation += rotation > 0 ? -half_pi<R>() : half_pi<R>();
+  }
+  return Result(Vec2<R>(x + origin_.x, y + origin_.y), radii, rotation);
+}
+
+#pragma mark Stream
+
+inline std::ostream& operator<<(std::ostream& os, CircleFit method) {
+  switch (method) {
+    case CircleFit::KASA: os << "kasa"; break;
+    case CircleFit::PRATT: os << "pratt"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+}  // namespace math
+
+using math::CircleFit;
+using math::LineFitter;
+using math::LineFitterf;
+using math::LineFitterd;
+using math::CircleFitter;
+using math::CircleFitterf;
+using math::CircleFitterd;
+using math::PlaneFitter;
+using math::PlaneFitterf;
+using math::PlaneFitterd;
+using math::EllipseFitter;
+using math::EllipseFitterf;
+using math::EllipseFitterd;
+
+}  // namespace takram
+
+template <>
+struct std::hash<takram::math::CircleFit> {
+  std::size_t operator()(const takram::math::CircleFit& value) const {
+    return static_cast<std::underlying_type<
+        takram::math::CircleFit>::type>(value);
+  }
+};
+
+#endif  // TAKRAM_MATH_FITTING_H_
@@ -0,0 +1,256 @@
+//
+//  takram/math/fused.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_FUSED_H_
+#define TAKRAM_MATH_FUSED_H_
+
+#include "takram/math/enablers.h"
+#include "takram/math/promotion.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Fused vector expressions that evaluate every component in a single pass,
+// promoting each operand into the type of the result before any arithmetic,
+// rather than building an intermediate vector for each operator.
+//
+// multiplyAdd() computes a * b + c, and combine() computes a * s + b * t.
+// Whether the multiplication and the addition are contracted into a single
+// rounding is left to the compiler. The former is not named fma so that it
+// does not hide the scalar fma() from unqualified calls in this namespace.
+
+template <class T, class U, class V>
+Vec2<Promote<Promote<T, U>, V>> multiplyAdd(const Vec2<T>& a,
+                                            const Vec2<U>& b,
+                                            const Vec2<V>& c);
+template <class T, class U, class V, EnableIfScalar<U> * = nullptr>
+Vec2<Promote<Promote<T, U>, V>> multiplyAdd(const Vec2<T>& a,
+                                            U b,
+                                            const Vec2<V>& c);
+template <class T, class U, class V, class W,
+          EnableIfScalar<U> * = nullptr, EnableIfScalar<W> * = nullptr>
+Vec2<Promote<Promote<T, U>, Promote<V, W>>> combine(const Vec2<T>& a,
+                                                    U s,
+                                                    const Vec2<V>& b,
+                                                    W t);
+
+template <class T, class U, class V>
+Vec3<Promote<Promote<T, U>, V>> multiplyAdd(const Vec3<T>& a,
+                                            const Vec3<U>& b,
+                                            const Vec3<V>& c);
+template <class T, class U, class V, EnableIfScalar<U> * = nullptr>
+Vec3<Promote<Promote<T, U>, V>> multiplyAdd(const Vec3<T>& a,
+                                            U b,
+                                            const Vec3<V>& c);
+template <class T, class U, class V, class W,
+          EnableIfScalar<U> * = nullptr, EnableIfScalar<W> * = nullptr>
+Vec3<Promote<Promote<T, U>, Promote<V, W>>> combine(const Vec3<T>& a,
+                                                    U s,
+                                                    const Vec3<V>& b,
+                                                    W t);
+
+template <class T, class U, class V>
+Vec4<Promote<Promote<T, U>, V>> multiplyAdd(const Vec4<T>& a,
+                                            const Vec4<U>& b,
+                                            const Vec4<V>& c);
+template <class T, class U, class V, EnableIfScalar<U> * = nullptr>
+Vec4<Promote<Promote<T, U>, V>> multiplyAdd(const Vec4<T>& a,
+                                            U b,
+                                            const Vec4<V>& c);
+template <class T, class U, class V, class W,
+          EnableIfScalar<U> * = nullptr, EnableIfScalar<W> * = nullptr>
+Vec4<Promote<Promote<T, U>, Promote<V, W>>> combine(const Vec4<T>& a,
+                                                    U s,
+                                                    const Vec4<V>& b,
+                                                    W t);
+
+template <class T, class U, class V, int D>
+Vec<Promote<Promote<T, U>, V>, D> multiplyAdd(const Vec<T, D>& a,
+                                              const Vec<U, D>& b,
+                                              const Vec<V, D>& c);
+template <class T, class U, class V, int D, EnableIfScalar<U> * = nullptr>
+Vec<Promote<Promote<T, U>, V>, D> multiplyAdd(const Vec<T, D>& a,
+                                              U b,
+                                              const Vec<V, D>& c);
+template <class T, class U, class V, class W, int D,
+          EnableIfScalar<U> * = nullptr, EnableIfScalar<W> * = nullptr>
+Vec<Promote<Promote<T, U>, Promote<V, W>>, D> combine(const Vec<T, D>& a,
+                                                      U s,
+                                                      const Vec<V, D>& b,
+                                                      W t);
+
+#pragma mark -
+
+#pragma mark Vec2
+
+template <class T, class U, class V>
+inline Vec2<Promote<Promote<T, U>, V>> multiplyAdd(const Vec2<T>& a,
+                                                   const Vec2<U>& b,
+                                                   const Vec2<V>& c) {
+  using R = Promote<Promote<T, U>, V>;
+  return Vec2<R>(static_cast<R>(a.x) * b.x + c.x,
+                 static_cast<R>(a.y) * b.y + c.y);
+}
+
+template <class T, class U, class V, EnableIfScalar<U> *>
+inline Vec2<Promote<Promote<T, U>, V>> multiplyAdd(const Vec2<T>& a,
+                                                   U b,
+                                                   const Vec2<V>& c) {
+  using R = Promote<Promote<T, U>, V>;
+  return Vec2<R>(static_cast<R>(a.x) * b + c.x,
+                 static_cast<R>(a.y) * b + c.y);
+}
+
+template <class T, class U, class V, class W,
+          EnableIfScalar<U> *, EnableIfScalar<W> *>
+inline Vec2<Promote<Promote<T, U>, Promote<V, W>>> combine(const Vec2<T>& a,
+                                                           U s,
+                                                           const Vec2<V>& b,
+                                                           W t) {
+  using R = Promote<Promote<T, U>, Promote<V, W>>;
+  return Vec2<R>(static_cast<R>(a.x) * s + static_cast<R>(b.x) * t,
+                 static_cast<R>(a.y) * s + static_cast<R>(b.y) * t);
+}
+
+#pragma mark Vec3
+
+template <class T, class U, class V>
+inline Vec3<Promote<Promote<T, U>, V>> multiplyAdd(const Vec3<T>& a,
+                                                   const Vec3<U>& b,
+                                                   const Vec3<V>& c) {
+  using R = Promote<Promote<T, U>, V>;
+  return Vec3<R>(static_cast<R>(a.x) * b.x + c.x,
+                 static_cast<R>(a.y) * b.y + c.y,
+                 static_cast<R>(a.z) * b.z + c.z);
+}
+
+template <class T, class U, class V, EnableIfScalar<U> *>
+inline Vec3<Promote<Promote<T, U>, V>> multiplyAdd(const Vec3<T>& a,
+                                                   U b,
+                                                   const Vec3<V>& c) {
+  using R = Promote<Promote<T, U>, V>;
+  return Vec3<R>(static_cast<R>(a.x) * b + c.x,
+                 static_cast<R>(a.y) * b + c.y,
+                 static_cast<R>(a.z) * b + c.z);
+}
+
+template <class T, class U, class V, class W,
+          EnableIfScalar<U> *, EnableIfScalar<W> *>
+inline Vec3<Promote<Promote<T, U>, Promote<V, W>>> combine(const Vec3<T>& a,
+                                                           U s,
+                                                           const Vec3<V>& b,
+                                                           W t) {
+  using R = Promote<Promote<T, U>, Promote<V, W>>;
+  return Vec3<R>(static_cast<R>(a.x) * s + static_cast<R>(b.x) * t,
+                 static_cast<R>(a.y) * s + static_cast<R>(b.y) * t,
+                 static_cast<R>(a.z) * s + static_cast<R>(b.z) * t);
+}
+
+#pragma mark Vec4
+
+template <class T, class U, class V>
+inline Vec4<Promote<Promote<T, U>, V>> multiplyAdd(const Vec4<T>& a,
+                                                   const Vec4<U>& b,
+                                                   const Vec4<V>& c) {
+  using R = Promote<Promote<T, U>, V>;
+  return Vec4<R>(static_cast<R>(a.x) * b.x + c.x,
+                 static_cast<R>(a.y) * b.y + c.y,
+                 static_cast<R>(a.z) * b.z + c.z,
+                 static_cast<R>(a.w) * b.w + c.w);
+}
+
+template <class T, class U, class V, EnableIfScalar<U> *>
+inline Vec4<Promote<Promote<T, U>, V>> multiplyAdd(const Vec4<T>& a,
+                                                   U b,
+                                                   const Vec4<V>& c) {
+  using R = Promote<Promote<T, U>, V>;
+  return Vec4<R>(static_cast<R>(a.x) * b + c.x,
+                 static_cast<R>(a.y) * b + c.y,
+                 static_cast<R>(a.z) * b + c.z,
+                 static_cast<R>(a.w) * b + c.w);
+}
+
+template <class T, class U, class V, class W,
+          EnableIfScalar<U> *, EnableIfScalar<W> *>
+inline Vec4<Promote<Promote<T, U>, Promote<V, W>>> combine(const Vec4<T>& a,
+                                                           U s,
+                                                           const Vec4<V>& b,
+                                                           W t) {
+  using R = Promote<Promote<T, U>, Promote<V, W>>;
+  return Vec4<R>(static_cast<R>(a.x) * s + static_cast<R>(b.x) * t,
+                 static_cast<R>(a.y) * s + static_cast<R>(b.y) * t,
+                 static_cast<R>(a.z) * s + static_cast<R>(b.z) * t,
+                 static_cast<R>(a.w) * s + static_cast<R>(b.w) * t);
+}
+
+#pragma mark Vectors of more than four dimensions
+
+template <class T, class U, class V, int D>
+inline Vec<Promote<Promote<T, U>, V>, D> multiplyAdd(const Vec<T, D>& a,
+                                                     const Vec<U, D>& b,
+                                                     const Vec<V, D>& c) {
+  using R = Promote<Promote<T, U>, V>;
+  Vec<R, D> result;
+  for (int i = 0; i < D; ++i) {
+    result[i] = static_cast<R>(a[i]) * b[i] + c[i];
+  }
+  return result;
+}
+
+template <class T, class U, class V, int D, EnableIfScalar<U> *>
+inline Vec<Promote<Promote<T, U>, V>, D> multiplyAdd(const Vec<T, D>& a,
+                                                     U b,
+                                                     const Vec<V, D>& c) {
+  using R = Promote<Promote<T, U>, V>;
+  Vec<R, D> result;
+  for (int i = 0; i < D; ++i) {
+    result[i] = static_cast<R>(a[i]) * b + c[i];
+  }
+  return result;
+}
+
+template <class T, class U, class V, class W, int D,
+          EnableIfScalar<U> *, EnableIfScalar<W> *>
+inline Vec<Promote<Promote<T, U>, Promote<V, W>>, D> combine(
+    const Vec<T, D>& a, U s, const Vec<V, D>& b, W t) {
+  using R = Promote<Promote<T, U>, Promote<V, W>>;
+  Vec<R, D> result;
+  for (int i = 0; i < D; ++i) {
+    result[i] = static_cast<R>(a[i]) * s + static_cast<R>(b[i]) * t;
+  }
+  return result;
+}
+
+}  // namespace math
+
+using math::multiplyAdd;
+using math::combine;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_FUSED_H_
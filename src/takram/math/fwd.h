@@ -0,0 +1,233 @@
+//
+//  takram/math/fwd.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_FWD_H_
+#define TAKRAM_MATH_FWD_H_
+
+namespace takram {
+namespace math {
+
+// Forward declarations of the class templates and their aliases, for headers
+// that only name these types in declarations and want to avoid including the
+// full definitions.
+
+template <class T, int D>
+class Vec;
+template <class T, int D>
+class Size;
+template <class T, int D>
+class Rect;
+template <class T, int D>
+class Line;
+template <class T, int D>
+class Triangle;
+template <class T, int D>
+class Circle;
+template <class T, int D>
+class Ellipse;
+template <class T, int D>
+class OrientedRect;
+template <class T, int D>
+class Mat;
+template <class Engine>
+class Random;
+
+template <class T>
+using Vec2 = Vec<T, 2>;
+template <class T>
+using Vec3 = Vec<T, 3>;
+template <class T>
+using Vec4 = Vec<T, 4>;
+template <class T>
+using Size2 = Size<T, 2>;
+template <class T>
+using Size3 = Size<T, 3>;
+template <class T>
+using Rect2 = Rect<T, 2>;
+template <class T>
+using Line2 = Line<T, 2>;
+template <class T>
+using Line3 = Line<T, 3>;
+template <class T>
+using Triangle2 = Triangle<T, 2>;
+template <class T>
+using Triangle3 = Triangle<T, 3>;
+template <class T>
+using Circle2 = Circle<T, 2>;
+template <class T>
+using Ellipse2 = Ellipse<T, 2>;
+template <class T>
+using OrientedRect2 = OrientedRect<T, 2>;
+template <class T>
+using OrientedRect3 = OrientedRect<T, 3>;
+template <class T>
+using Mat2 = Mat<T, 2>;
+template <class T>
+using Mat3 = Mat<T, 3>;
+template <class T>
+using Mat4 = Mat<T, 4>;
+
+using Vec2i = Vec2<int>;
+using Vec2f = Vec2<float>;
+using Vec2d = Vec2<double>;
+using Vec3i = Vec3<int>;
+using Vec3f = Vec3<float>;
+using Vec3d = Vec3<double>;
+using Vec4i = Vec4<int>;
+using Vec4f = Vec4<float>;
+using Vec4d = Vec4<double>;
+using Size2i = Size2<int>;
+using Size2f = Size2<float>;
+using Size2d = Size2<double>;
+using Size3i = Size3<int>;
+using Size3f = Size3<float>;
+using Size3d = Size3<double>;
+using Rect2i = Rect2<int>;
+using Rect2f = Rect2<float>;
+using Rect2d = Rect2<double>;
+using Line2i = Line2<int>;
+using Line2f = Line2<float>;
+using Line2d = Line2<double>;
+using Line3i = Line3<int>;
+using Line3f = Line3<float>;
+using Line3d = Line3<double>;
+using Triangle2i = Triangle2<int>;
+using Triangle2f = Triangle2<float>;
+using Triangle2d = Triangle2<double>;
+using Triangle3i = Triangle3<int>;
+using Triangle3f = Triangle3<float>;
+using Triangle3d = Triangle3<double>;
+using Circle2i = Circle2<int>;
+using Circle2f = Circle2<float>;
+using Circle2d = Circle2<double>;
+using Ellipse2f = Ellipse2<float>;
+using Ellipse2d = Ellipse2<double>;
+using OrientedRect2f = OrientedRect2<float>;
+using OrientedRect2d = OrientedRect2<double>;
+using OrientedRect3f = OrientedRect3<float>;
+using OrientedRect3d = OrientedRect3<double>;
+using Mat2f = Mat2<float>;
+using Mat2d = Mat2<double>;
+using Mat3f = Mat3<float>;
+using Mat3d = Mat3<double>;
+using Mat4f = Mat4<float>;
+using Mat4d = Mat4<double>;
+
+// Provides the shared instance of the default random engine. The partial
+// specialization that does so is defined in random.h, and the template
+// parameter only defers the lookup of it until instantiation, so that the
+// vector and size headers can provide random() and jitter() without including
+// <random>.
+template <class T, class = void>
+struct SharedRandom {
+  static_assert(sizeof(T) == 0,
+                "random() and jitter() require takram/math/random.h");
+};
+
+template <class T>
+inline auto& sharedRandom() {
+  return SharedRandom<T>::get();
+}
+
+}  // namespace math
+
+using math::Vec;
+using math::Vec2;
+using math::Vec2i;
+using math::Vec2f;
+using math::Vec2d;
+using math::Vec3;
+using math::Vec3i;
+using math::Vec3f;
+using math::Vec3d;
+using math::Vec4;
+using math::Vec4i;
+using math::Vec4f;
+using math::Vec4d;
+using math::Size;
+using math::Size2;
+using math::Size2i;
+using math::Size2f;
+using math::Size2d;
+using math::Size3;
+using math::Size3i;
+using math::Size3f;
+using math::Size3d;
+using math::Rect;
+using math::Rect2;
+using math::Rect2i;
+using math::Rect2f;
+using math::Rect2d;
+using math::Line;
+using math::Line2;
+using math::Line2i;
+using math::Line2f;
+using math::Line2d;
+using math::Line3;
+using math::Line3i;
+using math::Line3f;
+using math::Line3d;
+using math::Triangle;
+using math::Triangle2;
+using math::Triangle2i;
+using math::Triangle2f;
+using math::Triangle2d;
+using math::Triangle3;
+using math::Triangle3i;
+using math::Triangle3f;
+using math::Triangle3d;
+using math::Circle;
+using math::Circle2;
+using math::Circle2i;
+using math::Circle2f;
+using math::Circle2d;
+using math::Ellipse;
+using math::Ellipse2;
+using math::Ellipse2f;
+using math::Ellipse2d;
+using math::OrientedRect;
+using math::OrientedRect2;
+using math::OrientedRect2f;
+using math::OrientedRect2d;
+using math::OrientedRect3;
+using math::OrientedRect3f;
+using math::OrientedRect3d;
+using math::Mat;
+using math::Mat2;
+using math::Mat2f;
+using math::Mat2d;
+using math::Mat3;
+using math::Mat3f;
+using math::Mat3d;
+using math::Mat4;
+using math::Mat4f;
+using math::Mat4d;
+using math::Random;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_FWD_H_
@@ -0,0 +1,719 @@
+//
+//  takram/math/gjk.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_GJK_H_
+#define TAKRAM_MATH_GJK_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "takram/math/support.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Convex queries between any two shapes providing support functions. The
+// result of the last query is retained: a separating query restarts from the
+// last separating axis, and an intersecting one from the last simplex by
+// re-evaluating the supports along the same directions. Keeping one instance
+// per pair of shapes therefore resolves coherent contacts in a few
+// iterations.
+template <class T, int D>
+class GJK final {
+ public:
+  using Type = T;
+  using Point = Vec<T, D>;
+  static constexpr const int dimensions = D;
+
+ public:
+  GJK();
+
+  // Copy semantics
+  GJK(const GJK&) = default;
+  GJK& operator=(const GJK&) = default;
+
+  // Parameters
+  int maxIterations() const { return max_iterations_; }
+  void setMaxIterations(int value) { max_iterations_ = value; }
+  T tolerance() const { return tolerance_; }
+  void setTolerance(T value) { tolerance_ = value; }
+
+  // Queries
+  template <class A, class B>
+  bool intersects(const A& a, const B& b);
+  template <class A, class B>
+  T distance(const A& a, const B& b);
+  template <class A, class B>
+  bool penetration(const A& a, const B& b);
+
+  // Simplex
+  void reset() { size_ = 0; axis_ = Point(); }
+  int simplexSize() const { return size_; }
+
+  // Results
+  const Point& closestA() const { return closest_a_; }
+  const Point& closestB() const { return closest_b_; }
+  const Point& normal() const { return normal_; }
+  T depth() const { return depth_; }
+  int iterations() const { return iterations_; }
+
+ private:
+  struct Vertex {
+    Point direction;
+    Point point;
+    Point a;
+    Point b;
+  };
+
+  struct Face {
+    int i;
+    int j;
+    int k;
+    Point normal;
+    T distance;
+  };
+
+  template <class A, class B>
+  Vertex supportOf(const A& a, const B& b, const Point& direction) const;
+  template <class A, class B>
+  bool solve(const A& a, const B& b, bool early);
+  bool contains(const Vertex& vertex) const;
+  bool reduce(Point *closest);
+  template <class U = T>
+  bool reduce(Point *closest, std::integral_constant<int, 2>);
+  template <class U = T>
+  bool reduce(Point *closest, std::integral_constant<int, 3>);
+  Point reduceSegment(int i, int j, T *lambda) const;
+  Point reduceTriangle(int i, int j, int k, T *lambda) const;
+  void compact(const T *lambda);
+  void witness(const T *lambda);
+
+  // Expanding polytope
+  template <class A, class B>
+  bool inflate(const A& a, const B& b, std::integral_constant<int, 2>);
+  template <class A, class B>
+  bool inflate(const A& a, const B& b, std::integral_constant<int, 3>);
+  template <class A, class B>
+  void expand(const A& a, const B& b, std::integral_constant<int, 2>);
+  template <class A, class B>
+  void expand(const A& a, const B& b, std::integral_constant<int, 3>);
+  template <class U = T>
+  Face makeFace(int i, int j, int k, const Point& center) const;
+  void addEdge(int i, int j);
+
+ private:
+  int max_iterations_;
+  T tolerance_;
+  Vertex simplex_[D + 1];
+  int size_;
+  Point axis_;
+  Point closest_a_;
+  Point closest_b_;
+  Point normal_;
+  T depth_;
+  int iterations_;
+  std::vector<Vertex> polytope_;
+  std::vector<Face> faces_;
+  std::vector<std::pair<int, int>> edges_;
+};
+
+using GJK2f = GJK<float, 2>;
+using GJK2d = GJK<double, 2>;
+using GJK3f = GJK<float, 3>;
+using GJK3d = GJK<double, 3>;
+
+#pragma mark -
+
+template <class T, int D>
+inline GJK<T, D>::GJK()
+    : max_iterations_(64),
+      tolerance_(std::sqrt(std::numeric_limits<T>::epsilon())),
+      simplex_(),
+      size_(),
+      axis_(),
+      depth_(),
+      iterations_() {}
+
+#pragma mark Queries
+
+template <class T, int D>
+template <class A, class B>
+inline bool GJK<T, D>::intersects(const A& a, const B& b) {
+  return solve(a, b, true);
+}
+
+template <class T, int D>
+template <class A, class B>
+inline T GJK<T, D>::distance(const A& a, const B& b) {
+  if (solve(a, b, false)) {
+    return T();
+  }
+  return closest_a_.distance(closest_b_);
+}
+
+template <class T, int D>
+template <class A, class B>
+inline bool GJK<T, D>::penetration(const A& a, const B& b) {
+  if (!solve(a, b, false)) {
+    normal_ = (closest_b_ - closest_a_).normalize();
+    depth_ = -closest_a_.distance(closest_b_);
+    return false;
+  }
+  if (!inflate(a, b, std::integral_constant<int, D>())) {
+    depth_ = T();
+    return true;
+  }
+  expand(a, b, std::integral_constant<int, D>());
+  return true;
+}
+
+#pragma mark Simplex
+
+template <class T, int D>
+template <class A, class B>
+inline typename GJK<T, D>::Vertex GJK<T, D>::supportOf(
+    const A& a, const B& b, const Point& direction) const {
+  Vertex vertex;
+  vertex.direction = direction;
+  vertex.a = support(a, direction);
+  vertex.b = support(b, -direction);
+  vertex.point = vertex.a - vertex.b;
+  return vertex;
+}
+
+template <class T, int D>
+template <class A, class B>
+inline bool GJK<T, D>::solve(const A& a, const B& b, bool early) {
+  iterations_ = 0;
+  const int size = size_;
+  size_ = 0;
+  if (!axis_.empty()) {
+    simplex_[size_++] = supportOf(a, b, -axis_);
+  } else {
+    for (int i = 0; i < size; ++i) {
+      const auto vertex = supportOf(a, b, simplex_[i].direction);
+      if (!contains(vertex)) {
+        simplex_[size_++] = vertex;
+      }
+    }
+  }
+  if (!size_) {
+    Point direction;
+    direction[0] = 1;
+    simplex_[size_++] = supportOf(a, b, direction);
+  }
+  const T epsilon = tolerance_ * tolerance_;
+  Point closest;
+  axis_ = Point();
+  while (iterations_++ < max_iterations_) {
+    // Clear the separating axis on intersection, so that the next query
+    // replays the simplex instead.
+    if (reduce(&closest)) {
+      axis_ = Point();
+      return true;
+    }
+    const T squared = closest.magnitudeSquared();
+    if (squared <= epsilon) {
+      axis_ = Point();
+      return true;
+    }
+    axis_ = closest;
+    const auto vertex = supportOf(a, b, -closest);
+    const T projection = closest.dot(vertex.point);
+    if (early && projection > 0) {
+      return false;
+    }
+    if (squared - projection <= tolerance_ * squared || contains(vertex)) {
+      return false;
+    }
+    simplex_[size_++] = vertex;
+  }
+  return false;
+}
+
+template <class T, int D>
+inline bool GJK<T, D>::contains(const Vertex& vertex) const {
+  for (int i = 0; i < size_; ++i) {
+    if (simplex_[i].point == vertex.point) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class T, int D>
+inline bool GJK<T, D>::reduce(Point *closest) {
+  T lambda[D + 1] = {};
+  if (size_ == D + 1) {
+    return reduce(closest, std::integral_constant<int, D>());
+  } else if (size_ == 3) {
+    *closest = reduceTriangle(0, 1, 2, lambda);
+  } else if (size_ == 2) {
+    *closest = reduceSegment(0, 1, lambda);
+  } else {
+    lambda[0] = 1;
+    *closest = simplex_[0].point;
+  }
+  witness(lambda);
+  compact(lambda);
+  return false;
+}
+
+template <class T, int D>
+template <class U>
+inline bool GJK<T, D>::reduce(Point *closest,
+                              std::integral_constant<int, 2>) {
+  T lambda[3] = {};
+  *closest = reduceTriangle(0, 1, 2, lambda);
+  witness(lambda);
+  if (lambda[0] > 0 && lambda[1] > 0 && lambda[2] > 0) {
+    return true;
+  }
+  compact(lambda);
+  return false;
+}
+
+template <class T, int D>
+template <class U>
+inline bool GJK<T, D>::reduce(Point *closest,
+                              std::integral_constant<int, 3>) {
+  static const int faces[4][4] = {
+    {0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}
+  };
+  T lambda[4] = {};
+  T best = std::numeric_limits<T>::max();
+  bool outside = false;
+  for (const auto& face : faces) {
+    const auto& a = simplex_[face[0]].point;
+    const auto& b = simplex_[face[1]].point;
+    const auto& c = simplex_[face[2]].point;
+    const auto& d = simplex_[face[3]].point;
+    const auto normal = (b - a).cross(c - a);
+    if (normal.dot(-a) * normal.dot(d - a) > 0) {
+      continue;
+    }
+    outside = true;
+    T weights[4] = {};
+    const auto point = reduceTriangle(face[0], face[1], face[2], weights);
+    const T squared = point.magnitudeSquared();
+    if (squared < best) {
+      best = squared;
+      *closest = point;
+      std::copy(weights, weights + 4, lambda);
+    }
+  }
+  if (!outside) {
+    *closest = Point();
+    std::fill(lambda, lambda + 4, T(1) / 4);
+    witness(lambda);
+    return true;
+  }
+  witness(lambda);
+  compact(lambda);
+  return false;
+}
+
+template <class T, int D>
+inline typename GJK<T, D>::Point GJK<T, D>::reduceSegment(
+    int i, int j, T *lambda) const {
+  const auto& a = simplex_[i].point;
+  const auto& b = simplex_[j].point;
+  const Point ab = b - a;
+  const T denominator = ab.magnitudeSquared();
+  const T t = denominator ? -a.dot(ab) / denominator : T();
+  if (t <= 0) {
+    lambda[i] = 1;
+    return a;
+  } else if (t >= 1) {
+    lambda[j] = 1;
+    return b;
+  }
+  lambda[i] = 1 - t;
+  lambda[j] = t;
+  return a + ab * t;
+}
+
+template <class T, int D>
+inline typename GJK<T, D>::Point GJK<T, D>::reduceTriangle(
+    int i, int j, int k, T *lambda) const {
+  // Closest point on triangle to the origin by Voronoi regions, after
+  // Ericson, Real-Time Collision Detection, 5.1.5.
+  const auto& a = simplex_[i].point;
+  const auto& b = simplex_[j].point;
+  const auto& c = simplex_[k].point;
+  const Point ab = b - a;
+  const Point ac = c - a;
+  const T d1 = -ab.dot(a);
+  const T d2 = -ac.dot(a);
+  if (d1 <= 0 && d2 <= 0) {
+    lambda[i] = 1;
+    return a;
+  }
+  const T d3 = -ab.dot(b);
+  const T d4 = -ac.dot(b);
+  if (d3 >= 0 && d4 <= d3) {
+    lambda[j] = 1;
+    return b;
+  }
+  const T vc = d1 * d4 - d3 * d2;
+  if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+    return reduceSegment(i, j, lambda);
+  }
+  const T d5 = -ab.dot(c);
+  const T d6 = -ac.dot(c);
+  if (d6 >= 0 && d5 <= d6) {
+    lambda[k] = 1;
+    return c;
+  }
+  const T vb = d5 * d2 - d1 * d6;
+  if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+    return reduceSegment(i, k, lambda);
+  }
+  const T va = d3 * d6 - d5 * d4;
+  if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+    return reduceSegment(j, k, lambda);
+  }
+  const T denominator = va + vb + vc;
+  if (denominator <= 0) {
+    // Degenerate triangle
+    T weights[D + 1][D + 1] = {};
+    const Point points[] = {
+      reduceSegment(i, j, weights[0]),
+      reduceSegment(i, k, weights[1]),
+      reduceSegment(j, k, weights[2])
+    };
+    int best = 0;
+    for (int n = 1; n < 3; ++n) {
+      if (points[n].magnitudeSquared() < points[best].magnitudeSquared()) {
+        best = n;
+      }
+    }
+    std::copy(weights[best], weights[best] + D + 1, lambda);
+    return points[best];
+  }
+  const T v = vb / denominator;
+  const T w = vc / denominator;
+  lambda[i] = 1 - v - w;
+  lambda[j] = v;
+  lambda[k] = w;
+  return a + ab * v + ac * w;
+}
+
+template <class T, int D>
+inline void GJK<T, D>::compact(const T *lambda) {
+  int size = 0;
+  for (int i = 0; i < size_; ++i) {
+    if (lambda[i] > 0) {
+      simplex_[size++] = simplex_[i];
+    }
+  }
+  size_ = size;
+}
+
+template <class T, int D>
+inline void GJK<T, D>::witness(const T *lambda) {
+  closest_a_ = Point();
+  closest_b_ = Point();
+  for (int i = 0; i < size_; ++i) {
+    closest_a_ += simplex_[i].a * lambda[i];
+    closest_b_ += simplex_[i].b * lambda[i];
+  }
+}
+
+#pragma mark Expanding polytope
+
+template <class T, int D>
+template <class A, class B>
+inline bool GJK<T, D>::inflate(const A& a,
+                               const B& b,
+                               std::integral_constant<int, 2>) {
+  static const Point axes[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+  const T epsilon = tolerance_ * tolerance_;
+  if (size_ == 1) {
+    for (const auto& axis : axes) {
+      const auto vertex = supportOf(a, b, axis);
+      if (vertex.point.distanceSquared(simplex_[0].point) > epsilon) {
+        simplex_[size_++] = vertex;
+        break;
+      }
+    }
+  }
+  if (size_ == 2) {
+    const Point edge = simplex_[1].point - simplex_[0].point;
+    const Point normal(-edge.y, edge.x);
+    for (const auto& direction : {normal, -normal}) {
+      const auto vertex = supportOf(a, b, direction);
+      if (std::abs(edge.cross(vertex.point - simplex_[0].point)) > epsilon) {
+        simplex_[size_++] = vertex;
+        break;
+      }
+    }
+  }
+  if (size_ != 3) {
+    normal_ = size_ == 2 ? Point(simplex_[0].point.y - simplex_[1].point.y,
+                                 simplex_[1].point.x - simplex_[0].point.x)
+                         : axes[0];
+    normal_.normalize();
+    return false;
+  }
+  return true;
+}
+
+template <class T, int D>
+template <class A, class B>
+inline bool GJK<T, D>::inflate(const A& a,
+                               const B& b,
+                               std::integral_constant<int, 3>) {
+  static const Point axes[] = {
+    {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
+  };
+  const T epsilon = tolerance_ * tolerance_;
+  if (size_ == 1) {
+    for (const auto& axis : axes) {
+      const auto vertex = supportOf(a, b, axis);
+      if (vertex.point.distanceSquared(simplex_[0].point) > epsilon) {
+        simplex_[size_++] = vertex;
+        break;
+      }
+    }
+  }
+  if (size_ == 2) {
+    const Point edge = simplex_[1].point - simplex_[0].point;
+    const Point axis = (std::abs(edge.x) < std::abs(edge.y)
+                        ? (std::abs(edge.x) < std::abs(edge.z) ? axes[0]
+                                                               : axes[4])
+                        : (std::abs(edge.y) < std::abs(edge.z) ? axes[2]
+                                                               : axes[4]));
+    const Point u = edge.cross(axis);
+    const Point v = edge.cross(u);
+    for (const auto& direction : {u, -u, v, -v}) {
+      const auto vertex = supportOf(a, b, direction);
+      const auto offset = vertex.point - simplex_[0].point;
+      if (edge.cross(offset).magnitudeSquared() >
+          epsilon * edge.magnitudeSquared()) {
+        simplex_[size_++] = vertex;
+        break;
+      }
+    }
+  }
+  if (size_ == 3) {
+    const Point normal = (simplex_[1].point - simplex_[0].point).cross(
+        simplex_[2].point - simplex_[0].point);
+    for (const auto& direction : {normal, -normal}) {
+      const auto vertex = supportOf(a, b, direction);
+      if (std::abs(normal.dot(vertex.point - simplex_[0].point)) >
+          epsilon * normal.magnitude()) {
+        simplex_[size_++] = vertex;
+        break;
+      }
+    }
+  }
+  if (size_ != 4) {
+    normal_ = axes[0];
+    if (size_ == 3) {
+      normal_ = (simplex_[1].point - simplex_[0].point).cross(
+          simplex_[2].point - simplex_[0].point).normalize();
+    }
+    return false;
+  }
+  return true;
+}
+
+template <class T, int D>
+template <class A, class B>
+inline void GJK<T, D>::expand(const A& a,
+                              const B& b,
+                              std::integral_constant<int, 2>) {
+  polytope_.assign(simplex_, simplex_ + 3);
+  if ((polytope_[1].point - polytope_[0].point).cross(
+          polytope_[2].point - polytope_[0].point) < 0) {
+    std::swap(polytope_[1], polytope_[2]);
+  }
+  std::size_t edge = 0;
+  Point normal;
+  T distance = T();
+  const auto nearest = [&]() {
+    distance = std::numeric_limits<T>::max();
+    for (std::size_t i = 0; i < polytope_.size(); ++i) {
+      const auto& p = polytope_[i].point;
+      const auto& q = polytope_[(i + 1) % polytope_.size()].point;
+      const Point n = Point(q.y - p.y, p.x - q.x).normalize();
+      const T d = n.dot(p);
+      if (d < distance) {
+        distance = d;
+        normal = n;
+        edge = i;
+      }
+    }
+  };
+  nearest();
+  for (int iteration = 0; iteration < max_iterations_; ++iteration) {
+    const auto vertex = supportOf(a, b, normal);
+    if (vertex.point.dot(normal) - distance <=
+        tolerance_ * std::max<T>(1, distance)) {
+      break;
+    }
+    polytope_.insert(polytope_.begin() + edge + 1, vertex);
+    nearest();
+  }
+  const auto& p = polytope_[edge];
+  const auto& q = polytope_[(edge + 1) % polytope_.size()];
+  const Point pq = q.point - p.point;
+  const T length = pq.magnitudeSquared();
+  T t = length ? (normal * distance - p.point).dot(pq) / length : T();
+  t = std::min<T>(std::max<T>(t, 0), 1);
+  closest_a_ = p.a + (q.a - p.a) * t;
+  closest_b_ = p.b + (q.b - p.b) * t;
+  normal_ = normal;
+  depth_ = std::max<T>(distance, 0);
+}
+
+template <class T, int D>
+template <class A, class B>
+inline void GJK<T, D>::expand(const A& a,
+                              const B& b,
+                              std::integral_constant<int, 3>) {
+  polytope_.assign(simplex_, simplex_ + 4);
+  const Point center = (polytope_[0].point + polytope_[1].point +
+                        polytope_[2].point + polytope_[3].point) / 4;
+  faces_.clear();
+  faces_.push_back(makeFace(0, 1, 2, center));
+  faces_.push_back(makeFace(0, 3, 1, center));
+  faces_.push_back(makeFace(0, 2, 3, center));
+  faces_.push_back(makeFace(1, 3, 2, center));
+  std::size_t closest = 0;
+  const auto nearest = [&]() {
+    closest = 0;
+    for (std::size_t i = 1; i < faces_.size(); ++i) {
+      if (faces_[i].distance < faces_[closest].distance) {
+        closest = i;
+      }
+    }
+  };
+  nearest();
+  for (int iteration = 0; iteration < max_iterations_; ++iteration) {
+    const Face face = faces_[closest];
+    const auto vertex = supportOf(a, b, face.normal);
+    if (vertex.point.dot(face.normal) - face.distance <=
+        tolerance_ * std::max<T>(1, face.distance)) {
+      break;
+    }
+    const int index = static_cast<int>(polytope_.size());
+    polytope_.push_back(vertex);
+    edges_.clear();
+    for (std::size_t i = 0; i < faces_.size();) {
+      const auto& f = faces_[i];
+      if (f.normal.dot(vertex.point - polytope_[f.i].point) > 0) {
+        addEdge(f.i, f.j);
+        addEdge(f.j, f.k);
+        addEdge(f.k, f.i);
+        faces_[i] = faces_.back();
+        faces_.pop_back();
+      } else {
+        ++i;
+      }
+    }
+    if (edges_.empty()) {
+      break;
+    }
+    for (const auto& edge : edges_) {
+      faces_.push_back(makeFace(edge.first, edge.second, index, center));
+    }
+    nearest();
+  }
+  const Face& face = faces_[closest];
+  const auto& p = polytope_[face.i];
+  const auto& q = polytope_[face.j];
+  const auto& r = polytope_[face.k];
+  // Barycentric coordinates of the projected origin
+  const Point projection = face.normal * face.distance;
+  const Point v0 = q.point - p.point;
+  const Point v1 = r.point - p.point;
+  const Point v2 = projection - p.point;
+  const T d00 = v0.dot(v0);
+  const T d01 = v0.dot(v1);
+  const T d11 = v1.dot(v1);
+  const T d20 = v2.dot(v0);
+  const T d21 = v2.dot(v1);
+  const T denominator = d00 * d11 - d01 * d01;
+  T v = T();
+  T w = T();
+  if (denominator) {
+    v = (d11 * d20 - d01 * d21) / denominator;
+    w = (d00 * d21 - d01 * d20) / denominator;
+  }
+  closest_a_ = p.a * (1 - v - w) + q.a * v + r.a * w;
+  closest_b_ = p.b * (1 - v - w) + q.b * v + r.b * w;
+  normal_ = face.normal;
+  depth_ = std::max<T>(face.distance, 0);
+}
+
+template <class T, int D>
+template <class U>
+inline typename GJK<T, D>::Face GJK<T, D>::makeFace(
+    int i, int j, int k, const Point& center) const {
+  Face face{i, j, k, Point(), T()};
+  const auto& a = polytope_[i].point;
+  face.normal = (polytope_[j].point - a).cross(polytope_[k].point - a);
+  face.normal.normalize();
+  if (face.normal.dot(a - center) < 0) {
+    std::swap(face.j, face.k);
+    face.normal = -face.normal;
+  }
+  face.distance = face.normal.dot(a);
+  return face;
+}
+
+template <class T, int D>
+inline void GJK<T, D>::addEdge(int i, int j) {
+  for (auto itr = edges_.begin(); itr != edges_.end(); ++itr) {
+    if (itr->first == j && itr->second == i) {
+      edges_.erase(itr);
+      return;
+    }
+  }
+  edges_.emplace_back(i, j);
+}
+
+}  // namespace math
+
+using math::GJK;
+using math::GJK2f;
+using math::GJK2d;
+using math::GJK3f;
+using math::GJK3d;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_GJK_H_
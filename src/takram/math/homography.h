@@ -0,0 +1,358 @@
+//
+//  takram/math/homography.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_HOMOGRAPHY_H_
+#define TAKRAM_MATH_HOMOGRAPHY_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "takram/math/matrix.h"
+#include "takram/math/promotion.h"
+#include "takram/math/random.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/size.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Estimates the homography that maps the source points to the destination
+// points in the least-squares sense by the direct linear transform, after
+// normalizing both sets to their centroids and a mean distance of sqrt(2) as
+// Hartley suggests. At least four correspondences are required.
+template <class InputIterator1, class InputIterator2, class T>
+bool estimateHomography(InputIterator1 first1,
+                        InputIterator1 last1,
+                        InputIterator2 first2,
+                        Mat3<T> *result);
+
+// Robust estimation by RANSAC over minimal samples of four correspondences,
+// followed by the direct linear transform over the inliers, whose reprojection
+// errors are within the threshold. Sampling stops early once the inliers found
+// so far give 99% confidence. Returns the number of inliers.
+template <class RandomAccessIterator1, class RandomAccessIterator2, class T,
+          class Engine>
+std::size_t estimateHomography(RandomAccessIterator1 first1,
+                               RandomAccessIterator1 last1,
+                               RandomAccessIterator2 first2,
+                               T threshold,
+                               int iterations,
+                               Random<Engine> *random,
+                               Mat3<T> *result);
+
+// Applies the homography to points.
+template <class T, class U>
+Vec2<Promote<T, U>> warp(const Mat3<T>& homography, const Vec2<U>& point);
+template <class T, class InputIterator, class OutputIterator>
+OutputIterator warp(const Mat3<T>& homography,
+                    InputIterator first,
+                    InputIterator last,
+                    OutputIterator result);
+
+// Applies the homography to the centers of the cells of a grid over the
+// rectangle, row by row. Rows share their terms in y, which leaves two
+// multiplications and one division per point. Passing an inverse homography
+// gives the source coordinates to sample for every destination pixel.
+template <class T, class U, class OutputIterator>
+OutputIterator warp(const Mat3<T>& homography,
+                    const Rect2<U>& rect,
+                    const Size2i& size,
+                    OutputIterator result);
+
+#pragma mark -
+
+namespace homography {
+
+// Similarity that moves the centroid of the points to the origin and scales
+// their mean distance to sqrt(2)
+template <class T, class InputIterator>
+inline Mat3<T> normalize(InputIterator first, InputIterator last) {
+  Vec2<T> centroid;
+  std::size_t count{};
+  for (auto itr = first; itr != last; ++itr, ++count) {
+    centroid += Vec2<T>(*itr);
+  }
+  centroid /= count;
+  T distance{};
+  for (auto itr = first; itr != last; ++itr) {
+    distance += (Vec2<T>(*itr) - centroid).magnitude();
+  }
+  const T scale = distance ? std::sqrt(T(2)) * count / distance : T(1);
+  return Mat3<T>({
+    scale, 0, -scale * centroid.x,
+    0, scale, -scale * centroid.y,
+    0, 0, 1
+  });
+}
+
+// Solves the normal equations of the direct linear transform with the last
+// element of the homography fixed to one, which normalization keeps away from
+// zero.
+template <class T>
+inline bool solve(const std::vector<std::pair<Vec2<T>, Vec2<T>>>& pairs,
+                  Mat3<T> *result) {
+  T system[8][9] = {};
+  for (const auto& pair : pairs) {
+    const T x = pair.first.x;
+    const T y = pair.first.y;
+    const T u = pair.second.x;
+    const T v = pair.second.y;
+    const T rows[2][9] = {
+      {x, y, 1, 0, 0, 0, -u * x, -u * y, u},
+      {0, 0, 0, x, y, 1, -v * x, -v * y, v}
+    };
+    for (const auto& row : rows) {
+      for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 9; ++j) {
+          system[i][j] += row[i] * row[j];
+        }
+      }
+    }
+  }
+  for (int i = 0; i < 8; ++i) {
+    int pivot = i;
+    for (int j = i + 1; j < 8; ++j) {
+      if (std::abs(system[j][i]) > std::abs(system[pivot][i])) {
+        pivot = j;
+      }
+    }
+    if (std::abs(system[pivot][i]) <=
+        std::numeric_limits<T>::epsilon() * pairs.size()) {
+      return false;
+    }
+    std::swap(system[i], system[pivot]);
+    for (int j = 0; j < 8; ++j) {
+      if (j != i) {
+        const T factor = system[j][i] / system[i][i];
+        for (int k = i; k < 9; ++k) {
+          system[j][k] -= factor * system[i][k];
+        }
+      }
+    }
+  }
+  for (int i = 0; i < 8; ++i) {
+    (*result)(i / 3, i % 3) = system[i][8] / system[i][i];
+  }
+  (*result)(2, 2) = 1;
+  return true;
+}
+
+template <class T>
+inline bool estimate(const std::vector<std::pair<Vec2<T>, Vec2<T>>>& pairs,
+                     Mat3<T> *result) {
+  if (pairs.size() < 4) {
+    return false;
+  }
+  std::vector<Vec2<T>> points(pairs.size());
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    points[i] = pairs[i].first;
+  }
+  const Mat3<T> source = normalize<T>(points.begin(), points.end());
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    points[i] = pairs[i].second;
+  }
+  const Mat3<T> destination = normalize<T>(points.begin(), points.end());
+  std::vector<std::pair<Vec2<T>, Vec2<T>>> normalized(pairs.size());
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    normalized[i].first = warp(source, pairs[i].first);
+    normalized[i].second = warp(destination, pairs[i].second);
+  }
+  Mat3<T> homography;
+  if (!solve(normalized, &homography)) {
+    return false;
+  }
+  homography = destination.inverted() * homography * source;
+  if (!homography(2, 2)) {
+    return false;
+  }
+  *result = homography / homography(2, 2);
+  return true;
+}
+
+}  // namespace homography
+
+template <class InputIterator1, class InputIterator2, class T>
+inline bool estimateHomography(InputIterator1 first1,
+                               InputIterator1 last1,
+                               InputIterator2 first2,
+                               Mat3<T> *result) {
+  std::vector<std::pair<Vec2<T>, Vec2<T>>> pairs;
+  for (; first1 != last1; ++first1, ++first2) {
+    pairs.emplace_back(*first1, *first2);
+  }
+  return homography::estimate(pairs, result);
+}
+
+template <class RandomAccessIterator1, class RandomAccessIterator2, class T,
+          class Engine>
+inline std::size_t estimateHomography(RandomAccessIterator1 first1,
+                                      RandomAccessIterator1 last1,
+                                      RandomAccessIterator2 first2,
+                                      T threshold,
+                                      int iterations,
+                                      Random<Engine> *random,
+                                      Mat3<T> *result) {
+  const std::size_t size = std::distance(first1, last1);
+  if (size < 4) {
+    return 0;
+  }
+  const T threshold_squared = threshold * threshold;
+  std::vector<std::pair<Vec2<T>, Vec2<T>>> pairs(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    pairs[i].first = first1[i];
+    pairs[i].second = first2[i];
+  }
+  const auto count = [&pairs, threshold_squared](const Mat3<T>& homography) {
+    std::size_t inliers{};
+    for (const auto& pair : pairs) {
+      const auto point = warp(homography, pair.first);
+      inliers += point.distanceSquared(pair.second) <= threshold_squared;
+    }
+    return inliers;
+  };
+  Mat3<T> best;
+  std::size_t best_inliers{};
+  std::vector<std::pair<Vec2<T>, Vec2<T>>> sample(4);
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    std::size_t indices[4];
+    for (int i = 0; i < 4; ++i) {
+      bool duplicate;
+      do {
+        indices[i] = random->template uniform<std::size_t>(size - 1);
+        duplicate = std::find(indices, indices + i, indices[i]) !=
+                    indices + i;
+      } while (duplicate);
+      sample[i] = pairs[indices[i]];
+    }
+    // Reject samples with three collinear source points
+    bool degenerate = false;
+    for (int i = 0; i < 4 && !degenerate; ++i) {
+      const auto& a = sample[(i + 1) % 4].first;
+      const auto& b = sample[(i + 2) % 4].first;
+      const auto& c = sample[(i + 3) % 4].first;
+      degenerate = std::abs((b - a).cross(c - a)) <=
+                   std::numeric_limits<T>::epsilon() * (b - a).magnitude() *
+                   (c - a).magnitude();
+    }
+    Mat3<T> candidate;
+    if (degenerate || !homography::estimate(sample, &candidate)) {
+      continue;
+    }
+    const std::size_t inliers = count(candidate);
+    if (inliers > best_inliers) {
+      best = candidate;
+      best_inliers = inliers;
+      const T ratio = T(inliers) / size;
+      const T failure = 1 - ratio * ratio * ratio * ratio;
+      if (failure <= 0 ||
+          iteration + 1 >= std::log(T(0.01)) / std::log(failure)) {
+        break;
+      }
+    }
+  }
+  if (best_inliers < 4) {
+    return 0;
+  }
+  // Refine over the inliers
+  std::vector<std::pair<Vec2<T>, Vec2<T>>> inliers;
+  for (const auto& pair : pairs) {
+    if (warp(best, pair.first).distanceSquared(pair.second) <=
+        threshold_squared) {
+      inliers.push_back(pair);
+    }
+  }
+  Mat3<T> refined;
+  if (homography::estimate(inliers, &refined) &&
+      count(refined) >= best_inliers) {
+    best = refined;
+  }
+  *result = best;
+  return count(best);
+}
+
+template <class T, class U>
+inline Vec2<Promote<T, U>> warp(const Mat3<T>& homography,
+                                const Vec2<U>& point) {
+  using R = Promote<T, U>;
+  const auto& h = homography;
+  const R x = h(0, 0) * point.x + h(0, 1) * point.y + h(0, 2);
+  const R y = h(1, 0) * point.x + h(1, 1) * point.y + h(1, 2);
+  const R w = h(2, 0) * point.x + h(2, 1) * point.y + h(2, 2);
+  return Vec2<R>(x / w, y / w);
+}
+
+template <class T, class InputIterator, class OutputIterator>
+inline OutputIterator warp(const Mat3<T>& homography,
+                           InputIterator first,
+                           InputIterator last,
+                           OutputIterator result) {
+  for (; first != last; ++first, ++result) {
+    *result = warp(homography, *first);
+  }
+  return result;
+}
+
+template <class T, class U, class OutputIterator>
+inline OutputIterator warp(const Mat3<T>& homography,
+                           const Rect2<U>& rect,
+                           const Size2i& size,
+                           OutputIterator result) {
+  using R = Promote<T, U>;
+  const auto& h = homography;
+  const R dx = static_cast<R>(rect.width) / size.width;
+  const R dy = static_cast<R>(rect.height) / size.height;
+  const R x0 = rect.x + dx / 2;
+  // Terms in x along a row
+  const Vec3<R> step(h(0, 0) * dx, h(1, 0) * dx, h(2, 0) * dx);
+  for (int j = 0; j < size.height; ++j) {
+    const R y = rect.y + dy * (j + R(0.5));
+    const Vec3<R> start(h(0, 0) * x0 + h(0, 1) * y + h(0, 2),
+                        h(1, 0) * x0 + h(1, 1) * y + h(1, 2),
+                        h(2, 0) * x0 + h(2, 1) * y + h(2, 2));
+    for (int i = 0; i < size.width; ++i, ++result) {
+      const R w = start.z + step.z * i;
+      *result = Vec2<R>((start.x + step.x * i) / w,
+                        (start.y + step.y * i) / w);
+    }
+  }
+  return result;
+}
+
+}  // namespace math
+
+using math::estimateHomography;
+using math::warp;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_HOMOGRAPHY_H_
@@ -0,0 +1,392 @@
+//
+//  takram/math/icp.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_ICP_H_
+#define TAKRAM_MATH_ICP_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "takram/math/decomposition.h"
+#include "takram/math/kd_tree.h"
+#include "takram/math/matrix.h"
+#include "takram/math/promotion.h"
+#include "takram/math/random.h"
+#include "takram/math/statistics.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+enum class ICPMetric : int {
+  POINT_TO_POINT = 0,
+  POINT_TO_PLANE = 1
+};
+
+// Iterative closest point registration of a source point cloud to a target.
+// Correspondences are the nearest target points found in a k-d tree, and each
+// iteration solves the rigid transform in closed form: by SVD of the cross
+// covariance for point-to-point, and by the linearized normal equations of
+// Chen and Medioni for point-to-plane. Alignment starts from the last result,
+// so successive frames of a moving sensor converge in a few iterations; call
+// reset() to start from the identity.
+template <class T>
+class ICP final {
+ public:
+  using Type = T;
+
+ public:
+  ICP();
+
+  // Copy semantics
+  ICP(const ICP&) = default;
+  ICP& operator=(const ICP&) = default;
+
+  // Parameters
+  ICPMetric metric() const { return metric_; }
+  void setMetric(ICPMetric value) { metric_ = value; }
+  int maxIterations() const { return max_iterations_; }
+  void setMaxIterations(int value) { max_iterations_ = value; }
+  T tolerance() const { return tolerance_; }
+  void setTolerance(T value) { tolerance_ = value; }
+  T maxDistance() const { return max_distance_; }
+  void setMaxDistance(T value) { max_distance_ = value; }
+  std::size_t samples() const { return samples_; }
+  void setSamples(std::size_t value) { samples_ = value; }
+  Random<>& random() { return random_; }
+
+  // Target. Normals are estimated from the nearest neighbors of each point
+  // when not given and the metric needs them.
+  template <class InputIterator>
+  void setTarget(InputIterator first, InputIterator last);
+  template <class InputIterator, class NormalIterator>
+  void setTarget(InputIterator first,
+                 InputIterator last,
+                 NormalIterator normals);
+
+  // Alignment of the source, which is subsampled to the given number of
+  // points every iteration when it is not zero.
+  template <class RandomAccessIterator>
+  bool align(RandomAccessIterator first, RandomAccessIterator last);
+  void reset();
+
+  // Results
+  const Mat3<T>& rotation() const { return rotation_; }
+  const Vec3<T>& translation() const { return translation_; }
+  Mat4<T> transform() const;
+  T error() const { return error_; }
+  int iterations() const { return iterations_; }
+  std::size_t correspondences() const { return correspondences_; }
+
+ private:
+  void estimateNormals();
+  bool solvePointToPoint(Mat3<T> *rotation, Vec3<T> *translation) const;
+  bool solvePointToPlane(Mat3<T> *rotation, Vec3<T> *translation) const;
+
+ private:
+  struct Correspondence {
+    Vec3<T> source;
+    Vec3<T> target;
+    Vec3<T> normal;
+  };
+
+  ICPMetric metric_;
+  int max_iterations_;
+  T tolerance_;
+  T max_distance_;
+  std::size_t samples_;
+  Random<> random_;
+  KDTree3<T> tree_;
+  std::vector<Vec3<T>> target_;
+  std::vector<Vec3<T>> normals_;
+  std::vector<Correspondence> pairs_;
+  Mat3<T> rotation_;
+  Vec3<T> translation_;
+  T error_;
+  int iterations_;
+  std::size_t correspondences_;
+};
+
+using ICPf = ICP<float>;
+using ICPd = ICP<double>;
+
+#pragma mark -
+
+template <class T>
+inline ICP<T>::ICP()
+    : metric_(ICPMetric::POINT_TO_POINT),
+      max_iterations_(30),
+      tolerance_(1e-5),
+      max_distance_(std::numeric_limits<T>::infinity()),
+      samples_(),
+      random_(),
+      rotation_(Mat3<T>::identity()),
+      translation_(),
+      error_(),
+      iterations_(),
+      correspondences_() {}
+
+#pragma mark Target
+
+template <class T>
+template <class InputIterator>
+inline void ICP<T>::setTarget(InputIterator first, InputIterator last) {
+  target_.assign(first, last);
+  tree_.build(target_.begin(), target_.end());
+  normals_.clear();
+}
+
+template <class T>
+template <class InputIterator, class NormalIterator>
+inline void ICP<T>::setTarget(InputIterator first,
+                              InputIterator last,
+                              NormalIterator normals) {
+  setTarget(first, last);
+  normals_.resize(target_.size());
+  std::copy_n(normals, normals_.size(), normals_.begin());
+}
+
+template <class T>
+inline void ICP<T>::estimateNormals() {
+  std::vector<std::size_t> neighbors;
+  normals_.resize(target_.size());
+  for (std::size_t i = 0; i < target_.size(); ++i) {
+    neighbors.clear();
+    tree_.nearest(target_[i], 8, std::back_inserter(neighbors));
+    PointStatistics3<T> statistics;
+    for (const auto neighbor : neighbors) {
+      statistics.add(target_[neighbor]);
+    }
+    Mat3<T> axes;
+    statistics.principalComponents(nullptr, &axes);
+    normals_[i] = axes.column(2);
+  }
+}
+
+#pragma mark Alignment
+
+template <class T>
+template <class RandomAccessIterator>
+inline bool ICP<T>::align(RandomAccessIterator first,
+                          RandomAccessIterator last) {
+  const std::size_t size = std::distance(first, last);
+  const bool plane = metric_ == ICPMetric::POINT_TO_PLANE;
+  if (plane && normals_.size() != target_.size()) {
+    estimateNormals();
+  }
+  const std::size_t count = samples_ && samples_ < size ? samples_ : size;
+  iterations_ = 0;
+  correspondences_ = 0;
+  error_ = T();
+  pairs_.clear();
+  pairs_.reserve(count);
+  while (iterations_ < max_iterations_) {
+    ++iterations_;
+    pairs_.clear();
+    T error{};
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::size_t index = (count < size ?
+          random_.template uniform<std::size_t>(size - 1) : i);
+      const Vec3<T> source = rotation_ * Vec3<T>(first[index]) + translation_;
+      const std::size_t nearest = tree_.nearest(source, max_distance_);
+      if (nearest == tree_.size()) {
+        continue;
+      }
+      const auto& target = target_[nearest];
+      const Vec3<T> normal = plane ? normals_[nearest] : Vec3<T>();
+      const T residual = (plane ? (target - source).dot(normal) :
+                                  (target - source).magnitude());
+      error += residual * residual;
+      pairs_.push_back({source, target, normal});
+    }
+    correspondences_ = pairs_.size();
+    if (pairs_.size() < (plane ? 6 : 3)) {
+      return false;
+    }
+    error_ = std::sqrt(error / pairs_.size());
+    Mat3<T> rotation;
+    Vec3<T> translation;
+    if (!(plane ? solvePointToPlane(&rotation, &translation) :
+                  solvePointToPoint(&rotation, &translation))) {
+      return false;
+    }
+    rotation_ = rotation * rotation_;
+    translation_ = rotation * translation_ + translation;
+    // Stop when both the angle and the translation of the increment fall
+    // within the tolerance.
+    const T cosine = (rotation.trace() - 1) / 2;
+    const T angle = std::acos(std::max(T(-1), std::min(cosine, T(1))));
+    if (angle <= tolerance_ && translation.magnitude() <= tolerance_) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class T>
+inline void ICP<T>::reset() {
+  rotation_ = Mat3<T>::identity();
+  translation_ = Vec3<T>();
+  error_ = T();
+  iterations_ = 0;
+  correspondences_ = 0;
+}
+
+template <class T>
+inline bool ICP<T>::solvePointToPoint(Mat3<T> *rotation,
+                                      Vec3<T> *translation) const {
+  // Kabsch: the rotation is V * transpose(U) for the SVD of the cross
+  // covariance, where the signed smallest singular value excludes reflections.
+  PointStatistics3<T> source;
+  PointStatistics3<T> target;
+  for (const auto& pair : pairs_) {
+    source.add(pair.source);
+    target.add(pair.target);
+  }
+  Mat3<T> covariance;
+  for (const auto& pair : pairs_) {
+    covariance += Mat3<T>::outer(pair.source - source.mean(),
+                                 pair.target - target.mean());
+  }
+  Mat3<T> u;
+  Mat3<T> v;
+  decomposeSingular(covariance, &u, nullptr, &v);
+  *rotation = v * u.transposed();
+  *translation = target.mean() - *rotation * source.mean();
+  return true;
+}
+
+template <class T>
+inline bool ICP<T>::solvePointToPlane(Mat3<T> *rotation,
+                                      Vec3<T> *translation) const {
+  // Least squares of small rotation angles and translation, minimizing the
+  // distances along target normals, by Gaussian elimination.
+  T system[6][7] = {};
+  for (const auto& pair : pairs_) {
+    const Vec3<T> c = pair.source.cross(pair.normal);
+    const T row[6] = {
+      c.x, c.y, c.z, pair.normal.x, pair.normal.y, pair.normal.z
+    };
+    const T residual = (pair.target - pair.source).dot(pair.normal);
+    for (int i = 0; i < 6; ++i) {
+      for (int j = 0; j < 6; ++j) {
+        system[i][j] += row[i] * row[j];
+      }
+      system[i][6] += row[i] * residual;
+    }
+  }
+  for (int i = 0; i < 6; ++i) {
+    int pivot = i;
+    for (int j = i + 1; j < 6; ++j) {
+      if (std::abs(system[j][i]) > std::abs(system[pivot][i])) {
+        pivot = j;
+      }
+    }
+    if (!system[pivot][i]) {
+      return false;
+    }
+    std::swap(system[i], system[pivot]);
+    for (int j = 0; j < 6; ++j) {
+      if (j != i) {
+        const T factor = system[j][i] / system[i][i];
+        for (int k = i; k < 7; ++k) {
+          system[j][k] -= factor * system[i][k];
+        }
+      }
+    }
+  }
+  T x[6];
+  for (int i = 0; i < 6; ++i) {
+    x[i] = system[i][6] / system[i][i];
+  }
+  const T cx = std::cos(x[0]);
+  const T sx = std::sin(x[0]);
+  const T cy = std::cos(x[1]);
+  const T sy = std::sin(x[1]);
+  const T cz = std::cos(x[2]);
+  const T sz = std::sin(x[2]);
+  *rotation = (Mat3<T>({cz, -sz, 0, sz, cz, 0, 0, 0, 1}) *
+               Mat3<T>({cy, 0, sy, 0, 1, 0, -sy, 0, cy}) *
+               Mat3<T>({1, 0, 0, 0, cx, -sx, 0, sx, cx}));
+  translation->set(x[3], x[4], x[5]);
+  return true;
+}
+
+#pragma mark Results
+
+template <class T>
+inline Mat4<T> ICP<T>::transform() const {
+  const auto& r = rotation_;
+  const auto& t = translation_;
+  return Mat4<T>({
+    r(0, 0), r(0, 1), r(0, 2), t.x,
+    r(1, 0), r(1, 1), r(1, 2), t.y,
+    r(2, 0), r(2, 1), r(2, 2), t.z,
+    0, 0, 0, 1
+  });
+}
+
+#pragma mark Stream
+
+inline std::ostream& operator<<(std::ostream& os, ICPMetric metric) {
+  switch (metric) {
+    case ICPMetric::POINT_TO_POINT: os << "point to point"; break;
+    case ICPMetric::POINT_TO_PLANE: os << "point to plane"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+}  // namespace math
+
+using math::ICPMetric;
+using math::ICP;
+using math::ICPf;
+using math::ICPd;
+
+}  // namespace takram
+
+template <>
+struct std::hash<takram::math::ICPMetric> {
+  std::size_t operator()(const takram::math::ICPMetric& value) const {
+    return static_cast<std::underlying_type<
+        takram::math::ICPMetric>::type>(value);
+  }
+};
+
+#endif  // TAKRAM_MATH_ICP_H_
@@ -0,0 +1,953 @@
+//
+//  takram/math/kd_tree.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_KD_TREE_H_
+#define TAKRAM_MATH_KD_TREE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "takram/math/promotion.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+namespace kd_tree {
+
+// Axis of the nodes whose ranges are not split yet
+constexpr const int unsplit = UINT8_MAX;
+
+// Non-owning view of the node arrays, through which KDTree and KDTreeView
+// share their queries. The ranges of unsplit nodes are scanned over the
+// points in source, which are in the order of the input.
+template <class T, int D, class Index>
+class Nodes final {
+ public:
+  template <class U>
+  std::size_t nearest(const Vec<U, D>& point, Promote<T> radius) const;
+  template <class U, class OutputIterator>
+  OutputIterator nearest(const Vec<U, D>& point,
+                         std::size_t count,
+                         OutputIterator result) const;
+  template <class U, class OutputIterator>
+  OutputIterator within(const Vec<U, D>& point,
+                        Promote<T> radius,
+                        OutputIterator result) const;
+
+ public:
+  const Vec<T, D> *points;
+  const Index *indices;
+  const std::uint8_t *axes;
+  const Vec<T, D> *source;
+  std::size_t size;
+
+ private:
+  using R = Promote<T>;
+  using Neighbor = std::pair<R, std::size_t>;
+
+  template <class U>
+  void searchNearest(std::size_t first,
+                     std::size_t last,
+                     const Vec<U, D>& point,
+                     std::size_t *index,
+                     R *distance) const;
+  template <class U>
+  void searchNearest(std::size_t first,
+                     std::size_t last,
+                     const Vec<U, D>& point,
+                     std::size_t count,
+                     std::vector<Neighbor> *heap) const;
+  template <class U, class OutputIterator>
+  void searchWithin(std::size_t first,
+                    std::size_t last,
+                    const Vec<U, D>& point,
+                    R radius,
+                    OutputIterator *result) const;
+  template <class U>
+  void scanNearest(std::size_t first,
+                   std::size_t last,
+                   const Vec<U, D>& point,
+                   std::size_t *index,
+                   R *distance) const;
+  template <class U>
+  void scanNearest(std::size_t first,
+                   std::size_t last,
+                   const Vec<U, D>& point,
+                   std::size_t count,
+                   std::vector<Neighbor> *heap) const;
+  template <class U, class OutputIterator>
+  void scanWithin(std::size_t first,
+                  std::size_t last,
+                  const Vec<U, D>& point,
+                  R radius,
+                  OutputIterator *result) const;
+};
+
+// A snapshot is this header followed by the node points, the indices into the
+// input as 64-bit integers and the node axes. The arrays are addressed by
+// their offsets from the start of the snapshot, and aligned to 8 bytes so
+// that they can be read in place. The checksum is the 64-bit FNV-1a hash of
+// the bytes after the header.
+struct SnapshotHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t scalar;
+  std::uint32_t dimensions;
+  std::uint64_t size;
+  std::uint64_t points;
+  std::uint64_t indices;
+  std::uint64_t axes;
+  std::uint64_t length;
+  std::uint64_t checksum;
+};
+
+constexpr const char snapshotMagic[8] = {
+  'T', 'K', 'M', 'K', 'D', 'T', 'R', 'E'
+};
+constexpr const std::uint32_t snapshotVersion = 2;
+constexpr const std::uint32_t snapshotByteOrder = 0x01020304;
+constexpr const std::size_t snapshotAlignment = 8;
+constexpr const std::uint64_t checksumBasis = 0xcbf29ce484222325;
+
+template <class T, int D>
+SnapshotHeader snapshotHeader(std::size_t size);
+std::uint64_t checksum(const void *data,
+                       std::size_t size,
+                       std::uint64_t value = checksumBasis);
+
+}  // namespace kd_tree
+
+// Balanced k-d tree over points, laid out implicitly: the median of every
+// index range is the node of that range, and the ranges before and after it
+// are its children. Nodes refer to each other only by position, so the arrays
+// can be copied or moved freely. Queries do not modify the tree and can run
+// concurrently.
+//
+// The tree can also be built over several calls, for example one per frame.
+// Ranges are split breadth-first, and queries scan the ranges that are not
+// split yet, so a partially built tree gives the same answers as a complete
+// one up to ties between equidistant points, only more slowly.
+template <class T, int D>
+class KDTree final {
+ public:
+  using Type = T;
+  using Point = Vec<T, D>;
+  static constexpr const int dimensions = D;
+
+ public:
+  KDTree() = default;
+  template <class InputIterator>
+  KDTree(InputIterator first, InputIterator last);
+
+  // Copy semantics
+  KDTree(const KDTree&) = default;
+  KDTree& operator=(const KDTree&) = default;
+
+  // Construction
+  template <class InputIterator>
+  void build(InputIterator first, InputIterator last);
+  void reset();
+
+  // Incremental construction. beginBuild() copies the points without
+  // splitting, and continueBuild() splits pending ranges until the budget is
+  // spent, returning true once the tree is complete. Work is counted in points
+  // scanned or partitioned, and the range being split is suspended where the
+  // budget runs out, so a call never exceeds it. The actual work is stored in
+  // done if it is not null. A duration is checked every block of work.
+  template <class InputIterator>
+  void beginBuild(InputIterator first, InputIterator last);
+  bool continueBuild(std::size_t work, std::size_t *done = nullptr);
+  template <class Rep, class Period>
+  bool continueBuild(const std::chrono::duration<Rep, Period>& duration);
+
+  // Snapshot of the complete tree as bytes that KDTreeView queries in place,
+  // typically written to a file that is later mapped into memory. Nothing is
+  // written while the tree is incomplete, and the result is returned as is.
+  std::size_t snapshotSize() const;
+  template <class OutputIterator>
+  OutputIterator writeSnapshot(OutputIterator result) const;
+
+  // Attributes
+  bool empty() const { return points_.empty(); }
+  std::size_t size() const { return points_.size(); }
+  bool complete() const { return pending_.empty() && !splitting(); }
+
+  // Queries return indices into the range the tree was built from. nearest()
+  // returns size() when no point lies within the radius.
+  template <class U>
+  std::size_t nearest(
+      const Vec<U, D>& point,
+      Promote<T> radius = std::numeric_limits<Promote<T>>::infinity()) const;
+  template <class U, class OutputIterator>
+  OutputIterator nearest(const Vec<U, D>& point,
+                         std::size_t count,
+                         OutputIterator result) const;
+  template <class U, class OutputIterator>
+  OutputIterator within(const Vec<U, D>& point,
+                        Promote<T> radius,
+                        OutputIterator result) const;
+
+ private:
+  using Range = std::pair<std::size_t, std::size_t>;
+
+  // State of the range being split, which finds the extents of its points
+  // first and then selects its median by partitioning a window around it
+  // into points less than, equal to and greater than a pivot. The window is
+  // [lower, upper), and the points in [cursor, greater) are yet to be
+  // compared with the pivot.
+  struct Split {
+    std::size_t first;
+    std::size_t last;
+    std::size_t cursor;
+    Point min;
+    Point max;
+    int axis;
+    bool selecting;
+    std::size_t lower;
+    std::size_t upper;
+    std::size_t less;
+    std::size_t greater;
+    T pivot;
+  };
+
+  static constexpr const std::size_t block_size = 1024;
+
+  bool splitting() const { return split_.first != split_.last; }
+  void beginSplit(const Range& range);
+  std::size_t continueSplit(std::size_t work);
+  void beginPartition();
+  void endSplit();
+  template <class Function>
+  void visitSnapshot(const kd_tree::SnapshotHeader& header,
+                     Function function) const;
+  kd_tree::Nodes<T, D, std::size_t> nodes() const;
+
+ private:
+  std::vector<Point> points_;
+  std::vector<std::size_t> indices_;
+  std::vector<std::uint8_t> axes_;
+  std::vector<Point> source_;
+  std::deque<Range> pending_;
+  Split split_{};
+};
+
+// Read-only k-d tree over a snapshot written by KDTree::writeSnapshot(),
+// which it queries in place without copying. The snapshot must be aligned to
+// 8 bytes and outlive the view, so points aligned beyond that, such as those
+// of long double, cannot be snapshotted.
+template <class T, int D>
+class KDTreeView final {
+ public:
+  using Type = T;
+  using Point = Vec<T, D>;
+  static constexpr const int dimensions = D;
+
+ public:
+  KDTreeView() = default;
+  KDTreeView(const void *data, std::size_t size, bool verify = false);
+
+  // Copy semantics
+  KDTreeView(const KDTreeView&) = default;
+  KDTreeView& operator=(const KDTreeView&) = default;
+
+  // Opening returns false and leaves the view empty if the data is not a
+  // snapshot of a complete tree of this type, or if verify is true and the
+  // checksum does not match. The axes and indices are always checked so that
+  // queries stay in bounds, but without verification the points are trusted.
+  bool open(const void *data, std::size_t size, bool verify = false);
+  void reset();
+
+  // Attributes
+  bool empty() const { return !nodes_.size; }
+  std::size_t size() const { return nodes_.size; }
+
+  // Queries behave as those of KDTree
+  template <class U>
+  std::size_t nearest(
+      const Vec<U, D>& point,
+      Promote<T> radius = std::numeric_limits<Promote<T>>::infinity()) const;
+  template <class U, class OutputIterator>
+  OutputIterator nearest(const Vec<U, D>& point,
+                         std::size_t count,
+                         OutputIterator result) const;
+  template <class U, class OutputIterator>
+  OutputIterator within(const Vec<U, D>& point,
+                        Promote<T> radius,
+                        OutputIterator result) const;
+
+ private:
+  kd_tree::Nodes<T, D, std::uint64_t> nodes_{};
+};
+
+template <class T>
+using KDTree2 = KDTree<T, 2>;
+template <class T>
+using KDTree3 = KDTree<T, 3>;
+template <class T>
+using KDTreeView2 = KDTreeView<T, 2>;
+template <class T>
+using KDTreeView3 = KDTreeView<T, 3>;
+
+using KDTree2f = KDTree2<float>;
+using KDTree2d = KDTree2<double>;
+using KDTree3f = KDTree3<float>;
+using KDTree3d = KDTree3<double>;
+using KDTreeView2f = KDTreeView2<float>;
+using KDTreeView2d = KDTreeView2<double>;
+using KDTreeView3f = KDTreeView3<float>;
+using KDTreeView3d = KDTreeView3<double>;
+
+#pragma mark -
+
+template <class T, int D>
+template <class InputIterator>
+inline KDTree<T, D>::KDTree(InputIterator first, InputIterator last) {
+  build(first, last);
+}
+
+#pragma mark Construction
+
+template <class T, int D>
+template <class InputIterator>
+inline void KDTree<T, D>::build(InputIterator first, InputIterator last) {
+  beginBuild(first, last);
+  // Split depth-first, which keeps the pending ranges few and the ranges
+  // being partitioned close together in memory.
+  while (!pending_.empty()) {
+    const auto range = pending_.back();
+    pending_.pop_back();
+    beginSplit(range);
+    continueSplit(std::numeric_limits<std::size_t>::max());
+  }
+}
+
+template <class T, int D>
+inline void KDTree<T, D>::reset() {
+  points_.clear();
+  indices_.clear();
+  axes_.clear();
+  source_.clear();
+  pending_.clear();
+  split_ = Split{};
+}
+
+#pragma mark Incremental construction
+
+template <class T, int D>
+template <class InputIterator>
+inline void KDTree<T, D>::beginBuild(InputIterator first,
+                                     InputIterator last) {
+  source_.assign(first, last);
+  points_.resize(source_.size());
+  indices_.resize(source_.size());
+  for (std::size_t i = 0; i < indices_.size(); ++i) {
+    indices_[i] = i;
+  }
+  axes_.assign(source_.size(), kd_tree::unsplit);
+  pending_.clear();
+  split_ = Split{};
+  if (!source_.empty()) {
+    pending_.emplace_back(0, source_.size());
+  } else {
+    source_.shrink_to_fit();
+  }
+}
+
+template <class T, int D>
+inline bool KDTree<T, D>::continueBuild(std::size_t work, std::size_t *done) {
+  std::size_t spent = 0;
+  while (spent < work && !complete()) {
+    if (!splitting()) {
+      beginSplit(pending_.front());
+      pending_.pop_front();
+    }
+    spent += continueSplit(work - spent);
+  }
+  if (done) {
+    *done = spent;
+  }
+  return complete();
+}
+
+template <class T, int D>
+template <class Rep, class Period>
+inline bool KDTree<T, D>::continueBuild(
+    const std::chrono::duration<Rep, Period>& duration) {
+  using Clock = std::chrono::steady_clock;
+  const auto deadline = Clock::now() + duration;
+  while (!continueBuild(block_size) && Clock::now() < deadline) {}
+  return complete();
+}
+
+template <class T, int D>
+inline void KDTree<T, D>::beginSplit(const Range& range) {
+  assert(!splitting() && range.first < range.second);
+  split_.first = range.first;
+  split_.last = range.second;
+  split_.cursor = range.first;
+  split_.min = split_.max = source_[indices_[range.first]];
+  split_.selecting = false;
+}
+
+template <class T, int D>
+inline std::size_t KDTree<T, D>::continueSplit(std::size_t work) {
+  const std::size_t middle = split_.first + (split_.last - split_.first) / 2;
+  std::size_t spent = 0;
+  if (!split_.selecting) {
+    // Find the extents of the points in the range
+    for (; split_.cursor < split_.last && spent < work;
+         ++split_.cursor, ++spent) {
+      const auto& point = source_[indices_[split_.cursor]];
+      for (int axis = 0; axis < D; ++axis) {
+        split_.min[axis] = std::min(split_.min[axis], point[axis]);
+        split_.max[axis] = std::max(split_.max[axis], point[axis]);
+      }
+    }
+    if (split_.cursor < split_.last) {
+      return spent;
+    }
+    // Split along the axis of the largest extent
+    split_.axis = 0;
+    for (int i = 1; i < D; ++i) {
+      if (split_.max[i] - split_.min[i] >
+          split_.max[split_.axis] - split_.min[split_.axis]) {
+        split_.axis = i;
+      }
+    }
+    split_.selecting = true;
+    split_.lower = split_.first;
+    split_.upper = split_.last;
+    beginPartition();
+  }
+  const int axis = split_.axis;
+  while (split_.upper - split_.lower > 1 && spent < work) {
+    // Three-way partition of the window, one point at a time
+    for (; split_.cursor < split_.greater && spent < work; ++spent) {
+      const T value = source_[indices_[split_.cursor]][axis];
+      if (value < split_.pivot) {
+        std::swap(indices_[split_.less++], indices_[split_.cursor++]);
+      } else if (split_.pivot < value) {
+        std::swap(indices_[split_.cursor], indices_[--split_.greater]);
+      } else {
+        ++split_.cursor;
+      }
+    }
+    if (split_.cursor < split_.greater) {
+      return spent;
+    }
+    // Narrow the window to the side holding the median
+    if (middle < split_.less) {
+      split_.upper = split_.less;
+    } else if (middle >= split_.greater) {
+      split_.lower = split_.greater;
+    } else {
+      break;
+    }
+    beginPartition();
+  }
+  if (split_.upper - split_.lower > 1 && split_.cursor < split_.greater) {
+    return spent;
+  }
+  endSplit();
+  return spent;
+}
+
+template <class T, int D>
+inline void KDTree<T, D>::beginPartition() {
+  // Median of the first, middle and last points of the window as the pivot
+  const int axis = split_.axis;
+  const std::size_t lower = split_.lower;
+  const std::size_t upper = split_.upper;
+  T a = source_[indices_[lower]][axis];
+  T b = source_[indices_[lower + (upper - lower) / 2]][axis];
+  const T c = source_[indices_[upper - 1]][axis];
+  if (b < a) {
+    std::swap(a, b);
+  }
+  split_.pivot = c < a ? a : (b < c ? b : c);
+  split_.cursor = split_.less = lower;
+  split_.greater = upper;
+}
+
+template <class T, int D>
+inline void KDTree<T, D>::endSplit() {
+  const std::size_t first = split_.first;
+  const std::size_t last = split_.last;
+  const std::size_t middle = first + (last - first) / 2;
+  if (last - first > 1) {
+    axes_[middle] = static_cast<std::uint8_t>(split_.axis);
+    if (first < middle) {
+      pending_.emplace_back(first, middle);
+    }
+    if (middle + 1 < last) {
+      pending_.emplace_back(middle + 1, last);
+    }
+  } else {
+    axes_[middle] = 0;
+  }
+  // Store the point of the node in the order of the nodes
+  points_[middle] = source_[indices_[middle]];
+  split_ = Split{};
+  if (pending_.empty()) {
+    std::vector<Point>().swap(source_);
+  }
+}
+
+#pragma mark Snapshot
+
+template <class T, int D>
+inline std::size_t KDTree<T, D>::snapshotSize() const {
+  return kd_tree::snapshotHeader<T, D>(size()).length;
+}
+
+template <class T, int D>
+template <class OutputIterator>
+inline OutputIterator KDTree<T, D>::writeSnapshot(
+    OutputIterator result) const {
+  static_assert(alignof(Point) <= kd_tree::snapshotAlignment,
+                "Points must not be aligned beyond snapshots");
+  if (!complete()) {
+    return result;
+  }
+  auto header = kd_tree::snapshotHeader<T, D>(size());
+  header.checksum = kd_tree::checksumBasis;
+  visitSnapshot(header, [&header](const void *data, std::size_t size) {
+    header.checksum = kd_tree::checksum(data, size, header.checksum);
+  });
+  const auto write = [&result](const void *data, std::size_t size) {
+    const auto bytes = static_cast<const char *>(data);
+    result = std::copy(bytes, bytes + size, result);
+  };
+  write(&header, sizeof(header));
+  visitSnapshot(header, write);
+  return result;
+}
+
+template <class T, int D>
+template <class Function>
+inline void KDTree<T, D>::visitSnapshot(const kd_tree::SnapshotHeader& header,
+                                        Function function) const {
+  const char padding[kd_tree::snapshotAlignment] = {};
+  const std::size_t points = points_.size() * sizeof(Point);
+  function(points_.data(), points);
+  function(padding, header.indices - header.points - points);
+  for (const auto index : indices_) {
+    const std::uint64_t value = index;
+    function(&value, sizeof(value));
+  }
+  function(axes_.data(), axes_.size());
+}
+
+#pragma mark Queries
+
+template <class T, int D>
+template <class U>
+inline std::size_t KDTree<T, D>::nearest(const Vec<U, D>& point,
+                                         Promote<T> radius) const {
+  return nodes().nearest(point, radius);
+}
+
+template <class T, int D>
+template <class U, class OutputIterator>
+inline OutputIterator KDTree<T, D>::nearest(const Vec<U, D>& point,
+                                            std::size_t count,
+                                            OutputIterator result) const {
+  return nodes().nearest(point, count, result);
+}
+
+template <class T, int D>
+template <class U, class OutputIterator>
+inline OutputIterator KDTree<T, D>::within(const Vec<U, D>& point,
+                                           Promote<T> radius,
+                                           OutputIterator result) const {
+  return nodes().within(point, radius, result);
+}
+
+template <class T, int D>
+inline kd_tree::Nodes<T, D, std::size_t> KDTree<T, D>::nodes() const {
+  return {points_.data(), indices_.data(), axes_.data(), source_.data(),
+          points_.size()};
+}
+
+#pragma mark -
+
+template <class T, int D>
+inline KDTreeView<T, D>::KDTreeView(const void *data,
+                                    std::size_t size,
+                                    bool verify) {
+  open(data, size, verify);
+}
+
+template <class T, int D>
+inline bool KDTreeView<T, D>::open(const void *data,
+                                   std::size_t size,
+                                   bool verify) {
+  static_assert(std::is_trivially_copyable<Point>::value,
+                "Points must be trivially copyable");
+  static_assert(alignof(Point) <= kd_tree::snapshotAlignment,
+                "Points must not be aligned beyond snapshots");
+  reset();
+  const auto bytes = static_cast<const char *>(data);
+  kd_tree::SnapshotHeader header;
+  if (!data || size < sizeof(header) ||
+      reinterpret_cast<std::uintptr_t>(data) % kd_tree::snapshotAlignment) {
+    return false;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  // Compare the header with the one of a tree of this type and size, after
+  // making sure that the size cannot overflow the layout.
+  if (header.size > (size - sizeof(header)) / sizeof(Point)) {
+    return false;
+  }
+  const auto expected = kd_tree::snapshotHeader<T, D>(header.size);
+  if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) ||
+      header.version != expected.version ||
+      header.byte_order != expected.byte_order ||
+      header.scalar != expected.scalar ||
+      header.dimensions != expected.dimensions ||
+      header.points != expected.points ||
+      header.indices != expected.indices ||
+      header.axes != expected.axes ||
+      header.length != expected.length ||
+      header.length > size) {
+    return false;
+  }
+  if (verify) {
+    const auto checksum = kd_tree::checksum(bytes + sizeof(header),
+                                            header.length - sizeof(header));
+    if (checksum != header.checksum) {
+      return false;
+    }
+  }
+  const auto axes = reinterpret_cast<const std::uint8_t *>(
+      bytes + header.axes);
+  const auto indices = reinterpret_cast<const std::uint64_t *>(
+      bytes + header.indices);
+  for (std::uint64_t i = 0; i < header.size; ++i) {
+    if (axes[i] == kd_tree::unsplit || axes[i] >= D ||
+        indices[i] >= header.size) {
+      return false;
+    }
+  }
+  nodes_.points = reinterpret_cast<const Point *>(bytes + header.points);
+  nodes_.indices = indices;
+  nodes_.axes = axes;
+  nodes_.source = nullptr;
+  nodes_.size = static_cast<std::size_t>(header.size);
+  return true;
+}
+
+template <class T, int D>
+inline void KDTreeView<T, D>::reset() {
+  nodes_ = kd_tree::Nodes<T, D, std::uint64_t>{};
+}
+
+template <class T, int D>
+template <class U>
+inline std::size_t KDTreeView<T, D>::nearest(const Vec<U, D>& point,
+                                             Promote<T> radius) const {
+  return nodes_.nearest(point, radius);
+}
+
+template <class T, int D>
+template <class U, class OutputIterator>
+inline OutputIterator KDTreeView<T, D>::nearest(const Vec<U, D>& point,
+                                                std::size_t count,
+                                                OutputIterator result) const {
+  return nodes_.nearest(point, count, result);
+}
+
+template <class T, int D>
+template <class U, class OutputIterator>
+inline OutputIterator KDTreeView<T, D>::within(const Vec<U, D>& point,
+                                               Promote<T> radius,
+                                               OutputIterator result) const {
+  return nodes_.within(point, radius, result);
+}
+
+#pragma mark -
+
+namespace kd_tree {
+
+template <class T, int D>
+inline SnapshotHeader snapshotHeader(std::size_t size) {
+  const auto align = [](std::uint64_t offset) {
+    return (offset + snapshotAlignment - 1) / snapshotAlignment *
+           snapshotAlignment;
+  };
+  SnapshotHeader header{};
+  std::memcpy(header.magic, snapshotMagic, sizeof(header.magic));
+  header.version = snapshotVersion;
+  header.byte_order = snapshotByteOrder;
+  header.scalar = static_cast<std::uint32_t>(
+      (std::is_floating_point<T>::value << 9) |
+      (std::is_signed<T>::value << 8) | sizeof(T));
+  header.dimensions = D;
+  header.size = size;
+  header.points = align(sizeof(SnapshotHeader));
+  header.indices = align(header.points + size * sizeof(Vec<T, D>));
+  header.axes = header.indices + size * sizeof(std::uint64_t);
+  header.length = header.axes + size;
+  return header;
+}
+
+inline std::uint64_t checksum(const void *data,
+                              std::size_t size,
+                              std::uint64_t value) {
+  const auto bytes = static_cast<const unsigned char *>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    value = (value ^ bytes[i]) * 0x100000001b3;
+  }
+  return value;
+}
+
+template <class T, int D, class Index>
+template <class U>
+inline std::size_t Nodes<T, D, Index>::nearest(const Vec<U, D>& point,
+                                               Promote<T> radius) const {
+  std::size_t index = size;
+  R distance = radius * radius;
+  searchNearest(0, size, point, &index, &distance);
+  return index < size ? static_cast<std::size_t>(indices[index]) : size;
+}
+
+template <class T, int D, class Index>
+template <class U, class OutputIterator>
+inline OutputIterator Nodes<T, D, Index>::nearest(const Vec<U, D>& point,
+                                                  std::size_t count,
+                                                  OutputIterator result) const {
+  if (!count) {
+    return result;
+  }
+  std::vector<Neighbor> heap;
+  heap.reserve(std::min(count, size) + 1);
+  searchNearest(0, size, point, count, &heap);
+  std::sort_heap(heap.begin(), heap.end());
+  for (const auto& neighbor : heap) {
+    *result++ = static_cast<std::size_t>(indices[neighbor.second]);
+  }
+  return result;
+}
+
+template <class T, int D, class Index>
+template <class U, class OutputIterator>
+inline OutputIterator Nodes<T, D, Index>::within(const Vec<U, D>& point,
+                                                 Promote<T> radius,
+                                                 OutputIterator result) const {
+  searchWithin(0, size, point, radius * radius, &result);
+  return result;
+}
+
+template <class T, int D, class Index>
+template <class U>
+inline void Nodes<T, D, Index>::searchNearest(std::size_t first,
+                                              std::size_t last,
+                                              const Vec<U, D>& point,
+                                              std::size_t *index,
+                                              R *distance) const {
+  while (first < last) {
+    const std::size_t middle = first + (last - first) / 2;
+    if (axes[middle] == unsplit) {
+      scanNearest(first, last, point, index, distance);
+      return;
+    }
+    const R candidate = points[middle].distanceSquared(point);
+    if (candidate <= *distance) {
+      *distance = candidate;
+      *index = middle;
+    }
+    const int axis = axes[middle];
+    const R offset = static_cast<R>(point[axis]) - points[middle][axis];
+    // Descend into the near side first, and visit the far side only if the
+    // splitting plane is closer than the best distance so far.
+    if (offset < 0) {
+      searchNearest(first, middle, point, index, distance);
+      first = middle + 1;
+    } else {
+      searchNearest(middle + 1, last, point, index, distance);
+      last = middle;
+    }
+    if (offset * offset > *distance) {
+      return;
+    }
+  }
+}
+
+template <class T, int D, class Index>
+template <class U>
+inline void Nodes<T, D, Index>::searchNearest(
+    std::size_t first,
+    std::size_t last,
+    const Vec<U, D>& point,
+    std::size_t count,
+    std::vector<Neighbor> *heap) const {
+  if (first >= last) {
+    return;
+  }
+  const std::size_t middle = first + (last - first) / 2;
+  if (axes[middle] == unsplit) {
+    scanNearest(first, last, point, count, heap);
+    return;
+  }
+  const R distance = points[middle].distanceSquared(point);
+  if (heap->size() < count || distance < heap->front().first) {
+    heap->emplace_back(distance, middle);
+    std::push_heap(heap->begin(), heap->end());
+    if (heap->size() > count) {
+      std::pop_heap(heap->begin(), heap->end());
+      heap->pop_back();
+    }
+  }
+  const int axis = axes[middle];
+  const R offset = static_cast<R>(point[axis]) - points[middle][axis];
+  const bool before = offset < 0;
+  if (before) {
+    searchNearest(first, middle, point, count, heap);
+  } else {
+    searchNearest(middle + 1, last, point, count, heap);
+  }
+  if (heap->size() < count || offset * offset < heap->front().first) {
+    if (before) {
+      searchNearest(middle + 1, last, point, count, heap);
+    } else {
+      searchNearest(first, middle, point, count, heap);
+    }
+  }
+}
+
+template <class T, int D, class Index>
+template <class U, class OutputIterator>
+inline void Nodes<T, D, Index>::searchWithin(std::size_t first,
+                                             std::size_t last,
+                                             const Vec<U, D>& point,
+                                             R radius,
+                                             OutputIterator *result) const {
+  while (first < last) {
+    const std::size_t middle = first + (last - first) / 2;
+    if (axes[middle] == unsplit) {
+      scanWithin(first, last, point, radius, result);
+      return;
+    }
+    if (points[middle].distanceSquared(point) <= radius) {
+      *(*result)++ = static_cast<std::size_t>(indices[middle]);
+    }
+    const int axis = axes[middle];
+    const R offset = static_cast<R>(point[axis]) - points[middle][axis];
+    if (offset * offset <= radius) {
+      searchWithin(first, middle, point, radius, result);
+      first = middle + 1;
+    } else if (offset < 0) {
+      last = middle;
+    } else {
+      first = middle + 1;
+    }
+  }
+}
+
+template <class T, int D, class Index>
+template <class U>
+inline void Nodes<T, D, Index>::scanNearest(std::size_t first,
+                                            std::size_t last,
+                                            const Vec<U, D>& point,
+                                            std::size_t *index,
+                                            R *distance) const {
+  for (std::size_t i = first; i < last; ++i) {
+    const R candidate = source[indices[i]].distanceSquared(point);
+    if (candidate <= *distance) {
+      *distance = candidate;
+      *index = i;
+    }
+  }
+}
+
+template <class T, int D, class Index>
+template <class U>
+inline void Nodes<T, D, Index>::scanNearest(std::size_t first,
+                                            std::size_t last,
+                                            const Vec<U, D>& point,
+                                            std::size_t count,
+                                            std::vector<Neighbor> *heap) const {
+  for (std::size_t i = first; i < last; ++i) {
+    const R distance = source[indices[i]].distanceSquared(point);
+    if (heap->size() < count || distance < heap->front().first) {
+      heap->emplace_back(distance, i);
+      std::push_heap(heap->begin(), heap->end());
+      if (heap->size() > count) {
+        std::pop_heap(heap->begin(), heap->end());
+        heap->pop_back();
+      }
+    }
+  }
+}
+
+template <class T, int D, class Index>
+template <class U, class OutputIterator>
+inline void Nodes<T, D, Index>::scanWithin(std::size_t first,
+                                           std::size_t last,
+                                           const Vec<U, D>& point,
+                                           R radius,
+                                           OutputIterator *result) const {
+  for (std::size_t i = first; i < last; ++i) {
+    if (source[indices[i]].distanceSquared(point) <= radius) {
+      *(*result)++ = static_cast<std::size_t>(indices[i]);
+    }
+  }
+}
+
+}  // namespace kd_tree
+
+}  // namespace math
+
+using math::KDTree;
+using math::KDTree2;
+using math::KDTree3;
+using math::KDTree2f;
+using math::KDTree2d;
+using math::KDTree3f;
+using math::KDTree3d;
+using math::KDTreeView;
+using math::KDTreeView2;
+using math::KDTreeView3;
+using math::KDTreeView2f;
+using math::KDTreeView2d;
+using math::KDTreeView3f;
+using math::KDTreeView3d;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_KD_TREE_H_
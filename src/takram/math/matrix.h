@@ -0,0 +1,591 @@
+//
+//  takram/math/matrix.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_MATRIX_H_
+#define TAKRAM_MATH_MATRIX_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <utility>
+
+#include "takram/math/enablers.h"
+#include "takram/math/promotion.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Square matrix stored in row-major order, so that element (i, j) is the j-th
+// component of the i-th row, and initializer lists read as they are written.
+// Vectors are columns and are transformed by multiplying on the right.
+template <class T, int D>
+class Mat final {
+ public:
+  using Type = T;
+  using Row = Vec<T, D>;
+  using Iterator = T *;
+  using ConstIterator = const T *;
+  static constexpr const int dimensions = D;
+
+ public:
+  Mat();
+  explicit Mat(T diagonal);
+  Mat(std::initializer_list<T> list);
+  explicit Mat(const T *values);
+
+  // Implicit conversion
+  template <class U>
+  Mat(const Mat<U, D>& other);
+
+  // Copy semantics
+  Mat(const Mat&) = default;
+  Mat& operator=(const Mat&) = default;
+
+  // Factory
+  static Mat identity();
+  static Mat diagonal(const Vec<T, D>& values);
+  static Mat fromColumns(std::initializer_list<Vec<T, D>> columns);
+  template <class U>
+  static Mat outer(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+
+  // Mutators
+  void set(std::initializer_list<T> list);
+  void set(const T *values);
+  void reset();
+
+  // Element access
+  Row& operator[](int index) { return rows_[index]; }
+  const Row& operator[](int index) const { return rows_[index]; }
+  T& operator()(int row, int column) { return at(row, column); }
+  const T& operator()(int row, int column) const { return at(row, column); }
+  T& at(int row, int column);
+  const T& at(int row, int column) const;
+  const Row& row(int index) const { return rows_[index]; }
+  Vec<T, D> column(int index) const;
+  void setRow(int index, const Vec<T, D>& value) { rows_[index] = value; }
+  void setColumn(int index, const Vec<T, D>& value);
+  Vec<T, D> diagonal() const;
+
+  // Comparison
+  template <class V, class U = T>
+  bool equals(const Mat<U, D>& other, V tolerance) const;
+
+  // Arithmetic
+  Mat& operator+=(const Mat& other);
+  Mat& operator-=(const Mat& other);
+  Mat& operator*=(const Mat& other);
+  Mat& operator*=(T scalar);
+  Mat& operator/=(T scalar);
+  Mat<Promote<T>, D> operator-() const;
+
+  // Attributes
+  Promote<T> trace() const;
+  Promote<T> determinant() const;
+  bool symmetric() const;
+
+  // Transformation
+  Mat& transpose();
+  Mat<Promote<T>, D> transposed() const;
+  Mat& invert();
+  Mat<Promote<T>, D> inverted() const;
+
+  // Iterator
+  Iterator begin() { return rows_[0].begin(); }
+  ConstIterator begin() const { return rows_[0].begin(); }
+  Iterator end() { return begin() + D * D; }
+  ConstIterator end() const { return begin() + D * D; }
+
+  // Pointer
+  T * pointer() { return begin(); }
+  const T * pointer() const { return begin(); }
+
+ private:
+  Row rows_[D];
+};
+
+// Comparison
+template <class T, class U, int D>
+bool operator==(const Mat<T, D>& lhs, const Mat<U, D>& rhs);
+template <class T, class U, int D>
+bool operator!=(const Mat<T, D>& lhs, const Mat<U, D>& rhs);
+
+// Arithmetic
+template <class T, class U, int D>
+Mat<Promote<T, U>, D> operator+(const Mat<T, D>& lhs, const Mat<U, D>& rhs);
+template <class T, class U, int D>
+Mat<Promote<T, U>, D> operator-(const Mat<T, D>& lhs, const Mat<U, D>& rhs);
+template <class T, class U, int D>
+Mat<Promote<T, U>, D> operator*(const Mat<T, D>& lhs, const Mat<U, D>& rhs);
+template <class T, class U, int D>
+Vec<Promote<T, U>, D> operator*(const Mat<T, D>& lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D, EnableIfScalar<U> * = nullptr>
+Mat<Promote<T, U>, D> operator*(const Mat<T, D>& lhs, U rhs);
+template <class T, class U, int D, EnableIfScalar<T> * = nullptr>
+Mat<Promote<T, U>, D> operator*(T lhs, const Mat<U, D>& rhs);
+template <class T, class U, int D, EnableIfScalar<U> * = nullptr>
+Mat<Promote<T, U>, D> operator/(const Mat<T, D>& lhs, U rhs);
+
+template <class T>
+using Mat2 = Mat<T, 2>;
+template <class T>
+using Mat3 = Mat<T, 3>;
+template <class T>
+using Mat4 = Mat<T, 4>;
+
+using Mat2f = Mat2<float>;
+using Mat2d = Mat2<double>;
+using Mat3f = Mat3<float>;
+using Mat3d = Mat3<double>;
+using Mat4f = Mat4<float>;
+using Mat4d = Mat4<double>;
+
+#pragma mark -
+
+template <class T, int D>
+inline Mat<T, D>::Mat() : rows_() {}
+
+template <class T, int D>
+inline Mat<T, D>::Mat(T diagonal) : rows_() {
+  for (int i = 0; i < D; ++i) {
+    rows_[i][i] = diagonal;
+  }
+}
+
+template <class T, int D>
+inline Mat<T, D>::Mat(std::initializer_list<T> list) : rows_() {
+  set(list);
+}
+
+template <class T, int D>
+inline Mat<T, D>::Mat(const T *values) : rows_() {
+  set(values);
+}
+
+#pragma mark Implicit conversion
+
+template <class T, int D>
+template <class U>
+inline Mat<T, D>::Mat(const Mat<U, D>& other) {
+  for (int i = 0; i < D; ++i) {
+    rows_[i] = Row(other[i]);
+  }
+}
+
+#pragma mark Factory
+
+template <class T, int D>
+inline Mat<T, D> Mat<T, D>::identity() {
+  return Mat(1);
+}
+
+template <class T, int D>
+inline Mat<T, D> Mat<T, D>::diagonal(const Vec<T, D>& values) {
+  Mat result;
+  for (int i = 0; i < D; ++i) {
+    result.rows_[i][i] = values[i];
+  }
+  return result;
+}
+
+template <class T, int D>
+inline Mat<T, D> Mat<T, D>::fromColumns(
+    std::initializer_list<Vec<T, D>> columns) {
+  Mat result;
+  int index = 0;
+  for (const auto& column : columns) {
+    if (index == D) break;
+    result.setColumn(index++, column);
+  }
+  return result;
+}
+
+template <class T, int D>
+template <class U>
+inline Mat<T, D> Mat<T, D>::outer(const Vec<T, D>& lhs,
+                                  const Vec<U, D>& rhs) {
+  Mat result;
+  for (int i = 0; i < D; ++i) {
+    for (int j = 0; j < D; ++j) {
+      result.rows_[i][j] = lhs[i] * rhs[j];
+    }
+  }
+  return result;
+}
+
+#pragma mark Mutators
+
+template <class T, int D>
+inline void Mat<T, D>::set(std::initializer_list<T> list) {
+  auto itr = std::begin(list);
+  for (int i = 0; i < D * D && itr != std::end(list); ++i, ++itr) {
+    rows_[i / D][i % D] = *itr;
+  }
+}
+
+template <class T, int D>
+inline void Mat<T, D>::set(const T *values) {
+  for (int i = 0; i < D * D; ++i) {
+    rows_[i / D][i % D] = values[i];
+  }
+}
+
+template <class T, int D>
+inline void Mat<T, D>::reset() {
+  *this = Mat();
+}
+
+#pragma mark Element access
+
+template <class T, int D>
+inline T& Mat<T, D>::at(int row, int column) {
+  assert(0 <= row && row < D);
+  assert(0 <= column && column < D);
+  return rows_[row][column];
+}
+
+template <class T, int D>
+inline const T& Mat<T, D>::at(int row, int column) const {
+  assert(0 <= row && row < D);
+  assert(0 <= column && column < D);
+  return rows_[row][column];
+}
+
+template <class T, int D>
+inline Vec<T, D> Mat<T, D>::column(int index) const {
+  Vec<T, D> result;
+  for (int i = 0; i < D; ++i) {
+    result[i] = rows_[i][index];
+  }
+  return result;
+}
+
+template <class T, int D>
+inline void Mat<T, D>::setColumn(int index, const Vec<T, D>& value) {
+  for (int i = 0; i < D; ++i) {
+    rows_[i][index] = value[i];
+  }
+}
+
+template <class T, int D>
+inline Vec<T, D> Mat<T, D>::diagonal() const {
+  Vec<T, D> result;
+  for (int i = 0; i < D; ++i) {
+    result[i] = rows_[i][i];
+  }
+  return result;
+}
+
+#pragma mark Comparison
+
+template <class T, class U, int D>
+inline bool operator==(const Mat<T, D>& lhs, const Mat<U, D>& rhs) {
+  for (int i = 0; i < D; ++i) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class T, class U, int D>
+inline bool operator!=(const Mat<T, D>& lhs, const Mat<U, D>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T, int D>
+template <class V, class U>
+inline bool Mat<T, D>::equals(const Mat<U, D>& other, V tolerance) const {
+  for (int i = 0; i < D; ++i) {
+    if (!rows_[i].equals(other[i], tolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#pragma mark Arithmetic
+
+template <class T, int D>
+inline Mat<T, D>& Mat<T, D>::operator+=(const Mat& other) {
+  for (int i = 0; i < D; ++i) {
+    rows_[i] += other.rows_[i];
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Mat<T, D>& Mat<T, D>::operator-=(const Mat& other) {
+  for (int i = 0; i < D; ++i) {
+    rows_[i] -= other.rows_[i];
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Mat<T, D>& Mat<T, D>::operator*=(const Mat& other) {
+  return *this = Mat(*this * other);
+}
+
+template <class T, int D>
+inline Mat<T, D>& Mat<T, D>::operator*=(T scalar) {
+  for (int i = 0; i < D; ++i) {
+    rows_[i] *= scalar;
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Mat<T, D>& Mat<T, D>::operator/=(T scalar) {
+  for (int i = 0; i < D; ++i) {
+    rows_[i] /= scalar;
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Mat<Promote<T>, D> Mat<T, D>::operator-() const {
+  Mat<Promote<T>, D> result;
+  for (int i = 0; i < D; ++i) {
+    result[i] = -rows_[i];
+  }
+  return result;
+}
+
+template <class T, class U, int D>
+inline Mat<Promote<T, U>, D> operator+(const Mat<T, D>& lhs,
+                                       const Mat<U, D>& rhs) {
+  Mat<Promote<T, U>, D> result(lhs);
+  return result += rhs;
+}
+
+template <class T, class U, int D>
+inline Mat<Promote<T, U>, D> operator-(const Mat<T, D>& lhs,
+                                       const Mat<U, D>& rhs) {
+  Mat<Promote<T, U>, D> result(lhs);
+  return result -= rhs;
+}
+
+template <class T, class U, int D>
+inline Mat<Promote<T, U>, D> operator*(const Mat<T, D>& lhs,
+                                       const Mat<U, D>& rhs) {
+  Mat<Promote<T, U>, D> result;
+  for (int i = 0; i < D; ++i) {
+    for (int k = 0; k < D; ++k) {
+      result[i] += Vec<Promote<T, U>, D>(rhs[k]) * lhs(i, k);
+    }
+  }
+  return result;
+}
+
+template <class T, class U, int D>
+inline Vec<Promote<T, U>, D> operator*(const Mat<T, D>& lhs,
+                                       const Vec<U, D>& rhs) {
+  Vec<Promote<T, U>, D> result;
+  for (int i = 0; i < D; ++i) {
+    result[i] = lhs[i].dot(rhs);
+  }
+  return result;
+}
+
+template <class T, class U, int D, EnableIfScalar<U> *>
+inline Mat<Promote<T, U>, D> operator*(const Mat<T, D>& lhs, U rhs) {
+  Mat<Promote<T, U>, D> result(lhs);
+  return result *= rhs;
+}
+
+template <class T, class U, int D, EnableIfScalar<T> *>
+inline Mat<Promote<T, U>, D> operator*(T lhs, const Mat<U, D>& rhs) {
+  Mat<Promote<T, U>, D> result(rhs);
+  return result *= lhs;
+}
+
+template <class T, class U, int D, EnableIfScalar<U> *>
+inline Mat<Promote<T, U>, D> operator/(const Mat<T, D>& lhs, U rhs) {
+  Mat<Promote<T, U>, D> result(lhs);
+  return result /= rhs;
+}
+
+#pragma mark Attributes
+
+template <class T, int D>
+inline Promote<T> Mat<T, D>::trace() const {
+  Promote<T> result{};
+  for (int i = 0; i < D; ++i) {
+    result += rows_[i][i];
+  }
+  return result;
+}
+
+template <class T, int D>
+inline Promote<T> Mat<T, D>::determinant() const {
+  using R = Promote<T>;
+  const Mat<R, D>& m = *this;
+  switch (D) {
+    case 2:
+      return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    case 3:
+      return (m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) -
+              m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0)) +
+              m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0)));
+    default:
+      break;
+  }
+  // Gaussian elimination with partial pivoting
+  Mat<R, D> lu(m);
+  R result = 1;
+  for (int k = 0; k < D; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < D; ++i) {
+      if (std::abs(lu(i, k)) > std::abs(lu(pivot, k))) {
+        pivot = i;
+      }
+    }
+    if (!lu(pivot, k)) {
+      return R();
+    }
+    if (pivot != k) {
+      std::swap(lu[pivot], lu[k]);
+      result = -result;
+    }
+    result *= lu(k, k);
+    for (int i = k + 1; i < D; ++i) {
+      lu[i] -= lu[k] * (lu(i, k) / lu(k, k));
+    }
+  }
+  return result;
+}
+
+template <class T, int D>
+inline bool Mat<T, D>::symmetric() const {
+  for (int i = 0; i < D; ++i) {
+    for (int j = i + 1; j < D; ++j) {
+      if (rows_[i][j] != rows_[j][i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+#pragma mark Transformation
+
+template <class T, int D>
+inline Mat<T, D>& Mat<T, D>::transpose() {
+  for (int i = 0; i < D; ++i) {
+    for (int j = i + 1; j < D; ++j) {
+      std::swap(rows_[i][j], rows_[j][i]);
+    }
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Mat<Promote<T>, D> Mat<T, D>::transposed() const {
+  return Mat<Promote<T>, D>(*this).transpose();
+}
+
+template <class T, int D>
+inline Mat<T, D>& Mat<T, D>::invert() {
+  // Gauss-Jordan elimination with partial pivoting. Singular matrices become
+  // zero matrices.
+  Mat result = identity();
+  for (int k = 0; k < D; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < D; ++i) {
+      if (std::abs(rows_[i][k]) > std::abs(rows_[pivot][k])) {
+        pivot = i;
+      }
+    }
+    if (!rows_[pivot][k]) {
+      return *this = Mat();
+    }
+    std::swap(rows_[pivot], rows_[k]);
+    std::swap(result.rows_[pivot], result.rows_[k]);
+    const T scale = rows_[k][k];
+    rows_[k] /= scale;
+    result.rows_[k] /= scale;
+    for (int i = 0; i < D; ++i) {
+      if (i != k) {
+        const T factor = rows_[i][k];
+        rows_[i] -= rows_[k] * factor;
+        result.rows_[i] -= result.rows_[k] * factor;
+      }
+    }
+  }
+  return *this = result;
+}
+
+template <class T, int D>
+inline Mat<Promote<T>, D> Mat<T, D>::inverted() const {
+  return Mat<Promote<T>, D>(*this).invert();
+}
+
+#pragma mark Stream
+
+template <class T, int D>
+inline std::ostream& operator<<(std::ostream& os, const Mat<T, D>& matrix) {
+  os << "(";
+  for (int i = 0; i < D; ++i) {
+    os << " " << matrix[i];
+  }
+  return os << " )";
+}
+
+}  // namespace math
+
+using math::Mat;
+using math::Mat2;
+using math::Mat3;
+using math::Mat4;
+using math::Mat2f;
+using math::Mat2d;
+using math::Mat3f;
+using math::Mat3d;
+using math::Mat4f;
+using math::Mat4d;
+
+}  // namespace takram
+
+template <class T, int D>
+struct std::hash<takram::math::Mat<T, D>> {
+  std::size_t operator()(const takram::math::Mat<T, D>& value) const {
+    std::hash<takram::math::Vec<T, D>> hash;
+    std::size_t result = 0;
+    for (int i = 0; i < D; ++i) {
+      result ^= hash(value[i]) << i;
+    }
+    return result;
+  }
+};
+
+#endif  // TAKRAM_MATH_MATRIX_H_
@@ -0,0 +1,142 @@
+//
+//  takram/math/neighbors.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_NEIGHBORS_H_
+#define TAKRAM_MATH_NEIGHBORS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Exhaustive k-nearest neighbor search over a range of vectors of any
+// dimension, which outperforms spatial indices for high-dimensional vectors or
+// datasets too small to amortize building one. Indices of the nearest points
+// are written in the order of increasing distance, and each query writes
+// min(k, number of points) indices.
+
+template <class ForwardIterator, class T, int D, class OutputIterator>
+OutputIterator nearestNeighbors(ForwardIterator first,
+                                ForwardIterator last,
+                                const Vec<T, D>& query,
+                                std::size_t k,
+                                OutputIterator result);
+template <class ForwardIterator, class InputIterator, class OutputIterator>
+OutputIterator nearestNeighbors(ForwardIterator first,
+                                ForwardIterator last,
+                                InputIterator queries_first,
+                                InputIterator queries_last,
+                                std::size_t k,
+                                OutputIterator result);
+
+#pragma mark -
+
+namespace neighbors {
+
+// Keeps the k nearest candidates in a max-heap on their distances, so that
+// most points are rejected by a single comparison with the top.
+template <class ForwardIterator, class T, int D, class Heap,
+          class OutputIterator>
+inline OutputIterator search(ForwardIterator first,
+                             ForwardIterator last,
+                             const Vec<T, D>& query,
+                             std::size_t k,
+                             Heap *heap,
+                             OutputIterator result) {
+  using Distance = typename Heap::value_type::first_type;
+  heap->clear();
+  if (!k) {
+    return result;
+  }
+  std::size_t index{};
+  for (; first != last; ++first, ++index) {
+    const Distance distance = query.distanceSquared(*first);
+    if (heap->size() < k) {
+      heap->emplace_back(distance, index);
+      std::push_heap(heap->begin(), heap->end());
+    } else if (distance < heap->front().first) {
+      std::pop_heap(heap->begin(), heap->end());
+      heap->back() = std::make_pair(distance, index);
+      std::push_heap(heap->begin(), heap->end());
+    }
+  }
+  std::sort_heap(heap->begin(), heap->end());
+  for (const auto& candidate : *heap) {
+    *result = candidate.second;
+    ++result;
+  }
+  return result;
+}
+
+}  // namespace neighbors
+
+template <class ForwardIterator, class T, int D, class OutputIterator>
+inline OutputIterator nearestNeighbors(ForwardIterator first,
+                                       ForwardIterator last,
+                                       const Vec<T, D>& query,
+                                       std::size_t k,
+                                       OutputIterator result) {
+  using Point = typename std::iterator_traits<ForwardIterator>::value_type;
+  using Distance = Promote<T, typename Point::Type>;
+  std::vector<std::pair<Distance, std::size_t>> heap;
+  heap.reserve(std::min(
+      k, static_cast<std::size_t>(std::distance(first, last))));
+  return neighbors::search(first, last, query, k, &heap, result);
+}
+
+template <class ForwardIterator, class InputIterator, class OutputIterator>
+inline OutputIterator nearestNeighbors(ForwardIterator first,
+                                       ForwardIterator last,
+                                       InputIterator queries_first,
+                                       InputIterator queries_last,
+                                       std::size_t k,
+                                       OutputIterator result) {
+  using Point = typename std::iterator_traits<ForwardIterator>::value_type;
+  using Query = typename std::iterator_traits<InputIterator>::value_type;
+  using Distance = Promote<typename Query::Type, typename Point::Type>;
+  std::vector<std::pair<Distance, std::size_t>> heap;
+  heap.reserve(std::min(
+      k, static_cast<std::size_t>(std::distance(first, last))));
+  for (; queries_first != queries_last; ++queries_first) {
+    result = neighbors::search(first, last, *queries_first, k, &heap, result);
+  }
+  return result;
+}
+
+}  // namespace math
+
+using math::nearestNeighbors;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_NEIGHBORS_H_
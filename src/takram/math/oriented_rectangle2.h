@@ -0,0 +1,290 @@
+//
+//  takram/math/oriented_rectangle2.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_ORIENTED_RECTANGLE2_H_
+#define TAKRAM_MATH_ORIENTED_RECTANGLE2_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
+#include "takram/math/promotion.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T, int D>
+class OrientedRect;
+
+template <class T>
+using OrientedRect2 = OrientedRect<T, 2>;
+
+// Extents are half the lengths of the sides, measured along the axes of the
+// rectangle, which is rotated counterclockwise by angle in radians about its
+// center.
+template <class T>
+class OrientedRect<T, 2> final {
+ public:
+  using Type = T;
+
+ public:
+  OrientedRect();
+  OrientedRect(const Vec2<T>& center, const Vec2<T>& extents, T angle = T());
+
+  // Explicit conversion
+  template <class U>
+  explicit OrientedRect(const Rect2<U>& other);
+
+  // Copy semantics
+  OrientedRect(const OrientedRect& other) = default;
+  OrientedRect& operator=(const OrientedRect& other) = default;
+
+  // Mutators
+  void set(const Vec2<T>& center, const Vec2<T>& extents, T angle = T());
+  void reset();
+
+  // Comparison
+  template <class V, class U = T>
+  bool equals(const OrientedRect2<U>& other, V tolerance) const;
+
+  // Attributes
+  bool empty() const { return !extents.x || !extents.y; }
+  Promote<T> area() const;
+  Promote<T> perimeter() const;
+  Rect2<Promote<T>> bounds() const;
+
+  // Axes and corners
+  Vec2<Promote<T>> axis(int index) const;
+  Vec2<Promote<T>> corner(int index) const;
+
+  // Containment
+  template <class U = T>
+  bool contains(const Vec2<U>& point) const;
+
+  // Intersection
+  template <class U = T>
+  bool intersects(const OrientedRect2<U>& other) const;
+  template <class U = T>
+  bool intersects(const Rect2<U>& other) const;
+
+ public:
+  union {
+    Vec2<T> center;
+    struct { T x; T y; };
+  };
+  Vec2<T> extents;
+  T angle;
+};
+
+using OrientedRect2f = OrientedRect2<float>;
+using OrientedRect2d = OrientedRect2<double>;
+
+#pragma mark -
+
+template <class T>
+inline OrientedRect<T, 2>::OrientedRect() : center(), extents(), angle() {}
+
+template <class T>
+inline OrientedRect<T, 2>::OrientedRect(const Vec2<T>& center,
+                                        const Vec2<T>& extents,
+                                        T angle)
+    : center(center),
+      extents(extents),
+      angle(angle) {}
+
+#pragma mark Explicit conversion
+
+template <class T>
+template <class U>
+inline OrientedRect<T, 2>::OrientedRect(const Rect2<U>& other)
+    : center(other.centroid()),
+      extents(std::abs(other.width) / 2, std::abs(other.height) / 2),
+      angle() {}
+
+#pragma mark Mutators
+
+template <class T>
+inline void OrientedRect<T, 2>::set(const Vec2<T>& center,
+                                    const Vec2<T>& extents,
+                                    T angle) {
+  this->center = center;
+  this->extents = extents;
+  this->angle = angle;
+}
+
+template <class T>
+inline void OrientedRect<T, 2>::reset() {
+  *this = OrientedRect();
+}
+
+#pragma mark Comparison
+
+template <class T, class U>
+inline bool operator==(const OrientedRect2<T>& lhs,
+                       const OrientedRect2<U>& rhs) {
+  return (lhs.center == rhs.center &&
+          lhs.extents == rhs.extents &&
+          lhs.angle == rhs.angle);
+}
+
+template <class T, class U>
+inline bool operator!=(const OrientedRect2<T>& lhs,
+                       const OrientedRect2<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T>
+template <class V, class U>
+inline bool OrientedRect<T, 2>::equals(const OrientedRect2<U>& other,
+                                       V tolerance) const {
+  return (center.equals(other.center, tolerance) &&
+          extents.equals(other.extents, tolerance) &&
+          std::abs(angle - other.angle) <= tolerance);
+}
+
+#pragma mark Attributes
+
+template <class T>
+inline Promote<T> OrientedRect<T, 2>::area() const {
+  return 4 * static_cast<Promote<T>>(extents.x) * extents.y;
+}
+
+template <class T>
+inline Promote<T> OrientedRect<T, 2>::perimeter() const {
+  return 4 * (static_cast<Promote<T>>(extents.x) + extents.y);
+}
+
+template <class T>
+inline Rect2<Promote<T>> OrientedRect<T, 2>::bounds() const {
+  using R = Promote<T>;
+  const R cosine = std::abs(std::cos(angle));
+  const R sine = std::abs(std::sin(angle));
+  const R width = extents.x * cosine + extents.y * sine;
+  const R height = extents.x * sine + extents.y * cosine;
+  return Rect2<R>(center.x - width, center.y - height, 2 * width, 2 * height);
+}
+
+#pragma mark Axes and corners
+
+template <class T>
+inline Vec2<Promote<T>> OrientedRect<T, 2>::axis(int index) const {
+  using R = Promote<T>;
+  assert(0 <= index && index < 2);
+  const R cosine = std::cos(angle);
+  const R sine = std::sin(angle);
+  return index ? Vec2<R>(-sine, cosine) : Vec2<R>(cosine, sine);
+}
+
+template <class T>
+inline Vec2<Promote<T>> OrientedRect<T, 2>::corner(int index) const {
+  using R = Promote<T>;
+  assert(0 <= index && index < 4);
+  // Counterclockwise from the corner at minimum extents
+  const R u = (index == 1 || index == 2) ? extents.x : -extents.x;
+  const R v = (index < 2) ? -extents.y : extents.y;
+  return Vec2<R>(center) + axis(0) * u + axis(1) * v;
+}
+
+#pragma mark Containment
+
+template <class T>
+template <class U>
+inline bool OrientedRect<T, 2>::contains(const Vec2<U>& point) const {
+  using R = Promote<T, U>;
+  const R cosine = std::cos(angle);
+  const R sine = std::sin(angle);
+  const R dx = point.x - center.x;
+  const R dy = point.y - center.y;
+  return (std::abs(dx * cosine + dy * sine) <= extents.x &&
+          std::abs(dy * cosine - dx * sine) <= extents.y);
+}
+
+#pragma mark Intersection
+
+template <class T>
+template <class U>
+inline bool OrientedRect<T, 2>::intersects(
+    const OrientedRect2<U>& other) const {
+  using R = Promote<T, U>;
+  // Separating axis test against the two axes of each rectangle
+  const R ac = std::cos(angle);
+  const R as = std::sin(angle);
+  const R bc = std::cos(other.angle);
+  const R bs = std::sin(other.angle);
+  const R dx = other.center.x - center.x;
+  const R dy = other.center.y - center.y;
+  // Cosine and sine of the relative angle
+  const R c = std::abs(ac * bc + as * bs);
+  const R s = std::abs(ac * bs - as * bc);
+  return !(std::abs(dx * ac + dy * as) >
+               extents.x + other.extents.x * c + other.extents.y * s ||
+           std::abs(dy * ac - dx * as) >
+               extents.y + other.extents.x * s + other.extents.y * c ||
+           std::abs(dx * bc + dy * bs) >
+               other.extents.x + extents.x * c + extents.y * s ||
+           std::abs(dy * bc - dx * bs) >
+               other.extents.y + extents.x * s + extents.y * c);
+}
+
+template <class T>
+template <class U>
+inline bool OrientedRect<T, 2>::intersects(const Rect2<U>& other) const {
+  return intersects(OrientedRect2<Promote<U>>(other));
+}
+
+#pragma mark Stream
+
+template <class T>
+inline std::ostream& operator<<(std::ostream& os,
+                                const OrientedRect2<T>& rect) {
+  return os << "( " << rect.center << ", " << rect.extents << ", " <<
+      rect.angle << " )";
+}
+
+}  // namespace math
+
+using math::OrientedRect2;
+using math::OrientedRect2f;
+using math::OrientedRect2d;
+
+}  // namespace takram
+
+template <class T>
+struct std::hash<takram::math::OrientedRect2<T>> {
+  std::size_t operator()(const takram::math::OrientedRect2<T>& value) const {
+    std::hash<takram::math::Vec2<T>> hash;
+    return ((hash(value.center) << 0) ^
+            (hash(value.extents) << 1) ^
+            (std::hash<T>()(value.angle) << 2));
+  }
+};
+
+#endif  // TAKRAM_MATH_ORIENTED_RECTANGLE2_H_
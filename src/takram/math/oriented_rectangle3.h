@@ -0,0 +1,298 @@
+//
+//  takram/math/oriented_rectangle3.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_ORIENTED_RECTANGLE3_H_
+#define TAKRAM_MATH_ORIENTED_RECTANGLE3_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <ostream>
+
+#include "takram/math/matrix.h"
+#include "takram/math/promotion.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T, int D>
+class OrientedRect;
+
+template <class T>
+using OrientedRect3 = OrientedRect<T, 3>;
+
+// Extents are half the lengths of the edges, measured along the axes of the
+// box, which are the columns of a rotation matrix.
+template <class T>
+class OrientedRect<T, 3> final {
+ public:
+  using Type = T;
+
+ public:
+  OrientedRect();
+  OrientedRect(const Vec3<T>& center, const Vec3<T>& extents);
+  OrientedRect(const Vec3<T>& center,
+               const Vec3<T>& extents,
+               const Mat3<T>& axes);
+
+  // Copy semantics
+  OrientedRect(const OrientedRect& other) = default;
+  OrientedRect& operator=(const OrientedRect& other) = default;
+
+  // Mutators
+  void set(const Vec3<T>& center, const Vec3<T>& extents);
+  void set(const Vec3<T>& center,
+           const Vec3<T>& extents,
+           const Mat3<T>& axes);
+  void reset();
+
+  // Comparison
+  template <class V, class U = T>
+  bool equals(const OrientedRect3<U>& other, V tolerance) const;
+
+  // Attributes
+  bool empty() const { return !extents.x || !extents.y || !extents.z; }
+  Promote<T> volume() const;
+  Promote<T> area() const;
+
+  // Axes and corners
+  Vec3<T> axis(int index) const { return axes.column(index); }
+  Vec3<Promote<T>> corner(int index) const;
+
+  // Containment
+  template <class U = T>
+  bool contains(const Vec3<U>& point) const;
+
+  // Intersection
+  template <class U = T>
+  bool intersects(const OrientedRect3<U>& other) const;
+
+ public:
+  union {
+    Vec3<T> center;
+    struct { T x; T y; T z; };
+  };
+  Vec3<T> extents;
+  Mat3<T> axes;
+};
+
+using OrientedRect3f = OrientedRect3<float>;
+using OrientedRect3d = OrientedRect3<double>;
+
+#pragma mark -
+
+template <class T>
+inline OrientedRect<T, 3>::OrientedRect()
+    : center(),
+      extents(),
+      axes(Mat3<T>::identity()) {}
+
+template <class T>
+inline OrientedRect<T, 3>::OrientedRect(const Vec3<T>& center,
+                                        const Vec3<T>& extents)
+    : center(center),
+      extents(extents),
+      axes(Mat3<T>::identity()) {}
+
+template <class T>
+inline OrientedRect<T, 3>::OrientedRect(const Vec3<T>& center,
+                                        const Vec3<T>& extents,
+                                        const Mat3<T>& axes)
+    : center(center),
+      extents(extents),
+      axes(axes) {}
+
+#pragma mark Mutators
+
+template <class T>
+inline void OrientedRect<T, 3>::set(const Vec3<T>& center,
+                                    const Vec3<T>& extents) {
+  set(center, extents, Mat3<T>::identity());
+}
+
+template <class T>
+inline void OrientedRect<T, 3>::set(const Vec3<T>& center,
+                                    const Vec3<T>& extents,
+                                    const Mat3<T>& axes) {
+  this->center = center;
+  this->extents = extents;
+  this->axes = axes;
+}
+
+template <class T>
+inline void OrientedRect<T, 3>::reset() {
+  *this = OrientedRect();
+}
+
+#pragma mark Comparison
+
+template <class T, class U>
+inline bool operator==(const OrientedRect3<T>& lhs,
+                       const OrientedRect3<U>& rhs) {
+  return (lhs.center == rhs.center &&
+          lhs.extents == rhs.extents &&
+          lhs.axes == rhs.axes);
+}
+
+template <class T, class U>
+inline bool operator!=(const OrientedRect3<T>& lhs,
+                       const OrientedRect3<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T>
+template <class V, class U>
+inline bool OrientedRect<T, 3>::equals(const OrientedRect3<U>& other,
+                                       V tolerance) const {
+  return (center.equals(other.center, tolerance) &&
+          extents.equals(other.extents, tolerance) &&
+          axes.equals(other.axes, tolerance));
+}
+
+#pragma mark Attributes
+
+template <class T>
+inline Promote<T> OrientedRect<T, 3>::volume() const {
+  return 8 * static_cast<Promote<T>>(extents.x) * extents.y * extents.z;
+}
+
+template <class T>
+inline Promote<T> OrientedRect<T, 3>::area() const {
+  using R = Promote<T>;
+  return 8 * (static_cast<R>(extents.x) * extents.y +
+              static_cast<R>(extents.y) * extents.z +
+              static_cast<R>(extents.z) * extents.x);
+}
+
+#pragma mark Axes and corners
+
+template <class T>
+inline Vec3<Promote<T>> OrientedRect<T, 3>::corner(int index) const {
+  using R = Promote<T>;
+  assert(0 <= index && index < 8);
+  // Bits 0, 1 and 2 of the index select the positive side of each axis
+  const Vec3<R> signs(index & 1 ? 1 : -1,
+                      index & 2 ? 1 : -1,
+                      index & 4 ? 1 : -1);
+  return center + axes * (signs * extents);
+}
+
+#pragma mark Containment
+
+template <class T>
+template <class U>
+inline bool OrientedRect<T, 3>::contains(const Vec3<U>& point) const {
+  using R = Promote<T, U>;
+  const Vec3<R> delta = point - center;
+  return (std::abs(delta.dot(axes.column(0))) <= extents.x &&
+          std::abs(delta.dot(axes.column(1))) <= extents.y &&
+          std::abs(delta.dot(axes.column(2))) <= extents.z);
+}
+
+#pragma mark Intersection
+
+template <class T>
+template <class U>
+inline bool OrientedRect<T, 3>::intersects(
+    const OrientedRect3<U>& other) const {
+  using R = Promote<T, U>;
+  // Separating axis test of Gottschalk et al. against the three axes of each
+  // box and the nine cross products of their axes. The epsilon keeps the
+  // cross products of nearly parallel axes from producing false separations.
+  const Mat3<R> a = axes;
+  const Mat3<R> b = other.axes;
+  const Vec3<R> ea = extents;
+  const Vec3<R> eb = other.extents;
+  const Mat3<R> rotation = a.transposed() * b;
+  Mat3<R> absolute;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      absolute(i, j) = (std::abs(rotation(i, j)) +
+                        std::numeric_limits<R>::epsilon());
+    }
+  }
+  const Vec3<R> t = a.transposed() * (other.center - center);
+  for (int i = 0; i < 3; ++i) {
+    if (std::abs(t[i]) > ea[i] + absolute[i].dot(eb)) {
+      return false;
+    }
+  }
+  for (int j = 0; j < 3; ++j) {
+    if (std::abs(t.dot(rotation.column(j))) >
+        ea.dot(absolute.column(j)) + eb[j]) {
+      return false;
+    }
+  }
+  for (int i = 0; i < 3; ++i) {
+    const int i1 = (i + 1) % 3;
+    const int i2 = (i + 2) % 3;
+    for (int j = 0; j < 3; ++j) {
+      const int j1 = (j + 1) % 3;
+      const int j2 = (j + 2) % 3;
+      const R distance = std::abs(t[i2] * rotation(i1, j) -
+                                  t[i1] * rotation(i2, j));
+      const R radius = (ea[i1] * absolute(i2, j) + ea[i2] * absolute(i1, j) +
+                        eb[j1] * absolute(i, j2) + eb[j2] * absolute(i, j1));
+      if (distance > radius) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+#pragma mark Stream
+
+template <class T>
+inline std::ostream& operator<<(std::ostream& os,
+                                const OrientedRect3<T>& rect) {
+  return os << "( " << rect.center << ", " << rect.extents << ", " <<
+      rect.axes << " )";
+}
+
+}  // namespace math
+
+using math::OrientedRect3;
+using math::OrientedRect3f;
+using math::OrientedRect3d;
+
+}  // namespace takram
+
+template <class T>
+struct std::hash<takram::math::OrientedRect3<T>> {
+  std::size_t operator()(const takram::math::OrientedRect3<T>& value) const {
+    std::hash<takram::math::Vec3<T>> hash;
+    return ((hash(value.center) << 0) ^
+            (hash(value.extents) << 1) ^
+            (std::hash<takram::math::Mat3<T>>()(value.axes) << 2));
+  }
+};
+
+#endif  // TAKRAM_MATH_ORIENTED_RECTANGLE3_H_
@@ -36,6 +36,7 @@
 #include <mutex>
 #include <random>
 
+#include "takram/math/fwd.h"
 #include "takram/math/promotion.h"
 
 namespace takram {
@@ -208,6 +209,11 @@ inline T Random<Engine>::gaussian(Promote<T> mean, Promote<T> stddev) {
   return std::normal_distribution<Promote<T>>(mean, stddev)(engine_);
 }
 
+template <class T>
+struct SharedRandom<T, void> {
+  static Random<>& get() { return Random<>::shared(); }
+};
+
 namespace random {
 
 #pragma mark Random generation
@@ -0,0 +1,340 @@
+//
+//  takram/math/rasterize.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_RASTERIZE_H_
+#define TAKRAM_MATH_RASTERIZE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "takram/math/line.h"
+#include "takram/math/rectangle.h"
+
+namespace takram {
+namespace math {
+
+// Line rasterization into the pixels of a clip rectangle, where pixel (x, y)
+// is centered at integer coordinates and the rectangle covers pixels from its
+// minimum inclusive to its maximum exclusive. Segments are clipped before
+// stepping, so the cost only depends on the number of visible pixels.
+//
+// rasterize() visits the pixels of integer segments (Bresenham) and calls
+// function(x, y), or assigns value into a strided buffer whose first element
+// is the minimum pixel of the clip rectangle. rasterizeAntialiased() visits
+// the pixels of floating-point segments with their coverage (Wu) and calls
+// function(x, y, coverage), or accumulates value * coverage into a buffer.
+
+template <class T, class Function>
+void rasterize(const Line2<T>& line, const Rect2<T>& clip, Function function);
+template <class InputIterator, class T, class Function>
+void rasterize(InputIterator first,
+               InputIterator last,
+               const Rect2<T>& clip,
+               Function function);
+template <class T, class U>
+void rasterize(const Line2<T>& line,
+               const Rect2<T>& clip,
+               U value,
+               U *buffer,
+               std::ptrdiff_t stride);
+template <class InputIterator, class T, class U>
+void rasterize(InputIterator first,
+               InputIterator last,
+               const Rect2<T>& clip,
+               U value,
+               U *buffer,
+               std::ptrdiff_t stride);
+
+template <class T, class Function>
+void rasterizeAntialiased(const Line2<T>& line,
+                          const Rect2i& clip,
+                          Function function);
+template <class InputIterator, class Function>
+void rasterizeAntialiased(InputIterator first,
+                          InputIterator last,
+                          const Rect2i& clip,
+                          Function function);
+template <class T, class U>
+void rasterizeAntialiased(const Line2<T>& line,
+                          const Rect2i& clip,
+                          U value,
+                          U *buffer,
+                          std::ptrdiff_t stride);
+template <class InputIterator, class U>
+void rasterizeAntialiased(InputIterator first,
+                          InputIterator last,
+                          const Rect2i& clip,
+                          U value,
+                          U *buffer,
+                          std::ptrdiff_t stride);
+
+#pragma mark -
+
+#pragma mark Bresenham
+
+template <class T, class Function>
+inline void rasterize(const Line2<T>& line,
+                      const Rect2<T>& clip,
+                      Function function) {
+  static_assert(std::is_integral<T>::value, "Integral type is required");
+  using I = std::int64_t;
+  const auto floor = [](I numerator, I denominator) {
+    const I quotient = numerator / denominator;
+    return quotient - (numerator % denominator < 0);
+  };
+  const auto ceil = [](I numerator, I denominator) {
+    const I quotient = numerator / denominator;
+    return quotient + (numerator % denominator > 0);
+  };
+  // Offsets from the first point, in the stepping direction of each axis,
+  // that stay within the clip rectangle
+  const auto bounds = [](I start, I step, I min, I max) {
+    return step > 0 ? std::make_pair(min - start, max - start)
+                    : std::make_pair(start - max, start - min);
+  };
+  const I dx = I(line.b.x) - line.a.x;
+  const I dy = I(line.b.y) - line.a.y;
+  const bool steep = std::abs(dy) > std::abs(dx);
+  const I p0 = steep ? line.a.y : line.a.x;
+  const I q0 = steep ? line.a.x : line.a.y;
+  const I dp = std::abs(steep ? dy : dx);
+  const I dq = std::abs(steep ? dx : dy);
+  const I sp = (steep ? dy : dx) < 0 ? -1 : 1;
+  const I sq = (steep ? dx : dy) < 0 ? -1 : 1;
+  const auto major = steep
+      ? bounds(p0, sp, clip.minY(), I(clip.maxY()) - 1)
+      : bounds(p0, sp, clip.minX(), I(clip.maxX()) - 1);
+  const auto minor = steep
+      ? bounds(q0, sq, clip.minX(), I(clip.maxX()) - 1)
+      : bounds(q0, sq, clip.minY(), I(clip.maxY()) - 1);
+  // The minor offset at step k is floor((2 * k * dq + dp) / (2 * dp))
+  I first = std::max<I>(0, major.first);
+  I last = std::min<I>(dp, major.second);
+  if (dq) {
+    first = std::max(first, ceil((2 * minor.first - 1) * dp, 2 * dq));
+    last = std::min(last, ceil((2 * minor.second + 1) * dp, 2 * dq) - 1);
+  } else if (minor.first > 0 || minor.second < 0) {
+    return;
+  }
+  if (first > last) {
+    return;
+  }
+  const I denominator = 2 * std::max<I>(dp, 1);
+  I error = 2 * first * dq + dp;
+  I offset = floor(error, denominator);
+  error -= offset * denominator;
+  for (I k = first; k <= last; ++k) {
+    const I p = p0 + sp * k;
+    const I q = q0 + sq * offset;
+    if (steep) {
+      function(static_cast<T>(q), static_cast<T>(p));
+    } else {
+      function(static_cast<T>(p), static_cast<T>(q));
+    }
+    error += 2 * dq;
+    if (error >= denominator) {
+      error -= denominator;
+      ++offset;
+    }
+  }
+}
+
+template <class InputIterator, class T, class Function>
+inline void rasterize(InputIterator first,
+                      InputIterator last,
+                      const Rect2<T>& clip,
+                      Function function) {
+  for (; first != last; ++first) {
+    rasterize(*first, clip, function);
+  }
+}
+
+template <class T, class U>
+inline void rasterize(const Line2<T>& line,
+                      const Rect2<T>& clip,
+                      U value,
+                      U *buffer,
+                      std::ptrdiff_t stride) {
+  const T x = clip.minX();
+  const T y = clip.minY();
+  rasterize(line, clip, [=](T px, T py) {
+    buffer[(py - y) * stride + (px - x)] = value;
+  });
+}
+
+template <class InputIterator, class T, class U>
+inline void rasterize(InputIterator first,
+                      InputIterator last,
+                      const Rect2<T>& clip,
+                      U value,
+                      U *buffer,
+                      std::ptrdiff_t stride) {
+  for (; first != last; ++first) {
+    rasterize(*first, clip, value, buffer, stride);
+  }
+}
+
+#pragma mark Wu
+
+template <class T, class Function>
+inline void rasterizeAntialiased(const Line2<T>& line,
+                                 const Rect2i& clip,
+                                 Function function) {
+  static_assert(std::is_floating_point<T>::value,
+                "Floating point type is required");
+  const int min_x = clip.minX();
+  const int min_y = clip.minY();
+  const int max_x = clip.maxX();
+  const int max_y = clip.maxY();
+  if (min_x >= max_x || min_y >= max_y) {
+    return;
+  }
+  // Clip against the rectangle grown by a pixel (Liang-Barsky), so that the
+  // partial coverage at clipped ends falls outside of it
+  Vec2<T> a = line.a;
+  Vec2<T> b = line.b;
+  const Vec2<T> delta = b - a;
+  T t0 = 0;
+  T t1 = 1;
+  const T p[] = {-delta.x, delta.x, -delta.y, delta.y};
+  const T q[] = {
+    a.x - (min_x - 1), max_x - a.x, a.y - (min_y - 1), max_y - a.y
+  };
+  for (int i = 0; i < 4; ++i) {
+    if (p[i] == 0) {
+      if (q[i] < 0) {
+        return;
+      }
+    } else {
+      const T t = q[i] / p[i];
+      if (p[i] < 0) {
+        t0 = std::max(t0, t);
+      } else {
+        t1 = std::min(t1, t);
+      }
+    }
+  }
+  if (t0 > t1) {
+    return;
+  }
+  b = line.a + delta * t1;
+  a = line.a + delta * t0;
+  const bool steep = std::abs(delta.y) > std::abs(delta.x);
+  if (steep) {
+    std::swap(a.x, a.y);
+    std::swap(b.x, b.y);
+  }
+  if (a.x > b.x) {
+    std::swap(a, b);
+  }
+  const auto plot = [&](int x, int y, T coverage) {
+    if (steep) {
+      std::swap(x, y);
+    }
+    if (min_x <= x && x < max_x && min_y <= y && y < max_y && coverage > 0) {
+      function(x, y, coverage);
+    }
+  };
+  const T dx = b.x - a.x;
+  const T gradient = dx > 0 ? (b.y - a.y) / dx : T(1);
+  const T x1 = std::round(a.x);
+  const T y1 = a.y + gradient * (x1 - a.x);
+  const T gap1 = 1 - (a.x + T(0.5) - std::floor(a.x + T(0.5)));
+  const T x2 = std::round(b.x);
+  const T y2 = b.y + gradient * (x2 - b.x);
+  const T gap2 = b.x + T(0.5) - std::floor(b.x + T(0.5));
+  const int px1 = static_cast<int>(x1);
+  const int px2 = static_cast<int>(x2);
+  if (px1 == px2) {
+    const T y = (y1 + y2) / 2;
+    const T coverage = b.x - a.x;
+    const int py = static_cast<int>(std::floor(y));
+    plot(px1, py, (1 - (y - py)) * coverage);
+    plot(px1, py + 1, (y - py) * coverage);
+    return;
+  }
+  int py = static_cast<int>(std::floor(y1));
+  plot(px1, py, (1 - (y1 - py)) * gap1);
+  plot(px1, py + 1, (y1 - py) * gap1);
+  py = static_cast<int>(std::floor(y2));
+  plot(px2, py, (1 - (y2 - py)) * gap2);
+  plot(px2, py + 1, (y2 - py) * gap2);
+  T y = y1 + gradient;
+  for (int x = px1 + 1; x < px2; ++x, y += gradient) {
+    py = static_cast<int>(std::floor(y));
+    plot(x, py, 1 - (y - py));
+    plot(x, py + 1, y - py);
+  }
+}
+
+template <class InputIterator, class Function>
+inline void rasterizeAntialiased(InputIterator first,
+                                 InputIterator last,
+                                 const Rect2i& clip,
+                                 Function function) {
+  for (; first != last; ++first) {
+    rasterizeAntialiased(*first, clip, function);
+  }
+}
+
+template <class T, class U>
+inline void rasterizeAntialiased(const Line2<T>& line,
+                                 const Rect2i& clip,
+                                 U value,
+                                 U *buffer,
+                                 std::ptrdiff_t stride) {
+  const int x = clip.minX();
+  const int y = clip.minY();
+  rasterizeAntialiased(line, clip, [=](int px, int py, T coverage) {
+    buffer[(py - y) * stride + (px - x)] += static_cast<U>(value * coverage);
+  });
+}
+
+template <class InputIterator, class U>
+inline void rasterizeAntialiased(InputIterator first,
+                                 InputIterator last,
+                                 const Rect2i& clip,
+                                 U value,
+                                 U *buffer,
+                                 std::ptrdiff_t stride) {
+  for (; first != last; ++first) {
+    rasterizeAntialiased(*first, clip, value, buffer, stride);
+  }
+}
+
+}  // namespace math
+
+using math::rasterize;
+using math::rasterizeAntialiased;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_RASTERIZE_H_
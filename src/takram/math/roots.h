@@ -28,8 +28,12 @@
 #ifndef TAKRAM_MATH_ROOTS_H_
 #define TAKRAM_MATH_ROOTS_H_
 
+#include <algorithm>
 #include <cmath>
 
+#include "takram/math/constants.h"
+#include "takram/math/promotion.h"
+
 namespace takram {
 namespace math {
 
@@ -37,6 +41,8 @@ template <class A, class B, class Iterator>
 unsigned int solveLinear(A a, B b, Iterator result);
 template <class A, class B, class C, class Iterator>
 unsigned int solveQuadratic(A a, B b, C c, Iterator result);
+template <class A, class B, class C, class D, class Iterator>
+unsigned int solveCubic(A a, B b, C c, D d, Iterator result);
 
 #pragma mark -
 
@@ -68,6 +74,42 @@ inline unsigned int solveQuadratic(A a, B b, C c, Iterator result) {
   return 2;
 }
 
+template <class A, class B, class C, class D, class Iterator>
+inline unsigned int solveCubic(A a, B b, C c, D d, Iterator result) {
+  if (!a) {
+    return solveQuadratic(b, c, d, result);
+  }
+  using R = Promote<Promote<A, B>, Promote<C, D>>;
+  const R p2 = R(b) / a;
+  const R p1 = R(c) / a;
+  const R p0 = R(d) / a;
+  const R shift = -p2 / 3;
+  const R p = p1 - p2 * p2 / 3;
+  const R q = 2 * p2 * p2 * p2 / 27 - p2 * p1 / 3 + p0;
+  const R discriminant = q * q / 4 + p * p * p / 27;
+  if (!p && !q) {
+    *result = shift;
+    return 1;
+  }
+  if (discriminant > 0) {
+    const R root = std::sqrt(discriminant);
+    *result = std::cbrt(-q / 2 + root) + std::cbrt(-q / 2 - root) + shift;
+    return 1;
+  }
+  if (!discriminant) {
+    *result = 3 * q / p + shift;
+    *++result = -3 * q / (2 * p) + shift;
+    return 2;
+  }
+  const R radius = 2 * std::sqrt(-p / 3);
+  const R cosine = 3 * q / (p * radius);
+  const R phi = std::acos(std::max(R(-1), std::min(cosine, R(1)))) / 3;
+  *result = radius * std::cos(phi) + shift;
+  *++result = radius * std::cos(phi - tau<R>() / 3) + shift;
+  *++result = radius * std::cos(phi - 2 * tau<R>() / 3) + shift;
+  return 3;
+}
+
 }  // namespace math
 }  // namespace takram
 
@@ -389,17 +389,17 @@ inline Size2<T> Size<T, 2>::max() {
 
 template <class T>
 inline Size2<T> Size<T, 2>::random() {
-  return random(&Random<>::shared());
+  return random(&sharedRandom<T>());
 }
 
 template <class T>
 inline Size2<T> Size<T, 2>::random(T max) {
-  return random(max, &Random<>::shared());
+  return random(max, &sharedRandom<T>());
 }
 
 template <class T>
 inline Size2<T> Size<T, 2>::random(T min, T max) {
-  return random(min, max, &Random<>::shared());
+  return random(min, max, &sharedRandom<T>());
 }
 
 template <class T>
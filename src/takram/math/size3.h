@@ -346,17 +346,17 @@ inline Size3<T> Size<T, 3>::max() {
 
 template <class T>
 inline Size3<T> Size<T, 3>::random() {
-  return random(&Random<>::shared());
+  return random(&sharedRandom<T>());
 }
 
 template <class T>
 inline Size3<T> Size<T, 3>::random(T max) {
-  return random(max, &Random<>::shared());
+  return random(max, &sharedRandom<T>());
 }
 
 template <class T>
 inline Size3<T> Size<T, 3>::random(T min, T max) {
-  return random(min, max, &Random<>::shared());
+  return random(min, max, &sharedRandom<T>());
 }
 
 template <class T>
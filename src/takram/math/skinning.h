@@ -0,0 +1,292 @@
+//
+//  takram/math/skinning.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_SKINNING_H_
+#define TAKRAM_MATH_SKINNING_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+#include "takram/math/matrix.h"
+#include "takram/math/promotion.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+enum class SkinningMethod : int {
+  LINEAR = 0,
+  DUAL_QUATERNION = 1
+};
+
+// Deforms vertices by a palette of up to four bone matrices per vertex, given
+// as separate ranges of positions or normals, bone indices and weights. Linear
+// blending averages the matrices. Dual quaternion blending of Kavan et al.
+// averages rigid transforms instead, which preserves volume around twisting
+// joints but requires the bone matrices to be rigid. The palette is converted
+// once when it is set, and skinning does not modify the skinner, so disjoint
+// ranges of vertices can be skinned concurrently.
+template <class T>
+class Skinner final {
+ public:
+  using Type = T;
+
+ public:
+  Skinner();
+  explicit Skinner(SkinningMethod method);
+
+  // Copy semantics
+  Skinner(const Skinner&) = default;
+  Skinner& operator=(const Skinner&) = default;
+
+  // Parameters
+  SkinningMethod method() const { return method_; }
+  void setMethod(SkinningMethod value) { method_ = value; }
+
+  // Palette
+  template <class InputIterator>
+  void setPalette(InputIterator first, InputIterator last);
+  std::size_t size() const { return palette_.size(); }
+  const Mat4<T>& bone(std::size_t index) const { return palette_[index]; }
+
+  // Skinning
+  template <class InputIterator, class IndexIterator, class WeightIterator,
+            class OutputIterator>
+  OutputIterator skinPositions(InputIterator first,
+                               InputIterator last,
+                               IndexIterator indices,
+                               WeightIterator weights,
+                               OutputIterator result) const;
+  template <class InputIterator, class IndexIterator, class WeightIterator,
+            class OutputIterator>
+  OutputIterator skinNormals(InputIterator first,
+                             InputIterator last,
+                             IndexIterator indices,
+                             WeightIterator weights,
+                             OutputIterator result) const;
+
+ private:
+  // Quaternions are stored as (x, y, z, w)
+  struct DualQuaternion {
+    Vec4<T> real;
+    Vec4<T> dual;
+  };
+
+  Mat4<T> blendMatrix(const Vec4i& indices, const Vec4<T>& weights) const;
+  DualQuaternion blendDualQuaternion(const Vec4i& indices,
+                                     const Vec4<T>& weights) const;
+  static Vec3<T> rotate(const Vec4<T>& quaternion, const Vec3<T>& vector);
+
+ private:
+  SkinningMethod method_;
+  std::vector<Mat4<T>> palette_;
+  std::vector<DualQuaternion> dual_quaternions_;
+};
+
+using Skinnerf = Skinner<float>;
+using Skinnerd = Skinner<double>;
+
+#pragma mark -
+
+template <class T>
+inline Skinner<T>::Skinner() : method_(SkinningMethod::LINEAR) {}
+
+template <class T>
+inline Skinner<T>::Skinner(SkinningMethod method) : method_(method) {}
+
+#pragma mark Palette
+
+template <class T>
+template <class InputIterator>
+inline void Skinner<T>::setPalette(InputIterator first, InputIterator last) {
+  palette_.assign(first, last);
+  dual_quaternions_.resize(palette_.size());
+  for (std::size_t i = 0; i < palette_.size(); ++i) {
+    const auto& m = palette_[i];
+    // Rotation quaternion from the upper 3x3 of the matrix
+    Vec4<T> q;
+    const T trace = m(0, 0) + m(1, 1) + m(2, 2);
+    if (trace > 0) {
+      const T s = 2 * std::sqrt(trace + 1);
+      q.set((m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s,
+            (m(1, 0) - m(0, 1)) / s, s / 4);
+    } else if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+      const T s = 2 * std::sqrt(1 + m(0, 0) - m(1, 1) - m(2, 2));
+      q.set(s / 4, (m(0, 1) + m(1, 0)) / s,
+            (m(0, 2) + m(2, 0)) / s, (m(2, 1) - m(1, 2)) / s);
+    } else if (m(1, 1) > m(2, 2)) {
+      const T s = 2 * std::sqrt(1 + m(1, 1) - m(0, 0) - m(2, 2));
+      q.set((m(0, 1) + m(1, 0)) / s, s / 4,
+            (m(1, 2) + m(2, 1)) / s, (m(0, 2) - m(2, 0)) / s);
+    } else {
+      const T s = 2 * std::sqrt(1 + m(2, 2) - m(0, 0) - m(1, 1));
+      q.set((m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s,
+            s / 4, (m(1, 0) - m(0, 1)) / s);
+    }
+    q.normalize();
+    // Dual part is half the translation times the rotation
+    const Vec3<T> t(m(0, 3), m(1, 3), m(2, 3));
+    const Vec3<T> r(q.x, q.y, q.z);
+    const Vec3<T> d = (t * q.w + t.cross(r)) / 2;
+    dual_quaternions_[i].real = q;
+    dual_quaternions_[i].dual.set(d.x, d.y, d.z, -t.dot(r) / 2);
+  }
+}
+
+#pragma mark Skinning
+
+template <class T>
+template <class InputIterator, class IndexIterator, class WeightIterator,
+          class OutputIterator>
+inline OutputIterator Skinner<T>::skinPositions(InputIterator first,
+                                                InputIterator last,
+                                                IndexIterator indices,
+                                                WeightIterator weights,
+                                                OutputIterator result) const {
+  for (; first != last; ++first, ++indices, ++weights, ++result) {
+    const Vec3<T> p(*first);
+    if (method_ == SkinningMethod::LINEAR) {
+      const Vec4<T> q = (blendMatrix(*indices, *weights) *
+                         Vec4<T>(p.x, p.y, p.z, 1));
+      *result = Vec3<T>(q.x, q.y, q.z);
+    } else {
+      const auto dq = blendDualQuaternion(*indices, *weights);
+      const Vec3<T> r(dq.real.x, dq.real.y, dq.real.z);
+      const Vec3<T> d(dq.dual.x, dq.dual.y, dq.dual.z);
+      const Vec3<T> t = (d * dq.real.w - r * dq.dual.w + r.cross(d)) * 2;
+      *result = rotate(dq.real, p) + t;
+    }
+  }
+  return result;
+}
+
+template <class T>
+template <class InputIterator, class IndexIterator, class WeightIterator,
+          class OutputIterator>
+inline OutputIterator Skinner<T>::skinNormals(InputIterator first,
+                                              InputIterator last,
+                                              IndexIterator indices,
+                                              WeightIterator weights,
+                                              OutputIterator result) const {
+  for (; first != last; ++first, ++indices, ++weights, ++result) {
+    const Vec3<T> n(*first);
+    if (method_ == SkinningMethod::LINEAR) {
+      const Vec4<T> q = (blendMatrix(*indices, *weights) *
+                         Vec4<T>(n.x, n.y, n.z, 0));
+      *result = Vec3<T>(q.x, q.y, q.z).normalize();
+    } else {
+      *result = rotate(blendDualQuaternion(*indices, *weights).real, n);
+    }
+  }
+  return result;
+}
+
+template <class T>
+inline Mat4<T> Skinner<T>::blendMatrix(const Vec4i& indices,
+                                       const Vec4<T>& weights) const {
+  Mat4<T> result;
+  for (int i = 0; i < 4; ++i) {
+    if (weights[i]) {
+      assert(0 <= indices[i] &&
+             static_cast<std::size_t>(indices[i]) < palette_.size());
+      result += palette_[indices[i]] * weights[i];
+    }
+  }
+  return result;
+}
+
+template <class T>
+inline typename Skinner<T>::DualQuaternion Skinner<T>::blendDualQuaternion(
+    const Vec4i& indices,
+    const Vec4<T>& weights) const {
+  DualQuaternion result{};
+  const Vec4<T>* pivot = nullptr;
+  for (int i = 0; i < 4; ++i) {
+    if (weights[i]) {
+      assert(0 <= indices[i] && static_cast<std::size_t>(indices[i]) <
+                                  dual_quaternions_.size());
+      const auto& dq = dual_quaternions_[indices[i]];
+      if (!pivot) {
+        pivot = &dq.real;
+      }
+      // Blend within the hemisphere of the first bone
+      const T weight = pivot->dot(dq.real) < 0 ? -weights[i] : weights[i];
+      result.real += dq.real * weight;
+      result.dual += dq.dual * weight;
+    }
+  }
+  const T length = result.real.magnitude();
+  if (length) {
+    result.real /= length;
+    result.dual /= length;
+  }
+  return result;
+}
+
+template <class T>
+inline Vec3<T> Skinner<T>::rotate(const Vec4<T>& quaternion,
+                                  const Vec3<T>& vector) {
+  const Vec3<T> r(quaternion.x, quaternion.y, quaternion.z);
+  return vector + r.cross(r.cross(vector) + vector * quaternion.w) * 2;
+}
+
+#pragma mark Stream
+
+inline std::ostream& operator<<(std::ostream& os, SkinningMethod method) {
+  switch (method) {
+    case SkinningMethod::LINEAR: os << "linear"; break;
+    case SkinningMethod::DUAL_QUATERNION: os << "dual quaternion"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+}  // namespace math
+
+using math::SkinningMethod;
+using math::Skinner;
+using math::Skinnerf;
+using math::Skinnerd;
+
+}  // namespace takram
+
+template <>
+struct std::hash<takram::math::SkinningMethod> {
+  std::size_t operator()(const takram::math::SkinningMethod& value) const {
+    return static_cast<std::underlying_type<
+        takram::math::SkinningMethod>::type>(value);
+  }
+};
+
+#endif  // TAKRAM_MATH_SKINNING_H_
@@ -0,0 +1,265 @@
+//
+//  takram/math/span.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_SPAN_H_
+#define TAKRAM_MATH_SPAN_H_
+
+#if TAKRAM_HAS_OPENCV
+#include "opencv2/core/core.hpp"
+#endif  // TAKRAM_HAS_OPENCV
+
+#if TAKRAM_HAS_OPENFRAMEWORKS
+#include "ofVec2f.h"
+#include "ofVec3f.h"
+#include "ofVec4f.h"
+#endif  // TAKRAM_HAS_OPENFRAMEWORKS
+
+#if TAKRAM_HAS_CINDER
+#include "cinder/Vector.h"
+#endif  // TAKRAM_HAS_CINDER
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "takram/math/rectangle.h"
+#include "takram/math/size.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Non-owning view of a contiguous array
+template <class T>
+class Span final {
+ public:
+  using Type = T;
+  using Iterator = T *;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+
+ public:
+  Span() : data_(), size_() {}
+  Span(T *data, std::size_t size) : data_(data), size_(size) {}
+  Span(T *first, T *last) : data_(first), size_(last - first) {}
+
+  // Implicit conversion
+  template <class U, typename std::enable_if<
+      std::is_convertible<U *, T *>::value &&
+      sizeof(U) == sizeof(T)>::type * = nullptr>
+  Span(const Span<U>& other) : data_(other.data()), size_(other.size()) {}
+
+  // Copy semantics
+  Span(const Span&) = default;
+  Span& operator=(const Span&) = default;
+
+  // Element access
+  T& operator[](std::size_t index) const { return at(index); }
+  T& at(std::size_t index) const;
+  T& front() const { return at(0); }
+  T& back() const { return at(size_ - 1); }
+
+  // Attributes
+  bool empty() const { return !size_; }
+  std::size_t size() const { return size_; }
+
+  // Iterator
+  Iterator begin() const { return data_; }
+  Iterator end() const { return data_ + size_; }
+  ReverseIterator rbegin() const { return ReverseIterator(end()); }
+  ReverseIterator rend() const { return ReverseIterator(begin()); }
+
+  // Pointer
+  T * data() const { return data_; }
+
+ private:
+  T *data_;
+  std::size_t size_;
+};
+
+// Whether an array of U can be viewed as an array of T in place. Types of
+// other libraries are compatible with the corresponding types of this library
+// when they are standard-layout with the same size and alignment, which
+// specializations check at compile time. Specialize this for other types that
+// share the layout of a type of this library.
+template <class T, class U, class = void>
+struct LayoutCompatible : std::false_type {};
+
+// Views an array of U as an array of T without copying. T must be const if U
+// is const.
+template <class T, class U>
+Span<T> reinterpretSpan(U *data, std::size_t size);
+template <class T, class Container>
+Span<T> reinterpretSpan(Container& container);
+
+// Views an array of U as an array of T without copying if their layouts are
+// compatible, and otherwise converts each element into the storage and
+// returns a view of it.
+template <class T, class U>
+Span<const T> adaptSpan(const U *data,
+                        std::size_t size,
+                        std::vector<T> *storage);
+template <class T, class Container>
+Span<const T> adaptSpan(const Container& container, std::vector<T> *storage);
+
+#pragma mark -
+
+namespace span {
+
+template <class T, class U>
+using SameLayout = std::integral_constant<bool, (
+    std::is_standard_layout<T>::value &&
+    std::is_standard_layout<U>::value &&
+    sizeof(T) == sizeof(U) &&
+    alignof(T) == alignof(U))>;
+
+template <class T, class U>
+inline Span<const T> adapt(const U *data,
+                           std::size_t size,
+                           std::vector<T> *storage,
+                           std::true_type) {
+  return reinterpretSpan<const T>(data, size);
+}
+
+template <class T, class U>
+inline Span<const T> adapt(const U *data,
+                           std::size_t size,
+                           std::vector<T> *storage,
+                           std::false_type) {
+  assert(storage);
+  storage->clear();
+  storage->reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    storage->emplace_back(static_cast<T>(data[i]));
+  }
+  return Span<const T>(storage->data(), storage->size());
+}
+
+}  // namespace span
+
+#pragma mark Layout compatibility
+
+template <class T>
+struct LayoutCompatible<T, T> : std::true_type {};
+
+#if TAKRAM_HAS_OPENCV
+
+template <class T>
+struct LayoutCompatible<Vec2<T>, cv::Point_<T>>
+    : span::SameLayout<Vec2<T>, cv::Point_<T>> {};
+template <class T>
+struct LayoutCompatible<Vec3<T>, cv::Point3_<T>>
+    : span::SameLayout<Vec3<T>, cv::Point3_<T>> {};
+template <class T, int D>
+struct LayoutCompatible<Vec<T, D>, cv::Vec<T, D>>
+    : span::SameLayout<Vec<T, D>, cv::Vec<T, D>> {};
+template <class T>
+struct LayoutCompatible<Size2<T>, cv::Size_<T>>
+    : span::SameLayout<Size2<T>, cv::Size_<T>> {};
+template <class T>
+struct LayoutCompatible<Rect2<T>, cv::Rect_<T>>
+    : span::SameLayout<Rect2<T>, cv::Rect_<T>> {};
+
+#endif  // TAKRAM_HAS_OPENCV
+
+#if TAKRAM_HAS_OPENFRAMEWORKS
+
+template <>
+struct LayoutCompatible<Vec2<float>, ofVec2f>
+    : span::SameLayout<Vec2<float>, ofVec2f> {};
+template <>
+struct LayoutCompatible<Vec3<float>, ofVec3f>
+    : span::SameLayout<Vec3<float>, ofVec3f> {};
+template <>
+struct LayoutCompatible<Vec4<float>, ofVec4f>
+    : span::SameLayout<Vec4<float>, ofVec4f> {};
+
+#endif  // TAKRAM_HAS_OPENFRAMEWORKS
+
+#if TAKRAM_HAS_CINDER
+
+template <class T>
+struct LayoutCompatible<Vec2<T>, ci::Vec2<T>>
+    : span::SameLayout<Vec2<T>, ci::Vec2<T>> {};
+template <class T>
+struct LayoutCompatible<Vec3<T>, ci::Vec3<T>>
+    : span::SameLayout<Vec3<T>, ci::Vec3<T>> {};
+template <class T>
+struct LayoutCompatible<Vec4<T>, ci::Vec4<T>>
+    : span::SameLayout<Vec4<T>, ci::Vec4<T>> {};
+
+#endif  // TAKRAM_HAS_CINDER
+
+#pragma mark Element access
+
+template <class T>
+inline T& Span<T>::at(std::size_t index) const {
+  assert(index < size_);
+  return data_[index];
+}
+
+#pragma mark Adaptors
+
+template <class T, class U>
+inline Span<T> reinterpretSpan(U *data, std::size_t size) {
+  static_assert(std::is_const<T>::value || !std::is_const<U>::value,
+                "Cannot view an array of const elements as mutable");
+  static_assert(LayoutCompatible<typename std::remove_const<T>::type,
+                                 typename std::remove_const<U>::type>::value,
+                "Layouts are not compatible");
+  return Span<T>(reinterpret_cast<T *>(data), size);
+}
+
+template <class T, class Container>
+inline Span<T> reinterpretSpan(Container& container) {
+  return reinterpretSpan<T>(container.data(), container.size());
+}
+
+template <class T, class U>
+inline Span<const T> adaptSpan(const U *data,
+                               std::size_t size,
+                               std::vector<T> *storage) {
+  return span::adapt(data, size, storage, LayoutCompatible<T, U>());
+}
+
+template <class T, class Container>
+inline Span<const T> adaptSpan(const Container& container,
+                               std::vector<T> *storage) {
+  return adaptSpan(container.data(), container.size(), storage);
+}
+
+}  // namespace math
+
+using math::Span;
+using math::LayoutCompatible;
+using math::reinterpretSpan;
+using math::adaptSpan;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_SPAN_H_
@@ -0,0 +1,208 @@
+//
+//  takram/math/statistics.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_STATISTICS_H_
+#define TAKRAM_MATH_STATISTICS_H_
+
+#include <cassert>
+#include <cstddef>
+
+#include "takram/math/decomposition.h"
+#include "takram/math/matrix.h"
+#include "takram/math/promotion.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Mean and covariance of points, updated one point at a time by Welford's
+// method, which stays accurate for large clouds far from the origin where
+// summing raw moments would cancel. Statistics of disjoint subsets, for
+// example computed on separate threads, combine by merge() with the pairwise
+// update of Chan et al. Ranges of points are accumulated in blocks of plain
+// sums and cross-products relative to the first point of each block, and each
+// block is then merged in.
+template <class T, int D>
+class PointStatistics final {
+ public:
+  using Type = T;
+  static constexpr const int dimensions = D;
+
+ public:
+  PointStatistics();
+  template <class InputIterator>
+  PointStatistics(InputIterator first, InputIterator last);
+
+  // Copy semantics
+  PointStatistics(const PointStatistics&) = default;
+  PointStatistics& operator=(const PointStatistics&) = default;
+
+  // Accumulation
+  template <class U>
+  void add(const Vec<U, D>& point);
+  template <class InputIterator>
+  void add(InputIterator first, InputIterator last);
+  void merge(const PointStatistics& other);
+  void reset();
+  std::size_t count() const { return count_; }
+
+  // Statistics
+  const Vec<Promote<T>, D>& mean() const { return mean_; }
+  Mat<Promote<T>, D> covariance() const;
+  void principalComponents(Vec<Promote<T>, D> *variances,
+                           Mat<Promote<T>, D> *axes) const;
+
+ private:
+  using R = Promote<T>;
+  static constexpr const std::size_t block_size = 1024;
+
+ private:
+  std::size_t count_;
+  Vec<R, D> mean_;
+  Mat<R, D> comoment_;
+};
+
+template <class T>
+using PointStatistics2 = PointStatistics<T, 2>;
+template <class T>
+using PointStatistics3 = PointStatistics<T, 3>;
+
+using PointStatistics2f = PointStatistics2<float>;
+using PointStatistics2d = PointStatistics2<double>;
+using PointStatistics3f = PointStatistics3<float>;
+using PointStatistics3d = PointStatistics3<double>;
+
+#pragma mark -
+
+template <class T, int D>
+inline PointStatistics<T, D>::PointStatistics()
+    : count_(),
+      mean_(),
+      comoment_() {}
+
+template <class T, int D>
+template <class InputIterator>
+inline PointStatistics<T, D>::PointStatistics(InputIterator first,
+                                              InputIterator last)
+    : count_(),
+      mean_(),
+      comoment_() {
+  add(first, last);
+}
+
+#pragma mark Accumulation
+
+template <class T, int D>
+template <class U>
+inline void PointStatistics<T, D>::add(const Vec<U, D>& point) {
+  ++count_;
+  const Vec<R, D> delta = point - mean_;
+  mean_ += delta / R(count_);
+  const Vec<R, D> residual = point - mean_;
+  for (int i = 0; i < D; ++i) {
+    comoment_[i] += residual * delta[i];
+  }
+}
+
+template <class T, int D>
+template <class InputIterator>
+inline void PointStatistics<T, D>::add(InputIterator first,
+                                       InputIterator last) {
+  PointStatistics block;
+  while (first != last) {
+    const Vec<R, D> shift(*first);
+    Vec<R, D> sums;
+    Mat<R, D> products;
+    std::size_t count{};
+    for (; first != last && count < block_size; ++first, ++count) {
+      const Vec<R, D> delta = *first - shift;
+      sums += delta;
+      for (int i = 0; i < D; ++i) {
+        products[i] += delta * delta[i];
+      }
+    }
+    block.count_ = count;
+    block.mean_ = shift + sums / R(count);
+    block.comoment_ = products - Mat<R, D>::outer(sums, sums) / R(count);
+    merge(block);
+  }
+}
+
+template <class T, int D>
+inline void PointStatistics<T, D>::merge(const PointStatistics& other) {
+  if (!other.count_) {
+    return;
+  }
+  if (!count_) {
+    *this = other;
+    return;
+  }
+  const R n1 = count_;
+  const R n2 = other.count_;
+  const R n = n1 + n2;
+  const Vec<R, D> delta = other.mean_ - mean_;
+  mean_ += delta * (n2 / n);
+  comoment_ += other.comoment_;
+  comoment_ += Mat<R, D>::outer(delta, delta) * (n1 * n2 / n);
+  count_ += other.count_;
+}
+
+template <class T, int D>
+inline void PointStatistics<T, D>::reset() {
+  *this = PointStatistics();
+}
+
+#pragma mark Statistics
+
+template <class T, int D>
+inline Mat<Promote<T>, D> PointStatistics<T, D>::covariance() const {
+  if (!count_) {
+    return Mat<R, D>();
+  }
+  return comoment_ / R(count_);
+}
+
+template <class T, int D>
+inline void PointStatistics<T, D>::principalComponents(
+    Vec<Promote<T>, D> *variances,
+    Mat<Promote<T>, D> *axes) const {
+  decomposeSymmetric(covariance(), variances, axes);
+}
+
+}  // namespace math
+
+using math::PointStatistics;
+using math::PointStatistics2;
+using math::PointStatistics3;
+using math::PointStatistics2f;
+using math::PointStatistics2d;
+using math::PointStatistics3f;
+using math::PointStatistics3d;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_STATISTICS_H_
@@ -0,0 +1,591 @@
+//
+//  takram/math/stroke.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_STROKE_H_
+#define TAKRAM_MATH_STROKE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "takram/math/constants.h"
+#include "takram/math/triangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+enum class StrokeJoin : int {
+  MITER = 0,
+  ROUND = 1,
+  BEVEL = 2
+};
+
+enum class StrokeCap : int {
+  BUTT = 0,
+  ROUND = 1,
+  SQUARE = 2
+};
+
+// Converts polylines into triangles. Triangles are emitted in counterclockwise
+// order, either directly as Triangle2 values or as an indexed vertex buffer.
+// Round joins and caps are built from a fan of rotations precomputed when the
+// number of segments per half circle is set.
+template <class T>
+class Stroker final {
+ public:
+  using Type = T;
+  using Index = std::uint32_t;
+
+ public:
+  Stroker();
+  explicit Stroker(T width,
+                   StrokeJoin join = StrokeJoin::MITER,
+                   StrokeCap cap = StrokeCap::BUTT,
+                   T miter_limit = 4,
+                   int segments = 8);
+
+  // Copy semantics
+  Stroker(const Stroker&) = default;
+  Stroker& operator=(const Stroker&) = default;
+
+  // Parameters
+  T width() const { return width_; }
+  void setWidth(T value) { width_ = value; }
+  StrokeJoin join() const { return join_; }
+  void setJoin(StrokeJoin value) { join_ = value; }
+  StrokeCap cap() const { return cap_; }
+  void setCap(StrokeCap value) { cap_ = value; }
+  T miterLimit() const { return miter_limit_; }
+  void setMiterLimit(T value) { miter_limit_ = value; }
+  int segments() const { return static_cast<int>(fan_.size()) - 1; }
+  void setSegments(int value);
+
+  // Capacity
+  template <class ForwardIterator>
+  std::pair<std::size_t, std::size_t> capacity(ForwardIterator first,
+                                               ForwardIterator last,
+                                               bool closed = false) const;
+  template <class RandomAccessIterator, class OffsetIterator>
+  std::pair<std::size_t, std::size_t> capacity(RandomAccessIterator points,
+                                               OffsetIterator first,
+                                               OffsetIterator last,
+                                               bool closed = false) const;
+
+  // Stroking
+  template <class ForwardIterator, class OutputIterator>
+  OutputIterator stroke(ForwardIterator first,
+                        ForwardIterator last,
+                        bool closed,
+                        OutputIterator result) const;
+  template <class ForwardIterator>
+  void stroke(ForwardIterator first,
+              ForwardIterator last,
+              bool closed,
+              std::vector<Vec2<T>> *vertices,
+              std::vector<Index> *indices) const;
+  template <class RandomAccessIterator, class OffsetIterator>
+  void stroke(RandomAccessIterator points,
+              OffsetIterator first,
+              OffsetIterator last,
+              bool closed,
+              std::vector<Vec2<T>> *vertices,
+              std::vector<Index> *indices) const;
+
+ private:
+  struct Vertex {
+    Vec2<T> position;
+    Index index;
+  };
+
+  template <class OutputIterator>
+  class TriangleSink;
+  class IndexedSink;
+
+  template <class ForwardIterator, class Sink>
+  void emit(ForwardIterator first,
+            ForwardIterator last,
+            bool closed,
+            Sink *sink) const;
+  template <class Sink>
+  void emitTriangle(const Vertex& a,
+                    const Vertex& b,
+                    const Vertex& c,
+                    Sink *sink) const;
+  template <class Sink>
+  void emitJoin(const Vec2<T>& point,
+                const Vec2<T>& incoming,
+                const Vec2<T>& outgoing,
+                const Vertex& left0,
+                const Vertex& right0,
+                const Vertex& left1,
+                const Vertex& right1,
+                Sink *sink) const;
+  template <class Sink>
+  void emitCap(const Vec2<T>& point,
+               const Vec2<T>& direction,
+               const Vertex& left,
+               const Vertex& right,
+               bool end,
+               Sink *sink) const;
+  template <class Sink>
+  void emitFan(const Vertex& center,
+               const Vertex& from,
+               const Vertex& to,
+               int steps,
+               T sign,
+               Sink *sink) const;
+
+ private:
+  T width_;
+  StrokeJoin join_;
+  StrokeCap cap_;
+  T miter_limit_;
+  std::vector<Vec2<T>> fan_;
+};
+
+#pragma mark -
+
+template <class T>
+template <class OutputIterator>
+class Stroker<T>::TriangleSink final {
+ public:
+  explicit TriangleSink(OutputIterator result) : result(result) {}
+
+  Vertex vertex(const Vec2<T>& position) {
+    return Vertex{position, Index()};
+  }
+
+  void triangle(const Vertex& a, const Vertex& b, const Vertex& c) {
+    *result = Triangle2<T>(a.position, b.position, c.position);
+    ++result;
+  }
+
+ public:
+  OutputIterator result;
+};
+
+template <class T>
+class Stroker<T>::IndexedSink final {
+ public:
+  IndexedSink(std::vector<Vec2<T>> *vertices, std::vector<Index> *indices)
+      : vertices(vertices),
+        indices(indices) {}
+
+  Vertex vertex(const Vec2<T>& position) {
+    vertices->push_back(position);
+    return Vertex{position, static_cast<Index>(vertices->size() - 1)};
+  }
+
+  void triangle(const Vertex& a, const Vertex& b, const Vertex& c) {
+    indices->push_back(a.index);
+    indices->push_back(b.index);
+    indices->push_back(c.index);
+  }
+
+ public:
+  std::vector<Vec2<T>> *vertices;
+  std::vector<Index> *indices;
+};
+
+#pragma mark -
+
+template <class T>
+inline Stroker<T>::Stroker() : Stroker(1) {}
+
+template <class T>
+inline Stroker<T>::Stroker(T width,
+                           StrokeJoin join,
+                           StrokeCap cap,
+                           T miter_limit,
+                           int segments)
+    : width_(width),
+      join_(join),
+      cap_(cap),
+      miter_limit_(miter_limit) {
+  setSegments(segments);
+}
+
+#pragma mark Parameters
+
+template <class T>
+inline void Stroker<T>::setSegments(int value) {
+  assert(value > 0);
+  fan_.resize(value + 1);
+  for (int i = 0; i <= value; ++i) {
+    fan_[i] = Vec2<T>::heading(pi<Promote<T>>() * i / value);
+  }
+}
+
+#pragma mark Capacity
+
+template <class T>
+template <class ForwardIterator>
+inline std::pair<std::size_t, std::size_t> Stroker<T>::capacity(
+    ForwardIterator first,
+    ForwardIterator last,
+    bool closed) const {
+  const std::size_t points = std::distance(first, last);
+  if (points < 2) {
+    return std::make_pair(0, 0);
+  }
+  const std::size_t fan = segments();
+  const std::size_t lines = closed ? points : points - 1;
+  const std::size_t joins = closed ? points : points - 2;
+  std::size_t vertices = lines * 4;
+  std::size_t triangles = lines * 2;
+  if (join_ == StrokeJoin::ROUND) {
+    vertices += joins * (fan + 1);
+    triangles += joins * fan;
+  } else {
+    vertices += joins * 2;
+    triangles += joins * 2;
+  }
+  if (!closed) {
+    if (cap_ == StrokeCap::ROUND) {
+      vertices += 2 * (fan + 1);
+      triangles += 2 * fan;
+    } else if (cap_ == StrokeCap::SQUARE) {
+      vertices += 2 * 2;
+      triangles += 2 * 2;
+    }
+  }
+  return std::make_pair(vertices, triangles * 3);
+}
+
+template <class T>
+template <class RandomAccessIterator, class OffsetIterator>
+inline std::pair<std::size_t, std::size_t> Stroker<T>::capacity(
+    RandomAccessIterator points,
+    OffsetIterator first,
+    OffsetIterator last,
+    bool closed) const {
+  std::pair<std::size_t, std::size_t> result;
+  if (first == last) {
+    return result;
+  }
+  for (auto next = std::next(first); next != last; first = next++) {
+    const auto size = capacity(points + *first, points + *next, closed);
+    result.first += size.first;
+    result.second += size.second;
+  }
+  return result;
+}
+
+#pragma mark Stroking
+
+template <class T>
+template <class ForwardIterator, class OutputIterator>
+inline OutputIterator Stroker<T>::stroke(ForwardIterator first,
+                                         ForwardIterator last,
+                                         bool closed,
+                                         OutputIterator result) const {
+  TriangleSink<OutputIterator> sink(result);
+  emit(first, last, closed, &sink);
+  return sink.result;
+}
+
+template <class T>
+template <class ForwardIterator>
+inline void Stroker<T>::stroke(ForwardIterator first,
+                               ForwardIterator last,
+                               bool closed,
+                               std::vector<Vec2<T>> *vertices,
+                               std::vector<Index> *indices) const {
+  assert(vertices);
+  assert(indices);
+  const auto size = capacity(first, last, closed);
+  vertices->reserve(vertices->size() + size.first);
+  indices->reserve(indices->size() + size.second);
+  IndexedSink sink(vertices, indices);
+  emit(first, last, closed, &sink);
+}
+
+template <class T>
+template <class RandomAccessIterator, class OffsetIterator>
+inline void Stroker<T>::stroke(RandomAccessIterator points,
+                               OffsetIterator first,
+                               OffsetIterator last,
+                               bool closed,
+                               std::vector<Vec2<T>> *vertices,
+                               std::vector<Index> *indices) const {
+  assert(vertices);
+  assert(indices);
+  if (first == last) {
+    return;
+  }
+  const auto size = capacity(points, first, last, closed);
+  vertices->reserve(vertices->size() + size.first);
+  indices->reserve(indices->size() + size.second);
+  IndexedSink sink(vertices, indices);
+  for (auto next = std::next(first); next != last; first = next++) {
+    emit(points + *first, points + *next, closed, &sink);
+  }
+}
+
+#pragma mark Emission
+
+template <class T>
+template <class ForwardIterator, class Sink>
+inline void Stroker<T>::emit(ForwardIterator first,
+                             ForwardIterator last,
+                             bool closed,
+                             Sink *sink) const {
+  if (first == last) {
+    return;
+  }
+  const T half = width_ / 2;
+  const Vec2<T> origin = *first;
+  Vec2<T> previous = origin;
+  Vec2<T> first_direction;
+  Vec2<T> direction;
+  Vertex first_left{}, first_right{}, left{}, right{};
+  std::size_t count = 0;
+  const auto segment = [&](const Vec2<T>& point) {
+    const Vec2<T> current = (point - previous).normalize();
+    const Vec2<T> normal = Vec2<T>(-current.y, current.x) * half;
+    const auto left0 = sink->vertex(previous + normal);
+    const auto right0 = sink->vertex(previous - normal);
+    const auto left1 = sink->vertex(point + normal);
+    const auto right1 = sink->vertex(point - normal);
+    emitTriangle(right0, left1, left0, sink);
+    emitTriangle(right0, right1, left1, sink);
+    if (count++) {
+      emitJoin(previous, direction, current,
+               left, right, left0, right0, sink);
+    } else {
+      first_direction = current;
+      first_left = left0;
+      first_right = right0;
+    }
+    direction = current;
+    left = left1;
+    right = right1;
+    previous = point;
+  };
+  for (++first; first != last; ++first) {
+    const Vec2<T> point = *first;
+    if (point != previous) {
+      segment(point);
+    }
+  }
+  if (!count) {
+    return;
+  }
+  if (closed) {
+    if (previous != origin) {
+      segment(origin);
+    }
+    if (count > 1) {
+      emitJoin(origin, direction, first_direction,
+               left, right, first_left, first_right, sink);
+    }
+  } else {
+    emitCap(origin, first_direction, first_left, first_right, false, sink);
+    emitCap(previous, direction, left, right, true, sink);
+  }
+}
+
+template <class T>
+template <class Sink>
+inline void Stroker<T>::emitTriangle(const Vertex& a,
+                                     const Vertex& b,
+                                     const Vertex& c,
+                                     Sink *sink) const {
+  if ((b.position - a.position).cross(c.position - a.position) < 0) {
+    sink->triangle(a, c, b);
+  } else {
+    sink->triangle(a, b, c);
+  }
+}
+
+template <class T>
+template <class Sink>
+inline void Stroker<T>::emitJoin(const Vec2<T>& point,
+                                 const Vec2<T>& incoming,
+                                 const Vec2<T>& outgoing,
+                                 const Vertex& left0,
+                                 const Vertex& right0,
+                                 const Vertex& left1,
+                                 const Vertex& right1,
+                                 Sink *sink) const {
+  const T cross = incoming.cross(outgoing);
+  const T dot = incoming.dot(outgoing);
+  if (!cross && dot > 0) {
+    return;
+  }
+  // The outer side of a left turn is on the right, and vice versa
+  const bool left_turn = cross >= 0;
+  const auto& from = left_turn ? right0 : left0;
+  const auto& to = left_turn ? right1 : left1;
+  const auto center = sink->vertex(point);
+  switch (join_) {
+    case StrokeJoin::MITER: {
+      const T half = width_ / 2;
+      const auto bisector = ((from.position - point) +
+                             (to.position - point)).normalize();
+      const T cosine = bisector.dot(from.position - point) / half;
+      if (cosine > 0 && 1 / cosine <= miter_limit_) {
+        const auto miter = sink->vertex(point + bisector * (half / cosine));
+        emitTriangle(center, from, miter, sink);
+        emitTriangle(center, miter, to, sink);
+        break;
+      }
+      emitTriangle(center, from, to, sink);
+      break;
+    }
+    case StrokeJoin::ROUND: {
+      const int fan = segments();
+      const auto angle = std::atan2(std::abs(cross), dot);
+      const int steps = std::max(1, std::min(fan, static_cast<int>(
+          std::ceil(angle * fan / pi<Promote<T>>()))));
+      emitFan(center, from, to, steps, left_turn ? 1 : -1, sink);
+      break;
+    }
+    case StrokeJoin::BEVEL:
+      emitTriangle(center, from, to, sink);
+      break;
+    default:
+      assert(false);
+      break;
+  }
+}
+
+template <class T>
+template <class Sink>
+inline void Stroker<T>::emitCap(const Vec2<T>& point,
+                                const Vec2<T>& direction,
+                                const Vertex& left,
+                                const Vertex& right,
+                                bool end,
+                                Sink *sink) const {
+  switch (cap_) {
+    case StrokeCap::BUTT:
+      break;
+    case StrokeCap::ROUND: {
+      const auto center = sink->vertex(point);
+      if (end) {
+        emitFan(center, left, right, segments(), -1, sink);
+      } else {
+        emitFan(center, right, left, segments(), -1, sink);
+      }
+      break;
+    }
+    case StrokeCap::SQUARE: {
+      const auto offset = direction * (end ? width_ / 2 : -width_ / 2);
+      const auto outer_left = sink->vertex(left.position + offset);
+      const auto outer_right = sink->vertex(right.position + offset);
+      emitTriangle(left, right, outer_right, sink);
+      emitTriangle(left, outer_right, outer_left, sink);
+      break;
+    }
+    default:
+      assert(false);
+      break;
+  }
+}
+
+template <class T>
+template <class Sink>
+inline void Stroker<T>::emitFan(const Vertex& center,
+                                const Vertex& from,
+                                const Vertex& to,
+                                int steps,
+                                T sign,
+                                Sink *sink) const {
+  const Vec2<T> radius = from.position - center.position;
+  auto previous = from;
+  for (int i = 1; i < steps; ++i) {
+    const auto& rotation = fan_[i];
+    const Vec2<T> offset(radius.x * rotation.x - sign * radius.y * rotation.y,
+                         sign * radius.x * rotation.y + radius.y * rotation.x);
+    const auto current = sink->vertex(center.position + offset);
+    emitTriangle(center, previous, current, sink);
+    previous = current;
+  }
+  emitTriangle(center, previous, to, sink);
+}
+
+#pragma mark Stream
+
+inline std::ostream& operator<<(std::ostream& os, StrokeJoin join) {
+  switch (join) {
+    case StrokeJoin::MITER: os << "miter"; break;
+    case StrokeJoin::ROUND: os << "round"; break;
+    case StrokeJoin::BEVEL: os << "bevel"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+inline std::ostream& operator<<(std::ostream& os, StrokeCap cap) {
+  switch (cap) {
+    case StrokeCap::BUTT: os << "butt"; break;
+    case StrokeCap::ROUND: os << "round"; break;
+    case StrokeCap::SQUARE: os << "square"; break;
+    default:
+      assert(false);
+      break;
+  }
+  return os;
+}
+
+}  // namespace math
+
+using math::StrokeJoin;
+using math::StrokeCap;
+using math::Stroker;
+
+}  // namespace takram
+
+template <>
+struct std::hash<takram::math::StrokeJoin> {
+  std::size_t operator()(const takram::math::StrokeJoin& value) const {
+    return static_cast<std::underlying_type<
+        takram::math::StrokeJoin>::type>(value);
+  }
+};
+
+template <>
+struct std::hash<takram::math::StrokeCap> {
+  std::size_t operator()(const takram::math::StrokeCap& value) const {
+    return static_cast<std::underlying_type<
+        takram::math::StrokeCap>::type>(value);
+  }
+};
+
+#endif  // TAKRAM_MATH_STROKE_H_
@@ -0,0 +1,189 @@
+//
+//  takram/math/support.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_SUPPORT_H_
+#define TAKRAM_MATH_SUPPORT_H_
+
+#include <cassert>
+#include <iterator>
+
+#include "takram/math/circle.h"
+#include "takram/math/line.h"
+#include "takram/math/promotion.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/triangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// A convex shape participates in the convex queries by providing an overload
+// of support(shape, direction) that returns its farthest point along the given
+// direction. Overloads are looked up by argument-dependent lookup, so shapes
+// outside this library can be supported in their own namespaces.
+
+template <class Iterator>
+class Hull final {
+ public:
+  using Point = typename std::iterator_traits<Iterator>::value_type;
+  using Type = typename Point::Type;
+  static constexpr const auto dimensions = Point::dimensions;
+
+ public:
+  Hull(Iterator first, Iterator last) : first(first), last(last) {}
+
+  // Copy semantics
+  Hull(const Hull&) = default;
+  Hull& operator=(const Hull&) = default;
+
+ public:
+  Iterator first;
+  Iterator last;
+};
+
+template <class Shape, class T>
+class Rounded final {
+ public:
+  using Type = T;
+
+ public:
+  Rounded(const Shape& shape, T radius) : shape(shape), radius(radius) {}
+
+  // Copy semantics
+  Rounded(const Rounded&) = default;
+  Rounded& operator=(const Rounded&) = default;
+
+ public:
+  Shape shape;
+  T radius;
+};
+
+template <class Iterator>
+Hull<Iterator> makeHull(Iterator first, Iterator last);
+template <class Shape, class T>
+Rounded<Shape, T> makeRounded(const Shape& shape, T radius);
+
+template <class T, int D, class U>
+Vec<T, D> support(const Vec<T, D>& point, const Vec<U, D>& direction);
+template <class T, int D, class U>
+Vec<T, D> support(const Line<T, D>& line, const Vec<U, D>& direction);
+template <class T, int D, class U>
+Vec<T, D> support(const Triangle<T, D>& triangle,
+                  const Vec<U, D>& direction);
+template <class T, class U>
+Vec2<T> support(const Rect2<T>& rect, const Vec2<U>& direction);
+template <class T, class U>
+Vec2<Promote<T, U>> support(const Circle2<T>& circle,
+                            const Vec2<U>& direction);
+template <class Iterator, class U, int D>
+typename Hull<Iterator>::Point support(const Hull<Iterator>& hull,
+                                       const Vec<U, D>& direction);
+template <class Shape, class T, class U, int D>
+Vec<Promote<T, U>, D> support(const Rounded<Shape, T>& rounded,
+                              const Vec<U, D>& direction);
+
+#pragma mark -
+
+template <class Iterator>
+inline Hull<Iterator> makeHull(Iterator first, Iterator last) {
+  return Hull<Iterator>(first, last);
+}
+
+template <class Shape, class T>
+inline Rounded<Shape, T> makeRounded(const Shape& shape, T radius) {
+  return Rounded<Shape, T>(shape, radius);
+}
+
+#pragma mark Support functions
+
+template <class T, int D, class U>
+inline Vec<T, D> support(const Vec<T, D>& point, const Vec<U, D>& direction) {
+  return point;
+}
+
+template <class T, int D, class U>
+inline Vec<T, D> support(const Line<T, D>& line, const Vec<U, D>& direction) {
+  return line.a.dot(direction) < line.b.dot(direction) ? line.b : line.a;
+}
+
+template <class T, int D, class U>
+inline Vec<T, D> support(const Triangle<T, D>& triangle,
+                         const Vec<U, D>& direction) {
+  const auto a = triangle.a.dot(direction);
+  const auto b = triangle.b.dot(direction);
+  const auto c = triangle.c.dot(direction);
+  if (a < b) {
+    return b < c ? triangle.c : triangle.b;
+  }
+  return a < c ? triangle.c : triangle.a;
+}
+
+template <class T, class U>
+inline Vec2<T> support(const Rect2<T>& rect, const Vec2<U>& direction) {
+  return Vec2<T>(direction.x < 0 ? rect.minX() : rect.maxX(),
+                 direction.y < 0 ? rect.minY() : rect.maxY());
+}
+
+template <class T, class U>
+inline Vec2<Promote<T, U>> support(const Circle2<T>& circle,
+                                   const Vec2<U>& direction) {
+  return circle.center + direction.normalized() * circle.radius;
+}
+
+template <class Iterator, class U, int D>
+inline typename Hull<Iterator>::Point support(const Hull<Iterator>& hull,
+                                              const Vec<U, D>& direction) {
+  assert(hull.first != hull.last);
+  auto result = hull.first;
+  auto max = result->dot(direction);
+  for (auto itr = std::next(hull.first); itr != hull.last; ++itr) {
+    const auto value = itr->dot(direction);
+    if (value > max) {
+      max = value;
+      result = itr;
+    }
+  }
+  return *result;
+}
+
+template <class Shape, class T, class U, int D>
+inline Vec<Promote<T, U>, D> support(const Rounded<Shape, T>& rounded,
+                                     const Vec<U, D>& direction) {
+  return (support(rounded.shape, direction) +
+          direction.normalized() * rounded.radius);
+}
+
+}  // namespace math
+
+using math::Hull;
+using math::Rounded;
+using math::makeHull;
+using math::makeRounded;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_SUPPORT_H_
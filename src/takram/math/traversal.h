@@ -0,0 +1,239 @@
+//
+//  takram/math/traversal.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_TRAVERSAL_H_
+#define TAKRAM_MATH_TRAVERSAL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "takram/math/line.h"
+#include "takram/math/size.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Visits the cells of a regular grid crossed by a line segment in order, each
+// exactly once (Amanatides and Woo). Cells are addressed by integer
+// coordinates relative to the grid origin and are not bounded; callers clip
+// against their own resolution. Parameters along the segment range from 0 at
+// its first point to 1 at the second one. Cell coordinates are clamped to
+// plus or minus 2^30, and a segment with a non-finite coordinate visits no
+// cells.
+template <class T, int D>
+class GridTraversal final {
+  static_assert(std::is_floating_point<T>::value,
+                "Grid traversal requires a floating-point type");
+
+ public:
+  using Type = T;
+  using Cell = Vec<int, D>;
+  static constexpr const int dimensions = D;
+
+ public:
+  GridTraversal();
+  GridTraversal(const Line<T, D>& line,
+                const Vec<T, D>& origin,
+                const Size<T, D>& size);
+
+  // Copy semantics
+  GridTraversal(const GridTraversal&) = default;
+  GridTraversal& operator=(const GridTraversal&) = default;
+
+  // Mutators
+  void set(const Line<T, D>& line,
+           const Vec<T, D>& origin,
+           const Size<T, D>& size);
+
+  // Traversal
+  bool done() const { return done_; }
+  void next();
+  const Cell& cell() const { return cell_; }
+  T entry() const { return entry_; }
+  T exit() const { return exit_; }
+
+ private:
+  Cell cell_;
+  Cell step_;
+  Vec<T, D> delta_;
+  Vec<T, D> max_;
+  T entry_;
+  T exit_;
+  bool done_;
+};
+
+template <class T, int D, class Function>
+void traverse(const Line<T, D>& line,
+              const Vec<T, D>& origin,
+              const Size<T, D>& size,
+              Function function);
+template <class T, int D, class InputIterator, class Function>
+void traverse(InputIterator first,
+              InputIterator last,
+              const Vec<T, D>& origin,
+              const Size<T, D>& size,
+              Function function);
+
+using GridTraversal2f = GridTraversal<float, 2>;
+using GridTraversal2d = GridTraversal<double, 2>;
+using GridTraversal3f = GridTraversal<float, 3>;
+using GridTraversal3d = GridTraversal<double, 3>;
+
+#pragma mark -
+
+template <class T, int D>
+inline GridTraversal<T, D>::GridTraversal()
+    : cell_(),
+      step_(),
+      delta_(),
+      max_(),
+      entry_(),
+      exit_(),
+      done_(true) {}
+
+template <class T, int D>
+inline GridTraversal<T, D>::GridTraversal(const Line<T, D>& line,
+                                          const Vec<T, D>& origin,
+                                          const Size<T, D>& size) {
+  set(line, origin, size);
+}
+
+#pragma mark Mutators
+
+template <class T, int D>
+inline void GridTraversal<T, D>::set(const Line<T, D>& line,
+                                     const Vec<T, D>& origin,
+                                     const Size<T, D>& size) {
+  const T infinity = std::numeric_limits<T>::infinity();
+  const T limit = static_cast<T>(1 << 30);
+  for (int axis = 0; axis < D; ++axis) {
+    const T position = line.a[axis] - origin[axis];
+    const T direction = line.b[axis] - line.a[axis];
+    const T cell = std::floor(position / size[axis]);
+    if (!std::isfinite(cell) || !std::isfinite(direction)) {
+      *this = GridTraversal();
+      return;
+    }
+    // Clamp before converting to int, since the segment can start arbitrarily
+    // far from the origin
+    cell_[axis] = static_cast<int>(std::min(std::max(cell, -limit), limit));
+    if (direction > 0) {
+      step_[axis] = 1;
+      delta_[axis] = size[axis] / direction;
+      max_[axis] = ((cell_[axis] + 1) * size[axis] - position) / direction;
+    } else if (direction < 0) {
+      step_[axis] = -1;
+      delta_[axis] = -size[axis] / direction;
+      max_[axis] = (cell_[axis] * size[axis] - position) / direction;
+    } else {
+      step_[axis] = 0;
+      delta_[axis] = infinity;
+      max_[axis] = infinity;
+    }
+  }
+  entry_ = T();
+  exit_ = std::min(*std::min_element(max_.begin(), max_.end()), T(1));
+  done_ = false;
+}
+
+#pragma mark Traversal
+
+template <class T, int D>
+inline void GridTraversal<T, D>::next() {
+  const int axis = static_cast<int>(
+      std::min_element(max_.begin(), max_.end()) - max_.begin());
+  if (max_[axis] >= 1 || cell_[axis] == step_[axis] * (1 << 30)) {
+    entry_ = exit_;
+    done_ = true;
+    return;
+  }
+  entry_ = max_[axis];
+  cell_[axis] += step_[axis];
+  max_[axis] += delta_[axis];
+  exit_ = std::min(*std::min_element(max_.begin(), max_.end()), T(1));
+}
+
+template <class T, int D, class Function>
+inline void traverse(const Line<T, D>& line,
+                     const Vec<T, D>& origin,
+                     const Size<T, D>& size,
+                     Function function) {
+  for (GridTraversal<T, D> traversal(line, origin, size);
+       !traversal.done() && function(traversal);
+       traversal.next()) {}
+}
+
+// Marches a batch of segments in lockstep, one cell of every live segment per
+// round, so that segments starting close to each other also touch neighboring
+// cells close in time. The function receives the index of the segment in the
+// range and its traversal, and returns false to stop that segment.
+template <class T, int D, class InputIterator, class Function>
+inline void traverse(InputIterator first,
+                     InputIterator last,
+                     const Vec<T, D>& origin,
+                     const Size<T, D>& size,
+                     Function function) {
+  std::vector<GridTraversal<T, D>> traversals;
+  std::vector<std::size_t> live;
+  for (auto itr = first; itr != last; ++itr) {
+    traversals.emplace_back(*itr, origin, size);
+    if (!traversals.back().done()) {
+      live.emplace_back(traversals.size() - 1);
+    }
+  }
+  while (!live.empty()) {
+    auto end = live.begin();
+    for (const auto index : live) {
+      auto& traversal = traversals[index];
+      if (function(index, traversal)) {
+        traversal.next();
+        if (!traversal.done()) {
+          *end++ = index;
+        }
+      }
+    }
+    live.erase(end, live.end());
+  }
+}
+
+}  // namespace math
+
+using math::GridTraversal;
+using math::GridTraversal2f;
+using math::GridTraversal2d;
+using math::GridTraversal3f;
+using math::GridTraversal3d;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_TRAVERSAL_H_
@@ -28,14 +28,17 @@
 #ifndef TAKRAM_MATH_TRIANGLE3_H_
 #define TAKRAM_MATH_TRIANGLE3_H_
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <ostream>
 
+#include "takram/math/promotion.h"
 #include "takram/math/vector.h"
 
 namespace takram {
@@ -105,6 +108,12 @@ class Triangle<T, 3> final {
   Promote<T> perimeter() const;
   Vec3<Promote<T>> centroid() const;
 
+  // Intersection
+  template <class U>
+  bool intersects(const Triangle3<U>& other) const;
+  template <class U>
+  bool intersects(const Vec3<U>& center, const Vec3<U>& extent) const;
+
   // Iterator
   Iterator begin() { return &a; }
   ConstIterator begin() const { return &a; }
@@ -323,6 +332,89 @@ inline Vec3<Promote<T>> Triangle<T, 3>::centroid() const {
   return (a + b + c) / 3;
 }
 
+#pragma mark Intersection
+
+template <class T>
+template <class U>
+inline bool Triangle<T, 3>::intersects(const Triangle3<U>& other) const {
+  using V = Promote<T, U>;
+  const Vec3<V> p[] = {a, b, c};
+  const Vec3<V> q[] = {other.a, other.b, other.c};
+  const Vec3<V> ep[] = {p[1] - p[0], p[2] - p[1], p[0] - p[2]};
+  const Vec3<V> eq[] = {q[1] - q[0], q[2] - q[1], q[0] - q[2]};
+  const auto separated = [&p, &q](const Vec3<V>& axis) {
+    const V p0 = axis.dot(p[0]);
+    const V p1 = axis.dot(p[1]);
+    const V p2 = axis.dot(p[2]);
+    const V q0 = axis.dot(q[0]);
+    const V q1 = axis.dot(q[1]);
+    const V q2 = axis.dot(q[2]);
+    return (std::max(std::max(p0, p1), p2) < std::min(std::min(q0, q1), q2) ||
+            std::max(std::max(q0, q1), q2) < std::min(std::min(p0, p1), p2));
+  };
+  const Vec3<V> np = ep[0].cross(ep[1]);
+  const Vec3<V> nq = eq[0].cross(eq[1]);
+  if (separated(np) || separated(nq)) {
+    return false;
+  }
+  const V epsilon = std::numeric_limits<V>::epsilon();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      const Vec3<V> axis = ep[i].cross(eq[j]);
+      if (axis.magnitudeSquared() > epsilon * ep[i].magnitudeSquared() *
+                                    eq[j].magnitudeSquared() &&
+          separated(axis)) {
+        return false;
+      }
+    }
+  }
+  // Edge normals within each plane separate coplanar triangles, and are
+  // valid separating axes for any other configuration as well.
+  for (int i = 0; i < 3; ++i) {
+    if (separated(np.cross(ep[i])) || separated(nq.cross(eq[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class T>
+template <class U>
+inline bool Triangle<T, 3>::intersects(const Vec3<U>& center,
+                                       const Vec3<U>& extent) const {
+  using V = Promote<T, U>;
+  const Vec3<V> v0 = a - center;
+  const Vec3<V> v1 = b - center;
+  const Vec3<V> v2 = c - center;
+  const Vec3<V> h(extent);
+  if (std::max(std::max(v0.x, v1.x), v2.x) < -h.x ||
+      std::min(std::min(v0.x, v1.x), v2.x) > h.x ||
+      std::max(std::max(v0.y, v1.y), v2.y) < -h.y ||
+      std::min(std::min(v0.y, v1.y), v2.y) > h.y ||
+      std::max(std::max(v0.z, v1.z), v2.z) < -h.z ||
+      std::min(std::min(v0.z, v1.z), v2.z) > h.z) {
+    return false;
+  }
+  const auto separated = [&v0, &v1, &v2, &h](V x, V y, V z) {
+    const V p0 = v0.x * x + v0.y * y + v0.z * z;
+    const V p1 = v1.x * x + v1.y * y + v1.z * z;
+    const V p2 = v2.x * x + v2.y * y + v2.z * z;
+    const V r = h.x * std::abs(x) + h.y * std::abs(y) + h.z * std::abs(z);
+    return (std::min(std::min(p0, p1), p2) > r ||
+            std::max(std::max(p0, p1), p2) < -r);
+  };
+  const Vec3<V> edges[] = {v1 - v0, v2 - v1, v0 - v2};
+  for (const auto& e : edges) {
+    if (separated(0, -e.z, e.y) ||
+        separated(e.z, 0, -e.x) ||
+        separated(-e.y, e.x, 0)) {
+      return false;
+    }
+  }
+  const Vec3<V> normal = edges[0].cross(edges[1]);
+  return !separated(normal.x, normal.y, normal.z);
+}
+
 #pragma mark Stream
 
 template <class T>
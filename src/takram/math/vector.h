@@ -36,6 +36,7 @@
 #include "takram/math/vector2.h"
 #include "takram/math/vector3.h"
 #include "takram/math/vector4.h"
+#include "takram/math/vectorn.h"
 
 #if TAKRAM_HAS_BOOST
 
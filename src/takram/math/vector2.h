@@ -56,8 +56,8 @@
 
 #include "takram/math/axis.h"
 #include "takram/math/enablers.h"
+#include "takram/math/fwd.h"
 #include "takram/math/promotion.h"
-#include "takram/math/random.h"
 
 namespace takram {
 namespace math {
@@ -446,17 +446,17 @@ inline Vec2<T> Vec<T, 2>::heading(Promote<T> angle) {
 
 template <class T>
 inline Vec2<T> Vec<T, 2>::random() {
-  return random(&Random<>::shared());
+  return random(&sharedRandom<T>());
 }
 
 template <class T>
 inline Vec2<T> Vec<T, 2>::random(T max) {
-  return random(max, &Random<>::shared());
+  return random(max, &sharedRandom<T>());
 }
 
 template <class T>
 inline Vec2<T> Vec<T, 2>::random(T min, T max) {
-  return random(min, max, &Random<>::shared());
+  return random(min, max, &sharedRandom<T>());
 }
 
 template <class T>
@@ -854,7 +854,7 @@ inline Vec2<Promote<T, U>> Vec<T, 2>::lerp(const Vec2<U>& other,
 template <class T>
 template <class U>
 inline Vec2<T>& Vec<T, 2>::jitter(const Vec2<U>& vector) {
-  return jitter(vector, &Random<>::shared());
+  return jitter(vector, &sharedRandom<T>());
 }
 
 template <class T>
@@ -52,8 +52,8 @@
 
 #include "takram/math/axis.h"
 #include "takram/math/enablers.h"
+#include "takram/math/fwd.h"
 #include "takram/math/promotion.h"
-#include "takram/math/random.h"
 
 namespace takram {
 namespace math {
@@ -462,17 +462,17 @@ inline Vec3<T> Vec<T, 3>::headingZX(Promote<T> angle) {
 
 template <class T>
 inline Vec3<T> Vec<T, 3>::random() {
-  return random(&Random<>::shared());
+  return random(&sharedRandom<T>());
 }
 
 template <class T>
 inline Vec3<T> Vec<T, 3>::random(T max) {
-  return random(max, &Random<>::shared());
+  return random(max, &sharedRandom<T>());
 }
 
 template <class T>
 inline Vec3<T> Vec<T, 3>::random(T min, T max) {
-  return random(min, max, &Random<>::shared());
+  return random(min, max, &sharedRandom<T>());
 }
 
 template <class T>
@@ -926,7 +926,7 @@ inline Vec3<Promote<T, U>> Vec<T, 3>::lerp(const Vec3<U>& other,
 template <class T>
 template <class U>
 inline Vec3<T>& Vec<T, 3>::jitter(const Vec3<U>& vector) {
-  return jitter(vector, &Random<>::shared());
+  return jitter(vector, &sharedRandom<T>());
 }
 
 template <class T>
@@ -48,8 +48,8 @@
 
 #include "takram/math/axis.h"
 #include "takram/math/enablers.h"
+#include "takram/math/fwd.h"
 #include "takram/math/promotion.h"
-#include "takram/math/random.h"
 
 namespace takram {
 namespace math {
@@ -438,17 +438,17 @@ inline Vec4<T> Vec<T, 4>::headingZX(Promote<T> angle) {
 
 template <class T>
 inline Vec4<T> Vec<T, 4>::random() {
-  return random(&Random<>::shared());
+  return random(&sharedRandom<T>());
 }
 
 template <class T>
 inline Vec4<T> Vec<T, 4>::random(T max) {
-  return random(max, &Random<>::shared());
+  return random(max, &sharedRandom<T>());
 }
 
 template <class T>
 inline Vec4<T> Vec<T, 4>::random(T min, T max) {
-  return random(min, max, &Random<>::shared());
+  return random(min, max, &sharedRandom<T>());
 }
 
 template <class T>
@@ -936,7 +936,7 @@ inline Vec4<Promote<T, U>> Vec<T, 4>::lerp(const Vec4<U>& other,
 template <class T>
 template <class U>
 inline Vec4<T>& Vec<T, 4>::jitter(const Vec4<U>& vector) {
-  return jitter(vector, &Random<>::shared());
+  return jitter(vector, &sharedRandom<T>());
 }
 
 template <class T>
@@ -0,0 +1,633 @@
+//
+//  takram/math/vectorn.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_VECTORN_H_
+#define TAKRAM_MATH_VECTORN_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <ostream>
+
+#include "takram/math/enablers.h"
+#include "takram/math/promotion.h"
+
+namespace takram {
+namespace math {
+
+// Vector of more than four dimensions for feature vectors and the like, which
+// shares the arithmetic and metric interface of the specializations for two,
+// three and four dimensions. Reductions are unrolled into four independent
+// sums so that compilers can keep them in vector registers.
+template <class T, int D>
+class Vec final {
+  static_assert(D > 4, "Vectors up to four dimensions are specialized");
+
+ public:
+  using Type = T;
+  using Iterator = T *;
+  using ConstIterator = const T *;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+  static constexpr const int dimensions = D;
+
+ public:
+  Vec();
+  explicit Vec(T value);
+  explicit Vec(const T *values, int size = D);
+  Vec(std::initializer_list<T> list);
+
+  // Implicit conversion
+  template <class U>
+  Vec(const Vec<U, D>& other);
+
+  // Copy semantics
+  Vec(const Vec&) = default;
+  Vec& operator=(const Vec&) = default;
+
+  // Factory
+  static Vec min();
+  static Vec max();
+
+  // Mutators
+  void set(T value);
+  void set(const T *values, int size = D);
+  void set(std::initializer_list<T> list);
+  void reset();
+
+  // Element access
+  T& operator[](int index) { return at(index); }
+  const T& operator[](int index) const { return at(index); }
+  T& at(int index);
+  const T& at(int index) const;
+  T& front() { return values_[0]; }
+  const T& front() const { return values_[0]; }
+  T& back() { return values_[D - 1]; }
+  const T& back() const { return values_[D - 1]; }
+
+  // Comparison
+  template <class V, class U = T>
+  bool equals(const Vec<U, D>& other, V tolerance) const;
+
+  // Arithmetic
+  Vec& operator+=(const Vec& other);
+  Vec& operator-=(const Vec& other);
+  Vec& operator*=(const Vec& other);
+  Vec& operator/=(const Vec& other);
+  Vec<Promote<T>, D> operator-() const;
+
+  // Scalar arithmetic
+  Vec& operator+=(T scalar);
+  Vec& operator-=(T scalar);
+  Vec& operator*=(T scalar);
+  Vec& operator/=(T scalar);
+
+  // Attributes
+  bool empty() const;
+
+  // Magnitude
+  Promote<T> magnitude() const;
+  Promote<T> magnitudeSquared() const;
+  template <class U>
+  Vec& limit(U limit);
+  template <class U>
+  Vec<Promote<T, U>, D> limited(U limit) const;
+
+  // Normalization
+  bool normal() const { return magnitude() == 1; }
+  Vec& normalize();
+  Vec<Promote<T>, D> normalized() const;
+
+  // Inversion
+  Vec& invert();
+  Vec<Promote<T>, D> inverted() const;
+
+  // Distance
+  template <class U = T>
+  Promote<T, U> distance(const Vec<U, D>& other) const;
+  template <class U = T>
+  Promote<T, U> distanceSquared(const Vec<U, D>& other) const;
+
+  // Product
+  template <class U = T>
+  Promote<T, U> dot(const Vec<U, D>& other) const;
+
+  // Interpolation
+  template <class V, class U = T>
+  Vec<Promote<T, U>, D> lerp(const Vec<U, D>& other, V factor) const;
+
+  // Iterator
+  Iterator begin() { return values_; }
+  ConstIterator begin() const { return values_; }
+  Iterator end() { return values_ + D; }
+  ConstIterator end() const { return values_ + D; }
+  ReverseIterator rbegin() { return ReverseIterator(end()); }
+  ConstReverseIterator rbegin() const { return ConstReverseIterator(end()); }
+  ReverseIterator rend() { return ReverseIterator(begin()); }
+  ConstReverseIterator rend() const { return ConstReverseIterator(begin()); }
+
+  // Pointer
+  T * pointer() { return values_; }
+  const T * pointer() const { return values_; }
+
+ private:
+  T values_[D];
+};
+
+// Comparison
+template <class T, class U, int D>
+bool operator==(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D>
+bool operator!=(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D>
+bool operator<(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D>
+bool operator>(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D>
+bool operator<=(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D>
+bool operator>=(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+
+// Arithmetic
+template <class T, class U, int D>
+Vec<Promote<T, U>, D> operator+(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D>
+Vec<Promote<T, U>, D> operator-(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D>
+Vec<Promote<T, U>, D> operator*(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D>
+Vec<Promote<T, U>, D> operator/(const Vec<T, D>& lhs, const Vec<U, D>& rhs);
+
+// Scalar arithmetic
+template <class T, class U, int D, EnableIfScalar<U> * = nullptr>
+Vec<Promote<T, U>, D> operator+(const Vec<T, D>& lhs, U rhs);
+template <class T, class U, int D, EnableIfScalar<U> * = nullptr>
+Vec<Promote<T, U>, D> operator-(const Vec<T, D>& lhs, U rhs);
+template <class T, class U, int D, EnableIfScalar<U> * = nullptr>
+Vec<Promote<T, U>, D> operator*(const Vec<T, D>& lhs, U rhs);
+template <class T, class U, int D, EnableIfScalar<U> * = nullptr>
+Vec<Promote<T, U>, D> operator/(const Vec<T, D>& lhs, U rhs);
+template <class T, class U, int D, EnableIfScalar<T> * = nullptr>
+Vec<Promote<T, U>, D> operator+(T lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D, EnableIfScalar<T> * = nullptr>
+Vec<Promote<T, U>, D> operator-(T lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D, EnableIfScalar<T> * = nullptr>
+Vec<Promote<T, U>, D> operator*(T lhs, const Vec<U, D>& rhs);
+template <class T, class U, int D, EnableIfScalar<T> * = nullptr>
+Vec<Promote<T, U>, D> operator/(T lhs, const Vec<U, D>& rhs);
+
+#pragma mark -
+
+template <class T, int D>
+inline Vec<T, D>::Vec() : values_() {}
+
+template <class T, int D>
+inline Vec<T, D>::Vec(T value) {
+  set(value);
+}
+
+template <class T, int D>
+inline Vec<T, D>::Vec(const T *values, int size) {
+  set(values, size);
+}
+
+template <class T, int D>
+inline Vec<T, D>::Vec(std::initializer_list<T> list) {
+  set(list);
+}
+
+#pragma mark Implicit conversion
+
+template <class T, int D>
+template <class U>
+inline Vec<T, D>::Vec(const Vec<U, D>& other) {
+  std::copy(other.begin(), other.end(), values_);
+}
+
+#pragma mark Factory
+
+template <class T, int D>
+inline Vec<T, D> Vec<T, D>::min() {
+  return Vec(std::numeric_limits<T>::min());
+}
+
+template <class T, int D>
+inline Vec<T, D> Vec<T, D>::max() {
+  return Vec(std::numeric_limits<T>::max());
+}
+
+#pragma mark Mutators
+
+template <class T, int D>
+inline void Vec<T, D>::set(T value) {
+  std::fill(begin(), end(), value);
+}
+
+template <class T, int D>
+inline void Vec<T, D>::set(const T *values, int size) {
+  reset();
+  std::copy(values, values + std::min(size, D), values_);
+}
+
+template <class T, int D>
+inline void Vec<T, D>::set(std::initializer_list<T> list) {
+  set(list.begin(), static_cast<int>(list.size()));
+}
+
+template <class T, int D>
+inline void Vec<T, D>::reset() {
+  std::fill(begin(), end(), T());
+}
+
+#pragma mark Element access
+
+template <class T, int D>
+inline T& Vec<T, D>::at(int index) {
+  assert(0 <= index && index < D);
+  return values_[index];
+}
+
+template <class T, int D>
+inline const T& Vec<T, D>::at(int index) const {
+  assert(0 <= index && index < D);
+  return values_[index];
+}
+
+#pragma mark Comparison
+
+template <class T, class U, int D>
+inline bool operator==(const Vec<T, D>& lhs, const Vec<U, D>& rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class U, int D>
+inline bool operator!=(const Vec<T, D>& lhs, const Vec<U, D>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T, class U, int D>
+inline bool operator<(const Vec<T, D>& lhs, const Vec<U, D>& rhs) {
+  return std::lexicographical_compare(lhs.begin(), lhs.end(),
+                                      rhs.begin(), rhs.end());
+}
+
+template <class T, class U, int D>
+inline bool operator>(const Vec<T, D>& lhs, const Vec<U, D>& rhs) {
+  return rhs < lhs;
+}
+
+template <class T, class U, int D>
+inline bool operator<=(const Vec<T, D>& lhs, const Vec<U, D>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <class T, class U, int D>
+inline bool operator>=(const Vec<T, D>& lhs, const Vec<U, D>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <class T, int D>
+template <class V, class U>
+inline bool Vec<T, D>::equals(const Vec<U, D>& other, V tolerance) const {
+  for (int i = 0; i < D; ++i) {
+    if (!(std::abs(values_[i] - other[i]) <= tolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#pragma mark Arithmetic
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::operator+=(const Vec& other) {
+  for (int i = 0; i < D; ++i) {
+    values_[i] += other.values_[i];
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::operator-=(const Vec& other) {
+  for (int i = 0; i < D; ++i) {
+    values_[i] -= other.values_[i];
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::operator*=(const Vec& other) {
+  for (int i = 0; i < D; ++i) {
+    values_[i] *= other.values_[i];
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::operator/=(const Vec& other) {
+  for (int i = 0; i < D; ++i) {
+    values_[i] /= other.values_[i];
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Vec<Promote<T>, D> Vec<T, D>::operator-() const {
+  return Vec<Promote<T>, D>(*this).invert();
+}
+
+template <class T, class U, int D>
+inline Vec<Promote<T, U>, D> operator+(const Vec<T, D>& lhs,
+                                       const Vec<U, D>& rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result += rhs;
+}
+
+template <class T, class U, int D>
+inline Vec<Promote<T, U>, D> operator-(const Vec<T, D>& lhs,
+                                       const Vec<U, D>& rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result -= rhs;
+}
+
+template <class T, class U, int D>
+inline Vec<Promote<T, U>, D> operator*(const Vec<T, D>& lhs,
+                                       const Vec<U, D>& rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result *= rhs;
+}
+
+template <class T, class U, int D>
+inline Vec<Promote<T, U>, D> operator/(const Vec<T, D>& lhs,
+                                       const Vec<U, D>& rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result /= rhs;
+}
+
+#pragma mark Scalar arithmetic
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::operator+=(T scalar) {
+  for (auto& value : values_) {
+    value += scalar;
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::operator-=(T scalar) {
+  for (auto& value : values_) {
+    value -= scalar;
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::operator*=(T scalar) {
+  for (auto& value : values_) {
+    value *= scalar;
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::operator/=(T scalar) {
+  for (auto& value : values_) {
+    value /= scalar;
+  }
+  return *this;
+}
+
+template <class T, class U, int D, EnableIfScalar<U> *>
+inline Vec<Promote<T, U>, D> operator+(const Vec<T, D>& lhs, U rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result += rhs;
+}
+
+template <class T, class U, int D, EnableIfScalar<U> *>
+inline Vec<Promote<T, U>, D> operator-(const Vec<T, D>& lhs, U rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result -= rhs;
+}
+
+template <class T, class U, int D, EnableIfScalar<U> *>
+inline Vec<Promote<T, U>, D> operator*(const Vec<T, D>& lhs, U rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result *= rhs;
+}
+
+template <class T, class U, int D, EnableIfScalar<U> *>
+inline Vec<Promote<T, U>, D> operator/(const Vec<T, D>& lhs, U rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result /= rhs;
+}
+
+template <class T, class U, int D, EnableIfScalar<T> *>
+inline Vec<Promote<T, U>, D> operator+(T lhs, const Vec<U, D>& rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result += rhs;
+}
+
+template <class T, class U, int D, EnableIfScalar<T> *>
+inline Vec<Promote<T, U>, D> operator-(T lhs, const Vec<U, D>& rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result -= rhs;
+}
+
+template <class T, class U, int D, EnableIfScalar<T> *>
+inline Vec<Promote<T, U>, D> operator*(T lhs, const Vec<U, D>& rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result *= rhs;
+}
+
+template <class T, class U, int D, EnableIfScalar<T> *>
+inline Vec<Promote<T, U>, D> operator/(T lhs, const Vec<U, D>& rhs) {
+  Vec<Promote<T, U>, D> result(lhs);
+  return result /= rhs;
+}
+
+#pragma mark Attributes
+
+template <class T, int D>
+inline bool Vec<T, D>::empty() const {
+  return std::all_of(begin(), end(), [](T value) { return !value; });
+}
+
+#pragma mark Magnitude
+
+template <class T, int D>
+inline Promote<T> Vec<T, D>::magnitude() const {
+  return std::sqrt(magnitudeSquared());
+}
+
+template <class T, int D>
+inline Promote<T> Vec<T, D>::magnitudeSquared() const {
+  return dot(*this);
+}
+
+template <class T, int D>
+template <class U>
+inline Vec<T, D>& Vec<T, D>::limit(U limit) {
+  if (magnitudeSquared() > static_cast<Promote<T>>(limit) * limit) {
+    normalize();
+    *this *= limit;
+  }
+  return *this;
+}
+
+template <class T, int D>
+template <class U>
+inline Vec<Promote<T, U>, D> Vec<T, D>::limited(U limit) const {
+  return Vec<Promote<T, U>, D>(*this).limit(limit);
+}
+
+#pragma mark Normalization
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::normalize() {
+  const auto denominator = magnitude();
+  if (denominator) {
+    *this /= denominator;
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Vec<Promote<T>, D> Vec<T, D>::normalized() const {
+  return Vec<Promote<T>, D>(*this).normalize();
+}
+
+#pragma mark Inversion
+
+template <class T, int D>
+inline Vec<T, D>& Vec<T, D>::invert() {
+  for (auto& value : values_) {
+    value *= -1;
+  }
+  return *this;
+}
+
+template <class T, int D>
+inline Vec<Promote<T>, D> Vec<T, D>::inverted() const {
+  return Vec<Promote<T>, D>(*this).invert();
+}
+
+#pragma mark Distance
+
+template <class T, int D>
+template <class U>
+inline Promote<T, U> Vec<T, D>::distance(const Vec<U, D>& other) const {
+  return std::sqrt(distanceSquared(other));
+}
+
+template <class T, int D>
+template <class U>
+inline Promote<T, U> Vec<T, D>::distanceSquared(
+    const Vec<U, D>& other) const {
+  using V = Promote<T, U>;
+  V sums[4]{};
+  int i = 0;
+  for (; i + 4 <= D; i += 4) {
+    for (int j = 0; j < 4; ++j) {
+      const V difference = static_cast<V>(values_[i + j]) - other[i + j];
+      sums[j] += difference * difference;
+    }
+  }
+  for (; i < D; ++i) {
+    const V difference = static_cast<V>(values_[i]) - other[i];
+    sums[0] += difference * difference;
+  }
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+#pragma mark Products
+
+template <class T, int D>
+template <class U>
+inline Promote<T, U> Vec<T, D>::dot(const Vec<U, D>& other) const {
+  using V = Promote<T, U>;
+  V sums[4]{};
+  int i = 0;
+  for (; i + 4 <= D; i += 4) {
+    for (int j = 0; j < 4; ++j) {
+      sums[j] += static_cast<V>(values_[i + j]) * other[i + j];
+    }
+  }
+  for (; i < D; ++i) {
+    sums[0] += static_cast<V>(values_[i]) * other[i];
+  }
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+#pragma mark Interpolation
+
+template <class T, int D>
+template <class V, class U>
+inline Vec<Promote<T, U>, D> Vec<T, D>::lerp(const Vec<U, D>& other,
+                                             V factor) const {
+  Vec<Promote<T, U>, D> result;
+  for (int i = 0; i < D; ++i) {
+    result[i] = values_[i] + (other[i] - values_[i]) * factor;
+  }
+  return result;
+}
+
+#pragma mark Stream
+
+template <class T, int D>
+inline std::ostream& operator<<(std::ostream& os, const Vec<T, D>& vector) {
+  os << "( " << vector.front();
+  for (auto itr = std::next(vector.begin()); itr != vector.end(); ++itr) {
+    os << ", " << *itr;
+  }
+  return os << " )";
+}
+
+}  // namespace math
+
+using math::Vec;
+
+}  // namespace takram
+
+template <class T, int D>
+struct std::hash<takram::math::Vec<T, D>> {
+  std::size_t operator()(const takram::math::Vec<T, D>& value) const {
+    std::hash<T> hash;
+    std::size_t result{};
+    for (int i = 0; i < D; ++i) {
+      result ^= hash(value[i]) + 0x9e3779b9 + (result << 6) + (result >> 2);
+    }
+    return result;
+  }
+};
+
+#endif  // TAKRAM_MATH_VECTORN_H_
@@ -0,0 +1,219 @@
+//
+//  takram/math/voxelizer.h
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+#ifndef TAKRAM_MATH_VOXELIZER_H_
+#define TAKRAM_MATH_VOXELIZER_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "takram/math/size.h"
+#include "takram/math/triangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+// Conservatively rasterizes triangles into an occupancy bitset over a regular
+// grid: a cell is occupied when its closed box overlaps any triangle. Each
+// triangle only visits the cells of its bounding box. Voxelizers over the same
+// grid can be filled from disjoint ranges of triangles independently, for
+// example on separate threads, and combined with merge().
+template <class T>
+class Voxelizer final {
+ public:
+  using Type = T;
+  using Word = std::uint64_t;
+  static constexpr const int bits = 64;
+
+ public:
+  Voxelizer();
+  Voxelizer(const Vec3<T>& origin,
+            const Vec3<T>& cell,
+            const Size3i& resolution);
+
+  // Copy semantics
+  Voxelizer(const Voxelizer&) = default;
+  Voxelizer& operator=(const Voxelizer&) = default;
+
+  // Grid
+  const Vec3<T>& origin() const { return origin_; }
+  const Vec3<T>& cell() const { return cell_; }
+  const Size3i& resolution() const { return resolution_; }
+
+  // Voxelization
+  void add(const Triangle3<T>& triangle);
+  template <class InputIterator>
+  void add(InputIterator first, InputIterator last);
+  void merge(const Voxelizer& other);
+  void clear();
+
+  // Occupancy
+  bool contains(int x, int y, int z) const;
+  std::size_t count() const;
+  std::size_t index(int x, int y, int z) const;
+  const std::vector<Word>& words() const { return words_; }
+
+ private:
+  Vec3<T> origin_;
+  Vec3<T> cell_;
+  Size3i resolution_;
+  std::vector<Word> words_;
+};
+
+using Voxelizerf = Voxelizer<float>;
+using Voxelizerd = Voxelizer<double>;
+
+#pragma mark -
+
+template <class T>
+inline Voxelizer<T>::Voxelizer() : origin_(), cell_(1, 1, 1), resolution_() {}
+
+template <class T>
+inline Voxelizer<T>::Voxelizer(const Vec3<T>& origin,
+                               const Vec3<T>& cell,
+                               const Size3i& resolution)
+    : origin_(origin),
+      cell_(cell),
+      resolution_(resolution),
+      words_((static_cast<std::size_t>(resolution.width) *
+              resolution.height * resolution.depth + bits - 1) / bits) {
+  assert(cell.x > 0 && cell.y > 0 && cell.z > 0);
+  assert(resolution.width >= 0);
+  assert(resolution.height >= 0);
+  assert(resolution.depth >= 0);
+}
+
+#pragma mark Voxelization
+
+template <class T>
+inline void Voxelizer<T>::add(const Triangle3<T>& triangle) {
+  int min[3];
+  int max[3];
+  for (int axis = 0; axis < 3; ++axis) {
+    // Check every vertex, since min and max drop NaN in all but the first
+    if (std::isnan(triangle.a[axis]) ||
+        std::isnan(triangle.b[axis]) ||
+        std::isnan(triangle.c[axis])) {
+      return;
+    }
+    const T lower = std::min(std::min(triangle.a[axis], triangle.b[axis]),
+                             triangle.c[axis]);
+    const T upper = std::max(std::max(triangle.a[axis], triangle.b[axis]),
+                             triangle.c[axis]);
+    // Clamp to one cell beyond the grid before converting to int, since the
+    // triangle can extend arbitrarily far beyond it
+    const T first = std::max(std::floor((lower - origin_[axis]) / cell_[axis]),
+                             T(-1));
+    const T last = std::min(std::floor((upper - origin_[axis]) / cell_[axis]),
+                            static_cast<T>(resolution_[axis]));
+    if (last < 0 || first >= resolution_[axis]) {
+      return;
+    }
+    // Cells sharing a face with the bounding box may touch the triangle
+    min[axis] = std::max(static_cast<int>(first) - 1, 0);
+    max[axis] = std::min(static_cast<int>(last) + 1, resolution_[axis] - 1);
+  }
+  const Vec3<T> extent = cell_ / 2;
+  Vec3<T> center;
+  for (int z = min[2]; z <= max[2]; ++z) {
+    center.z = origin_.z + (z + T(0.5)) * cell_.z;
+    for (int y = min[1]; y <= max[1]; ++y) {
+      center.y = origin_.y + (y + T(0.5)) * cell_.y;
+      std::size_t bit = index(min[0], y, z);
+      for (int x = min[0]; x <= max[0]; ++x, ++bit) {
+        center.x = origin_.x + (x + T(0.5)) * cell_.x;
+        if (triangle.intersects(center, extent)) {
+          words_[bit / bits] |= Word(1) << (bit % bits);
+        }
+      }
+    }
+  }
+}
+
+template <class T>
+template <class InputIterator>
+inline void Voxelizer<T>::add(InputIterator first, InputIterator last) {
+  for (; first != last; ++first) {
+    add(*first);
+  }
+}
+
+template <class T>
+inline void Voxelizer<T>::merge(const Voxelizer& other) {
+  assert(other.resolution_ == resolution_);
+  for (std::size_t i = 0; i < words_.size(); ++i) {
+    words_[i] |= other.words_[i];
+  }
+}
+
+template <class T>
+inline void Voxelizer<T>::clear() {
+  std::fill(words_.begin(), words_.end(), Word());
+}
+
+#pragma mark Occupancy
+
+template <class T>
+inline bool Voxelizer<T>::contains(int x, int y, int z) const {
+  const auto bit = index(x, y, z);
+  return words_[bit / bits] & (Word(1) << (bit % bits));
+}
+
+template <class T>
+inline std::size_t Voxelizer<T>::count() const {
+  std::size_t result = 0;
+  for (auto word : words_) {
+    for (; word; word &= word - 1) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+template <class T>
+inline std::size_t Voxelizer<T>::index(int x, int y, int z) const {
+  assert(0 <= x && x < resolution_.width);
+  assert(0 <= y && y < resolution_.height);
+  assert(0 <= z && z < resolution_.depth);
+  return ((static_cast<std::size_t>(z) * resolution_.height + y) *
+          resolution_.width + x);
+}
+
+}  // namespace math
+
+using math::Voxelizer;
+using math::Voxelizerf;
+using math::Voxelizerd;
+
+}  // namespace takram
+
+#endif  // TAKRAM_MATH_VOXELIZER_H_
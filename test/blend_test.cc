@@ -0,0 +1,170 @@
+//
+//  blend_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/blend.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class BlendTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(BlendTest, Types);
+
+TEST(BlendTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<BlendLayer<float>>::value);
+  ASSERT_TRUE(std::is_copy_constructible<BlendLayer<float>>::value);
+  ASSERT_TRUE(std::is_copy_assignable<BlendLayer<float>>::value);
+  ASSERT_TRUE(std::is_move_constructible<BlendLayer<float>>::value);
+  ASSERT_TRUE(std::is_move_assignable<BlendLayer<float>>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<BlendLayer<float>>::value);
+}
+
+TYPED_TEST(BlendTest, Composite) {
+  using T = TypeParam;
+  using O = CompositeOperation;
+  const Vec4<T> source(0.5, 0, 0, 0.5);
+  const Vec4<T> destination(0, 0, 0.8, 0.8);
+  ASSERT_EQ(composite(source, destination, O::CLEAR), Vec4<T>());
+  ASSERT_EQ(composite(source, destination, O::SOURCE), source);
+  ASSERT_EQ(composite(source, destination, O::DESTINATION), destination);
+  ASSERT_TRUE(composite(source, destination, O::SOURCE_OVER).equals(
+      Vec4<T>(0.5, 0, 0.4, 0.9), 1e-6));
+  ASSERT_TRUE(composite(source, destination, O::DESTINATION_OVER).equals(
+      Vec4<T>(0.1, 0, 0.8, 0.9), 1e-6));
+  ASSERT_TRUE(composite(source, destination, O::SOURCE_IN).equals(
+      Vec4<T>(0.4, 0, 0, 0.4), 1e-6));
+  ASSERT_TRUE(composite(source, destination, O::DESTINATION_OUT).equals(
+      Vec4<T>(0, 0, 0.4, 0.4), 1e-6));
+  ASSERT_TRUE(composite(source, destination, O::XOR).equals(
+      Vec4<T>(0.1, 0, 0.4, 0.5), 1e-6));
+}
+
+TYPED_TEST(BlendTest, Modes) {
+  using T = TypeParam;
+  const Vec4<T> source(0.5, 0.25, 1, 1);
+  const Vec4<T> destination(0.5, 0.5, 0.25, 1);
+  ASSERT_EQ(blend(source, destination, BlendMode::NORMAL), source);
+  ASSERT_TRUE(blend(source, destination, BlendMode::MULTIPLY).equals(
+      Vec4<T>(0.25, 0.125, 0.25, 1), 1e-6));
+  ASSERT_TRUE(blend(source, destination, BlendMode::SCREEN).equals(
+      Vec4<T>(0.75, 0.625, 1, 1), 1e-6));
+  ASSERT_TRUE(blend(source, destination, BlendMode::OVERLAY).equals(
+      Vec4<T>(0.5, 0.25, 0.5, 1), 1e-6));
+
+  // A transparent source leaves the destination unchanged in every mode
+  for (const auto mode : {BlendMode::NORMAL, BlendMode::MULTIPLY,
+                          BlendMode::SCREEN, BlendMode::OVERLAY}) {
+    ASSERT_TRUE(blend(Vec4<T>(), destination, mode).equals(
+        destination, 1e-6));
+    ASSERT_TRUE(blend(source, Vec4<T>(), mode).equals(source, 1e-6));
+  }
+}
+
+TYPED_TEST(BlendTest, Regions) {
+  using T = TypeParam;
+  const int width = 5;
+  const int height = 4;
+  const Vec4<T> background(0.2, 0.2, 0.2, 1);
+  std::vector<Vec4<T>> source(width * height, Vec4<T>(0.5, 0, 0, 0.5));
+  std::vector<Vec4<T>> destination(width * height, background);
+  const Rect2i region(1, 1, 3, 2);
+  blend(source.data(), width, destination.data(), width, region,
+        BlendMode::SCREEN);
+  const auto expected = blend(source.front(), background, BlendMode::SCREEN);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const auto& pixel = destination[y * width + x];
+      if (1 <= x && x < 4 && 1 <= y && y < 3) {
+        ASSERT_TRUE(pixel.equals(expected, 1e-6));
+      } else {
+        ASSERT_EQ(pixel, background);
+      }
+    }
+  }
+}
+
+TYPED_TEST(BlendTest, Layers) {
+  using T = TypeParam;
+  const int width = 100;
+  const int height = 3;
+  std::vector<Vec4<T>> bottom(width * height);
+  std::vector<Vec4<T>> top(width * height);
+  for (int i = 0; i < width * height; ++i) {
+    const T value = (i % 17) / T(16);
+    bottom[i] = Vec4<T>(value, value / 2, 1 - value, 1) * T(0.75);
+    top[i] = Vec4<T>(1 - value, value, value / 3, 1) * T(0.5);
+  }
+  const std::vector<BlendLayer<T>> layers{
+    {bottom.data(), width, BlendMode::MULTIPLY},
+    {top.data(), width, BlendMode::OVERLAY}
+  };
+  const Rect2i region(0, 0, width, height);
+  std::vector<Vec4<T>> fused(width * height, Vec4<T>(0.1, 0.2, 0.3, 0.4));
+  std::vector<Vec4<T>> separate(fused);
+  blend(layers.begin(), layers.end(), fused.data(), width, region);
+  blend(bottom.data(), width, separate.data(), width, region,
+        BlendMode::MULTIPLY);
+  blend(top.begin(), top.end(), separate.begin(), BlendMode::OVERLAY);
+  for (int i = 0; i < width * height; ++i) {
+    ASSERT_TRUE(fused[i].equals(separate[i], 1e-6));
+  }
+}
+
+TEST(BlendTest, Bytes) {
+  using V = Vec4<std::uint8_t>;
+  const V source(128, 0, 0, 128);
+  const V destination(0, 0, 204, 204);
+  ASSERT_EQ(composite(source, destination, CompositeOperation::SOURCE_OVER),
+            V(128, 0, 102, 230));
+  ASSERT_EQ(blend(V(255, 0, 0, 255), V(0, 255, 0, 255), BlendMode::NORMAL),
+            V(255, 0, 0, 255));
+  ASSERT_EQ(blend(V(128, 64, 255, 255), V(128, 128, 64, 255),
+                  BlendMode::MULTIPLY),
+            V(64, 32, 64, 255));
+  ASSERT_EQ(blend(V(), destination, BlendMode::OVERLAY), destination);
+  for (int a = 0; a < 256; a += 5) {
+    for (int b = 0; b < 256; b += 3) {
+      const V gray(a, a, a, 255);
+      const auto result = blend(gray, V(b, b, b, 255), BlendMode::SCREEN);
+      ASSERT_NEAR(result.x, a + b - a * b / 255.0, 1);
+      ASSERT_EQ(result.w, 255);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace takram
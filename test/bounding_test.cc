@@ -0,0 +1,152 @@
+//
+//  bounding_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/bounding.h"
+#include "takram/math/constants.h"
+#include "takram/math/matrix.h"
+#include "takram/math/oriented_rectangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class BoundingTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(BoundingTest, Types);
+
+TYPED_TEST(BoundingTest, ConvexHull) {
+  using T = TypeParam;
+  const std::vector<Vec2<T>> points{
+    {0, 0}, {2, 0}, {1, 1}, {2, 2}, {0, 2}, {1, 0}, {0, 0}, {1, 2}
+  };
+  std::vector<Vec2<T>> hull;
+  convexHull(points.begin(), points.end(), std::back_inserter(hull));
+  ASSERT_EQ(hull.size(), 4);
+  for (std::size_t i = 0; i < hull.size(); ++i) {
+    const auto& a = hull[i];
+    const auto& b = hull[(i + 1) % hull.size()];
+    const auto& c = hull[(i + 2) % hull.size()];
+    ASSERT_GT((b - a).cross(c - a), 0);
+  }
+}
+
+TYPED_TEST(BoundingTest, MinimumAreaRect) {
+  using T = TypeParam;
+  const T angle = pi<T>() / 6;
+  const Vec2<T> u(std::cos(angle), std::sin(angle));
+  const Vec2<T> v(-u.y, u.x);
+  std::vector<Vec2<T>> points;
+  for (int i = 0; i < 50; ++i) {
+    const T s = std::sin(T(i) * 1.3);
+    const T t = std::cos(T(i) * 2.1);
+    points.push_back(Vec2<T>(5, 3) + u * (4 * s) + v * t);
+  }
+  for (const T s : {-1, 1}) {
+    points.push_back(Vec2<T>(5, 3) + u * (4 * s) + v);
+    points.push_back(Vec2<T>(5, 3) + u * (4 * s) - v);
+  }
+  const auto rect = minimumAreaRect(points.begin(), points.end());
+  ASSERT_NEAR(rect.area(), 16, 1e-2);
+  ASSERT_TRUE(rect.center.equals(Vec2<T>(5, 3), 1e-2));
+  ASSERT_NEAR(std::abs(rect.axis(0).dot(u)) + std::abs(rect.axis(1).dot(u)),
+              1, 1e-3);
+  for (const auto& point : points) {
+    ASSERT_TRUE(rect.contains(point + (rect.center - point) * T(1e-3)));
+  }
+}
+
+TYPED_TEST(BoundingTest, PrincipalAxesRect) {
+  using T = TypeParam;
+  const T s = std::sqrt(T(0.5));
+  const Mat3<T> rotation{s, -s, 0, s, s, 0, 0, 0, 1};
+  std::vector<Vec3<T>> points;
+  for (int i = 0; i < 8; ++i) {
+    const Vec3<T> corner(i & 1 ? 4 : -4, i & 2 ? 2 : -2, i & 4 ? 1 : -1);
+    points.push_back(rotation * corner + Vec3<T>(1, 2, 3));
+  }
+  const auto box = principalAxesRect(points.begin(), points.end(), true);
+  ASSERT_NEAR(box.volume(), 64, 1e-2);
+  ASSERT_TRUE(box.center.equals(Vec3<T>(1, 2, 3), 1e-3));
+  for (const auto& point : points) {
+    ASSERT_TRUE(box.contains(point + (box.center - point) * T(1e-3)));
+  }
+}
+
+TYPED_TEST(BoundingTest, Refinement) {
+  using T = TypeParam;
+  // Uniform points in a square have isotropic covariance, so principal axes
+  // alone are arbitrary within the plane.
+  const T angle = T(0.3);
+  const Vec3<T> u(std::cos(angle), std::sin(angle), 0);
+  const Vec3<T> v(-u.y, u.x, 0);
+  std::vector<Vec3<T>> points;
+  for (int i = 0; i <= 10; ++i) {
+    for (int j = 0; j <= 10; ++j) {
+      points.push_back(u * T(i - 5) + v * T(j - 5) +
+                       Vec3<T>(0, 0, (i + j) % 2 ? 0.5 : -0.5));
+    }
+  }
+  const auto coarse = principalAxesRect(points.begin(), points.end());
+  const auto refined = principalAxesRect(points.begin(), points.end(), true);
+  ASSERT_LE(refined.volume(), coarse.volume() + 1e-3);
+  ASSERT_NEAR(refined.volume(), 100, 1e-2);
+}
+
+TYPED_TEST(BoundingTest, Intersections) {
+  using T = TypeParam;
+  const std::vector<OrientedRect2<T>> rects{
+    {Vec2<T>(), Vec2<T>(1, 1)},
+    {Vec2<T>(5, 0), Vec2<T>(1, 1)},
+    {Vec2<T>(2, 2), Vec2<T>(1, 1), pi<T>() / 4},
+  };
+  const OrientedRect2<T> query(Vec2<T>(1, 1), Vec2<T>(1, 0.2), pi<T>() / 4);
+  std::vector<std::size_t> indices;
+  intersections(rects.begin(), rects.end(), query,
+                std::back_inserter(indices));
+  ASSERT_EQ(indices, std::vector<std::size_t>({0, 2}));
+  const std::vector<OrientedRect3<T>> boxes{
+    {Vec3<T>(), Vec3<T>(1, 1, 1)},
+    {Vec3<T>(0, 0, 3), Vec3<T>(1, 1, 1)},
+  };
+  indices.clear();
+  intersections(boxes.begin(), boxes.end(),
+                OrientedRect3<T>(Vec3<T>(0, 0, 1.1), Vec3<T>(1, 1, 0.2)),
+                std::back_inserter(indices));
+  ASSERT_EQ(indices, std::vector<std::size_t>({0}));
+}
+
+}  // namespace math
+}  // namespace takram
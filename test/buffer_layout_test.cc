@@ -0,0 +1,120 @@
+//
+//  buffer_layout_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cstddef>
+#include <cstring>
+#include <list>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/buffer_layout.h"
+#include "takram/math/line.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/triangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+namespace {
+
+constexpr auto std140 = BufferLayout::STD140;
+constexpr auto std430 = BufferLayout::STD430;
+
+template <class T>
+T read(const std::vector<unsigned char>& buffer, std::size_t offset) {
+  T value;
+  std::memcpy(&value, buffer.data() + offset, sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+TEST(BufferLayoutTest, Traits) {
+  static_assert(BufferTraits<Vec2f, std430>::stride == 8, "");
+  static_assert(BufferTraits<Vec2f, std140>::stride == 16, "");
+  static_assert(BufferTraits<Vec3f, std430>::stride == 16, "");
+  static_assert(BufferTraits<Vec3f, std140>::stride == 16, "");
+  static_assert(BufferTraits<Vec4f, std430>::packed, "");
+  static_assert(BufferTraits<Vec3d, std430>::stride == 32, "");
+  static_assert(BufferTraits<Rect2f, std430>::stride == 16, "");
+  static_assert(BufferTraits<Rect2f, std140>::packed, "");
+  static_assert(BufferTraits<Line2f, std430>::offset == 8, "");
+  static_assert(BufferTraits<Triangle2f, std430>::stride == 24, "");
+  static_assert(BufferTraits<Triangle2f, std430>::packed, "");
+  static_assert(BufferTraits<Triangle2f, std140>::stride == 32, "");
+  static_assert(BufferTraits<Triangle3f, std430>::offset == 16, "");
+  static_assert(BufferTraits<Triangle3f, std430>::size == 44, "");
+  static_assert(BufferTraits<Triangle3f, std140>::stride == 48, "");
+  static_assert(!BufferTraits<Triangle3f, std140>::packed, "");
+  static_assert(bufferSize<std140, Vec3f>(10) == 160, "");
+}
+
+TEST(BufferLayoutTest, Vectors) {
+  const std::vector<Vec3f> vectors{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+  std::vector<unsigned char> buffer(bufferSize<std140, Vec3f>(3), 0xff);
+  const auto end = writeBuffer<std140>(vectors.begin(), vectors.end(),
+                                       buffer.data());
+  ASSERT_EQ(end, buffer.data() + buffer.size());
+  for (std::size_t i = 0; i < vectors.size(); ++i) {
+    ASSERT_EQ(read<Vec3f>(buffer, i * 16), vectors[i]);
+    ASSERT_EQ(read<float>(buffer, i * 16 + 12), 0);
+  }
+  const std::list<Vec2f> list{{1, 2}, {3, 4}};
+  buffer.assign(bufferSize<std430, Vec2f>(2), 0);
+  writeBuffer<std430>(list.begin(), list.end(), buffer.data());
+  ASSERT_EQ(read<Vec2f>(buffer, 8), Vec2f(3, 4));
+}
+
+TEST(BufferLayoutTest, Structures) {
+  const std::vector<Triangle3f> triangles{
+    {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}},
+    {{-1, -2, -3}, {-4, -5, -6}, {-7, -8, -9}}
+  };
+  std::vector<unsigned char> buffer(bufferSize<std430, Triangle3f>(2), 0xff);
+  writeBuffer<std430>(triangles.data(), triangles.data() + triangles.size(),
+                      buffer.data());
+  ASSERT_EQ(buffer.size(), 96);
+  ASSERT_EQ(read<Vec3f>(buffer, 48 + 16), triangles[1].b);
+  ASSERT_EQ(read<Vec3f>(buffer, 48 + 32), triangles[1].c);
+  ASSERT_EQ(read<float>(buffer, 44), 0);
+
+  const std::vector<Rect2f> rects{{1, 2, 3, 4}, {5, 6, 7, 8}};
+  buffer.assign(bufferSize<std140, Rect2f>(2), 0);
+  writeBuffer<std140>(rects.data(), rects.data() + rects.size(),
+                      buffer.data());
+  ASSERT_EQ(read<Vec4f>(buffer, 16), Vec4f(5, 6, 7, 8));
+
+  const std::vector<Line2f> lines{{{1, 2}, {3, 4}}};
+  buffer.assign(bufferSize<std140, Line2f>(1), 0xff);
+  writeBuffer<std140>(lines.begin(), lines.end(), buffer.data());
+  ASSERT_EQ(read<Vec4f>(buffer, 0), Vec4f(1, 2, 3, 4));
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,112 @@
+//
+//  camera_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/camera.h"
+#include "takram/math/constants.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class CameraTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(CameraTest, Types);
+
+TEST(CameraTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Camerad>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Camerad>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Camerad>::value);
+  ASSERT_TRUE(std::is_move_constructible<Camerad>::value);
+  ASSERT_TRUE(std::is_move_assignable<Camerad>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Camerad>::value);
+}
+
+TYPED_TEST(CameraTest, Perspective) {
+  using T = TypeParam;
+  Camera<T> camera;
+  camera.setViewport(Rect2<T>(0, 0, 800, 600));
+  camera.setFieldOfView(pi<T>() / 2);
+  camera.setClipping(1, 100);
+  camera.lookAt(Vec3<T>(0, 0, 10), Vec3<T>(), Vec3<T>(0, 1, 0));
+  ASSERT_TRUE(Vec2<T>(camera.project(Vec3<T>())).equals(
+      Vec2<T>(400, 300), 1e-3));
+  // The top edge of the view at distance 10 is at y = 10
+  ASSERT_TRUE(Vec2<T>(camera.project(Vec3<T>(0, 10, 0))).equals(
+      Vec2<T>(400, 0), 1e-3));
+  ASSERT_NEAR(camera.project(Vec3<T>(0, 0, 9)).z, 0, 1e-4);
+  ASSERT_NEAR(camera.project(Vec3<T>(0, 0, -90)).z, 1, 1e-4);
+  const auto ray = camera.ray(Vec2<T>(600, 150));
+  const auto point = camera.unproject(camera.project(Vec3<T>(3, 1, -2)));
+  ASSERT_TRUE(point.equals(Vec3<T>(3, 1, -2), 1e-2));
+  ASSERT_TRUE(ray.a.equals(camera.unproject(Vec3<T>(600, 150, 0)), 1e-4));
+  ASSERT_TRUE(Vec2<T>(camera.project(ray.b)).equals(
+      Vec2<T>(600, 150), 1e-2));
+}
+
+TYPED_TEST(CameraTest, Orthographic) {
+  using T = TypeParam;
+  Camera<T> camera;
+  camera.setProjection(CameraProjection::ORTHOGRAPHIC);
+  camera.setViewport(Rect2<T>(100, 100, 200, 100));
+  camera.setHeight(10);
+  camera.setClipping(0, 20);
+  camera.lookAt(Vec3<T>(0, 0, 10), Vec3<T>(), Vec3<T>(0, 1, 0));
+  ASSERT_TRUE(camera.project(Vec3<T>(10, 5, 3)).equals(
+      Vec3<T>(300, 100, 0.35), 1e-4));
+  ASSERT_TRUE(camera.unproject(Vec3<T>(300, 100, 0.35)).equals(
+      Vec3<T>(10, 5, 3), 1e-3));
+}
+
+TYPED_TEST(CameraTest, Batch) {
+  using T = TypeParam;
+  Camera<T> camera;
+  camera.setViewport(Rect2<T>(0, 0, 640, 480));
+  camera.lookAt(Vec3<T>(0, 0, 10), Vec3<T>(), Vec3<T>(0, 1, 0));
+  const std::vector<Vec3<T>> points{{1, 2, 3}, {0, 0, 10}, {0, 0, 20}};
+  std::vector<Vec3<T>> projected(points.size());
+  std::vector<bool> mask(points.size());
+  camera.project(points.begin(), points.end(), projected.begin(),
+                 mask.begin());
+  ASSERT_EQ(mask, std::vector<bool>({true, false, false}));
+  ASSERT_TRUE(projected[0].equals(camera.project(points[0]), 1e-3));
+  std::vector<Vec3<T>> unprojected;
+  camera.unproject(projected.begin(), projected.begin() + 1,
+                   std::back_inserter(unprojected));
+  ASSERT_TRUE(unprojected[0].equals(points[0], 1e-2));
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,48 @@
+//
+//  circle_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <type_traits>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/circle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+TEST(CircleTest, Canonicalized) {
+  const Circle2i circle(Vec2i(1, 2), -3);
+  const auto canonicalized = circle.canonicalized();
+  ASSERT_TRUE((std::is_same<decltype(canonicalized), const Circle2d>::value));
+  ASSERT_EQ(canonicalized.center, Vec2d(1, 2));
+  ASSERT_EQ(canonicalized.radius, 3);
+  ASSERT_EQ(Circle2f(Vec2f(1, 2), -3).canonicalized().radius, 3);
+  ASSERT_EQ(Circle2i(Vec2i(1, 2), 3).canonicalized().radius, 3);
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,147 @@
+//
+//  color_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/color.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class ColorTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(ColorTest, Types);
+
+TYPED_TEST(ColorTest, Transfer) {
+  using T = TypeParam;
+  ASSERT_NEAR(srgbToLinear(T(0.5)), 0.214041, 1e-5);
+  ASSERT_NEAR(linearToSrgb(T(0.214041)), 0.5, 1e-5);
+  ASSERT_EQ(srgbToLinear(T()), 0);
+  ASSERT_NEAR(srgbToLinear(T(1)), 1, 1e-6);
+  const Vec4<T> color(0.2, 0.5, 0.8, 0.3);
+  const auto linear = srgbToLinear(color);
+  ASSERT_EQ(linear.w, color.w);
+  ASSERT_TRUE(linearToSrgb(linear).equals(color, 1e-5));
+}
+
+TYPED_TEST(ColorTest, TransferBatch) {
+  using T = TypeParam;
+  std::vector<Vec3<T>> colors;
+  for (int i = 0; i <= 100; ++i) {
+    const T value = i / T(80) - T(0.1);
+    colors.emplace_back(value, value / 2, 1 - value);
+  }
+  std::vector<Vec3<T>> linear;
+  srgbToLinear(colors.begin(), colors.end(), std::back_inserter(linear));
+  ASSERT_EQ(linear.size(), colors.size());
+  for (std::size_t i = 0; i < colors.size(); ++i) {
+    ASSERT_TRUE(linear[i].equals(srgbToLinear(colors[i]), 1e-4));
+  }
+  std::vector<Vec3<T>> encoded(linear.size());
+  linearToSrgb(linear.begin(), linear.end(), encoded.begin());
+  for (std::size_t i = 0; i < colors.size(); ++i) {
+    ASSERT_TRUE(encoded[i].equals(colors[i], 1e-3));
+  }
+}
+
+TYPED_TEST(ColorTest, HSV) {
+  using T = TypeParam;
+  ASSERT_TRUE(rgbToHsv(Vec3<T>(1, 0, 0)).equals(Vec3<T>(0, 1, 1), 1e-6));
+  ASSERT_TRUE(rgbToHsv(Vec3<T>(0, 0.5, 0)).equals(
+      Vec3<T>(1 / T(3), 1, 0.5), 1e-6));
+  ASSERT_TRUE(hsvToRgb(Vec3<T>(2 / T(3), 1, 1)).equals(
+      Vec3<T>(0, 0, 1), 1e-6));
+  ASSERT_TRUE(hsvToRgb(Vec3<T>(1, 1, 1)).equals(Vec3<T>(1, 0, 0), 1e-6));
+  const Vec4<T> color(0.3, 0.6, 0.2, 0.5);
+  ASSERT_TRUE(hsvToRgb(rgbToHsv(color)).equals(color, 1e-5));
+  ASSERT_TRUE(rgbToHsv(Vec3<T>(0.4, 0.4, 0.4)).equals(
+      Vec3<T>(0, 0, 0.4), 1e-6));
+}
+
+TYPED_TEST(ColorTest, HSL) {
+  using T = TypeParam;
+  ASSERT_TRUE(rgbToHsl(Vec3<T>(1, 0, 0)).equals(Vec3<T>(0, 1, 0.5), 1e-6));
+  ASSERT_TRUE(hslToRgb(Vec3<T>(0.5, 1, 0.25)).equals(
+      Vec3<T>(0, 0.5, 0.5), 1e-6));
+  for (const auto& color : {Vec3<T>(0.3, 0.6, 0.2),
+                            Vec3<T>(0.9, 0.1, 0.7),
+                            Vec3<T>(0.1, 0.2, 0.95)}) {
+    ASSERT_TRUE(hslToRgb(rgbToHsl(color)).equals(color, 1e-5));
+  }
+}
+
+TYPED_TEST(ColorTest, Lab) {
+  using T = TypeParam;
+  ASSERT_TRUE(linearToLab(Vec3<T>(1, 1, 1)).equals(
+      Vec3<T>(100, 0, 0), 1e-2));
+  ASSERT_TRUE(linearToLab(Vec3<T>(1, 0, 0)).equals(
+      Vec3<T>(53.24, 80.09, 67.20), 5e-2));
+  const Vec4<T> color(0.3, 0.6, 0.2, 0.5);
+  ASSERT_TRUE(labToLinear(linearToLab(color)).equals(color, 1e-4));
+  const Vec3<T> dark(0.001, 0.002, 0.003);
+  ASSERT_TRUE(labToLinear(linearToLab(dark)).equals(dark, 1e-5));
+}
+
+TYPED_TEST(ColorTest, Oklab) {
+  using T = TypeParam;
+  ASSERT_TRUE(linearToOklab(Vec3<T>(1, 1, 1)).equals(
+      Vec3<T>(1, 0, 0), 1e-3));
+  ASSERT_TRUE(linearToOklab(Vec3<T>(1, 0, 0)).equals(
+      Vec3<T>(0.628, 0.2249, 0.1258), 1e-3));
+  const Vec4<T> color(0.3, 0.6, 0.2, 0.5);
+  ASSERT_TRUE(oklabToLinear(linearToOklab(color)).equals(color, 1e-4));
+}
+
+TYPED_TEST(ColorTest, Packing) {
+  using T = TypeParam;
+  const auto packed = packColor(Vec4<T>(-1, 0.5, 1, 2));
+  ASSERT_EQ(packed, Vec4<std::uint8_t>(0, 128, 255, 255));
+  ASSERT_TRUE(unpackColor<T>(Vec3<std::uint8_t>(0, 51, 255)).equals(
+      Vec3<T>(0, 0.2, 1), 1e-6));
+  std::vector<Vec4<T>> colors;
+  for (int i = 0; i < 256; ++i) {
+    colors.emplace_back(i / T(255), 1 - i / T(255), T(), 1);
+  }
+  std::vector<Vec4<std::uint8_t>> bytes(colors.size());
+  packColor(colors.begin(), colors.end(), bytes.begin());
+  std::vector<Vec4<T>> unpacked;
+  unpackColor<T>(bytes.begin(), bytes.end(), std::back_inserter(unpacked));
+  for (std::size_t i = 0; i < colors.size(); ++i) {
+    ASSERT_EQ(bytes[i].x, i);
+    ASSERT_TRUE(unpacked[i].equals(colors[i], 1e-6));
+  }
+}
+
+}  // namespace math
+}  // namespace takram
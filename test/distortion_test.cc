@@ -0,0 +1,104 @@
+//
+//  distortion_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/distortion.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/size.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class DistortionTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(DistortionTest, Types);
+
+TEST(DistortionTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Distortiond>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Distortiond>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Distortiond>::value);
+  ASSERT_TRUE(std::is_move_constructible<Distortiond>::value);
+  ASSERT_TRUE(std::is_move_assignable<Distortiond>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Distortiond>::value);
+  ASSERT_TRUE(std::is_default_constructible<UndistortionMapd>::value);
+  ASSERT_TRUE(std::is_copy_constructible<UndistortionMapd>::value);
+  ASSERT_TRUE(std::is_copy_assignable<UndistortionMapd>::value);
+  ASSERT_TRUE(std::is_move_constructible<UndistortionMapd>::value);
+  ASSERT_TRUE(std::is_move_assignable<UndistortionMapd>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<UndistortionMapd>::value);
+}
+
+TYPED_TEST(DistortionTest, RoundTrip) {
+  using T = TypeParam;
+  const Distortion<T> distortion(Vec2<T>(800, 800), Vec2<T>(640, 360),
+                                 -0.2, 0.05, 0.001, -0.002);
+  ASSERT_EQ(distortion.distort(Vec2<T>(640, 360)), Vec2<T>(640, 360));
+  const std::vector<Vec2<T>> points{{0, 0}, {1280, 720}, {100, 600}};
+  std::vector<Vec2<T>> distorted;
+  std::vector<Vec2<T>> undistorted;
+  distortion.distort(points.begin(), points.end(),
+                     std::back_inserter(distorted));
+  ASSERT_FALSE(distorted[0].equals(points[0], 1));
+  distortion.undistort(distorted.begin(), distorted.end(),
+                       std::back_inserter(undistorted), 20);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_TRUE(undistorted[i].equals(points[i], 1e-2));
+  }
+  ASSERT_TRUE(Distortion<T>().empty());
+  ASSERT_FALSE(distortion.empty());
+}
+
+TYPED_TEST(DistortionTest, UndistortionMap) {
+  using T = TypeParam;
+  const Distortion<T> distortion(Vec2<T>(800, 800), Vec2<T>(640, 360),
+                                 -0.2, 0.05, 0.001, -0.002);
+  const UndistortionMap<T> map(distortion, Rect2<T>(0, 0, 1280, 720),
+                               Size2i(65, 37));
+  std::vector<Vec2<T>> points;
+  for (int i = 0; i < 50; ++i) {
+    points.emplace_back(i * 25.3, i * 14.1);
+  }
+  points.emplace_back(-100, -100);
+  std::vector<Vec2<T>> mapped;
+  map.undistort(points.begin(), points.end(), std::back_inserter(mapped));
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_TRUE(mapped[i].equals(distortion.undistort(points[i]), 0.1));
+  }
+  ASSERT_EQ(map.undistort(Vec2<T>(1280, 720)),
+            distortion.undistort(Vec2<T>(1280, 720)));
+}
+
+}  // namespace math
+}  // namespace takram
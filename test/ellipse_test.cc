@@ -0,0 +1,92 @@
+//
+//  ellipse_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/circle.h"
+#include "takram/math/constants.h"
+#include "takram/math/ellipse.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class EllipseTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(EllipseTest, Types);
+
+TEST(EllipseTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Ellipse2d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Ellipse2d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Ellipse2d>::value);
+  ASSERT_TRUE(std::is_move_constructible<Ellipse2d>::value);
+  ASSERT_TRUE(std::is_move_assignable<Ellipse2d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Ellipse2d>::value);
+}
+
+TYPED_TEST(EllipseTest, ConvertibleFromCircle) {
+  using T = TypeParam;
+  const Ellipse2<T> ellipse(Circle2<T>(Vec2<T>(1, 2), 3));
+  ASSERT_EQ(ellipse.center, Vec2<T>(1, 2));
+  ASSERT_EQ(ellipse.radii, Vec2<T>(3, 3));
+  ASSERT_EQ(ellipse.angle, 0);
+  ASSERT_NEAR(ellipse.perimeter(), 6 * pi<T>(), 1e-4);
+  ASSERT_NEAR(ellipse.area(), 9 * pi<T>(), 1e-4);
+}
+
+TYPED_TEST(EllipseTest, Attributes) {
+  using T = TypeParam;
+  const Ellipse2<T> ellipse(Vec2<T>(1, 1), Vec2<T>(4, 1), half_pi<T>());
+  ASSERT_NEAR(ellipse.perimeter(), 17.15684, 1e-3);
+  const auto bounds = ellipse.bounds();
+  ASSERT_NEAR(bounds.minX(), 0, 1e-5);
+  ASSERT_NEAR(bounds.maxX(), 2, 1e-5);
+  ASSERT_NEAR(bounds.minY(), -3, 1e-5);
+  ASSERT_NEAR(bounds.maxY(), 5, 1e-5);
+  ASSERT_TRUE(ellipse.contains(Vec2<T>(1, T(4.5))));
+  ASSERT_FALSE(ellipse.contains(Vec2<T>(T(2.5), 1)));
+}
+
+TYPED_TEST(EllipseTest, Sample) {
+  using T = TypeParam;
+  const Ellipse2<T> ellipse(Vec2<T>(3, -2), Vec2<T>(5, 2), T(0.3));
+  std::vector<Vec2<T>> points;
+  ellipse.sample(16, std::back_inserter(points));
+  ASSERT_EQ(points.size(), 16);
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_TRUE(points[i].equals(ellipse.point(i * tau<T>() / 16), 1e-4));
+  }
+}
+
+}  // namespace math
+}  // namespace takram
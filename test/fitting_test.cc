@@ -0,0 +1,225 @@
+//
+//  fitting_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/circle.h"
+#include "takram/math/constants.h"
+#include "takram/math/ellipse.h"
+#include "takram/math/fitting.h"
+#include "takram/math/line.h"
+#include "takram/math/random.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class FittingTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(FittingTest, Types);
+
+TEST(FittingTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<EllipseFitterd>::value);
+  ASSERT_TRUE(std::is_copy_constructible<EllipseFitterd>::value);
+  ASSERT_TRUE(std::is_copy_assignable<EllipseFitterd>::value);
+  ASSERT_TRUE(std::is_move_constructible<EllipseFitterd>::value);
+  ASSERT_TRUE(std::is_move_assignable<EllipseFitterd>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<EllipseFitterd>::value);
+}
+
+TYPED_TEST(FittingTest, Line) {
+  using T = TypeParam;
+  std::vector<Vec2<T>> points;
+  for (int i = 0; i <= 100; ++i) {
+    points.emplace_back(Vec2<T>(1, 2).lerp(Vec2<T>(7, -6), T(i) / 100));
+  }
+  const auto line = LineFitter<T>(points.begin(), points.end()).line();
+  const auto expected = Line2<T>({1, 2}, {7, -6});
+  ASSERT_TRUE(line.equals(expected, 1e-1) ||
+              line.equals(Line2<T>(expected.b, expected.a), 1e-1));
+  ASSERT_NEAR(line.direction().cross(expected.direction()), 0, 1e-4);
+}
+
+TYPED_TEST(FittingTest, LineMerge) {
+  using T = TypeParam;
+  std::vector<Vec2<T>> points;
+  for (int i = 100; i < 120; ++i) {
+    points.emplace_back(i, 50);
+  }
+  LineFitter<T> first(points.begin(), points.begin() + 10);
+  first.merge(LineFitter<T>(points.begin() + 10, points.end()));
+  ASSERT_EQ(first.count(), points.size());
+  const auto line = first.line();
+  ASSERT_NEAR(std::min(line.a.x, line.b.x), 99.5, 1e-1);
+  ASSERT_NEAR(std::max(line.a.x, line.b.x), 119.5, 1e-1);
+  ASSERT_NEAR(line.a.y, 50, 1e-3);
+  ASSERT_NEAR(line.b.y, 50, 1e-3);
+  first.merge(LineFitter<T>());
+  ASSERT_EQ(first.count(), points.size());
+  LineFitter<T> empty;
+  empty.merge(first);
+  ASSERT_EQ(empty.line(), line);
+}
+
+TYPED_TEST(FittingTest, Circle) {
+  using T = TypeParam;
+  const Circle2<T> expected(Vec2<T>(-3, 4), 5);
+  Random<> random;
+  CircleFitter<T> first;
+  CircleFitter<T> second;
+  for (int i = 0; i < 200; ++i) {
+    // Points on a quarter arc with noise
+    const T angle = random.uniform<T>(half_pi<T>());
+    const Vec2<T> point(expected.x + std::cos(angle) * expected.radius,
+                        expected.y + std::sin(angle) * expected.radius);
+    const Vec2<T> noise(random.gaussian<T>(), random.gaussian<T>());
+    (i % 2 ? first : second).add(point + noise / 100);
+  }
+  first.merge(second);
+  ASSERT_EQ(first.count(), 200);
+  const auto pratt = first.circle();
+  ASSERT_TRUE(pratt.center.equals(expected.center, 5e-2));
+  ASSERT_NEAR(pratt.radius, expected.radius, 5e-2);
+  const auto kasa = first.circle(CircleFit::KASA);
+  ASSERT_TRUE(kasa.center.equals(expected.center, 2e-1));
+  ASSERT_NEAR(kasa.radius, expected.radius, 2e-1);
+}
+
+TYPED_TEST(FittingTest, CircleInPixels) {
+  using T = TypeParam;
+  for (const auto& center : {Vec2<T>(1000, 500), Vec2<T>(4000, 2000)}) {
+    const Circle2<T> expected(center, 20);
+    CircleFitter<T> fitter;
+    for (int i = 0; i < 100; ++i) {
+      // Points on a half arc
+      const T angle = pi<T>() * i / 100;
+      fitter.add(Vec2<T>(expected.x + std::cos(angle) * expected.radius,
+                         expected.y + std::sin(angle) * expected.radius));
+    }
+    const auto pratt = fitter.circle();
+    ASSERT_TRUE(pratt.center.equals(expected.center, 1e-2));
+    ASSERT_NEAR(pratt.radius, expected.radius, 1e-2);
+    const auto kasa = fitter.circle(CircleFit::KASA);
+    ASSERT_TRUE(kasa.center.equals(expected.center, 1e-2));
+    ASSERT_NEAR(kasa.radius, expected.radius, 1e-2);
+  }
+}
+
+TYPED_TEST(FittingTest, Plane) {
+  using T = TypeParam;
+  const Vec3<T> normal = Vec3<T>(1, 2, 3).normalize();
+  const Vec3<T> u = normal.cross(Vec3<T>(0, 0, 1)).normalize();
+  const Vec3<T> v = normal.cross(u);
+  Random<> random;
+  std::vector<Vec3<T>> points;
+  for (int i = 0; i < 500; ++i) {
+    points.emplace_back(Vec3<T>(10, 20, 30) +
+                        u * random.uniform<T>(-5, 5) +
+                        v * random.uniform<T>(-2, 2));
+  }
+  PlaneFitter<T> fitter(points.begin(), points.begin() + 200);
+  fitter.merge(PlaneFitter<T>(points.begin() + 200, points.end()));
+  ASSERT_EQ(fitter.count(), points.size());
+  ASSERT_TRUE(std::abs(fitter.normal().dot(normal)) > 1 - 1e-4);
+  ASSERT_NEAR((fitter.centroid() - Vec3<T>(10, 20, 30)).dot(normal), 0, 1e-3);
+}
+
+TYPED_TEST(FittingTest, Ellipse) {
+  using T = TypeParam;
+  const Ellipse2<T> expected(Vec2<T>(40, -25), Vec2<T>(12, 5), T(0.4));
+  std::vector<Vec2<T>> points;
+  expected.sample(50, std::back_inserter(points));
+  const auto ellipse = EllipseFitter<T>(points.begin(), points.end()).ellipse();
+  ASSERT_TRUE(ellipse.center.equals(expected.center, 1e-2));
+  ASSERT_TRUE(ellipse.radii.equals(expected.radii, 1e-2));
+  ASSERT_NEAR(ellipse.angle, expected.angle, 1e-3);
+}
+
+TYPED_TEST(FittingTest, EllipseWithNoise) {
+  using T = TypeParam;
+  const Ellipse2<T> expected(Vec2<T>(), Vec2<T>(8, 3), T(-1));
+  Random<> random;
+  EllipseFitter<T> fitter;
+  for (int i = 0; i < 1000; ++i) {
+    const auto point = expected.point(random.uniform<T>(tau<T>()));
+    fitter.add(point + Vec2<T>(random.gaussian<T>(), random.gaussian<T>()) /
+                       100);
+  }
+  const auto ellipse = fitter.ellipse();
+  ASSERT_TRUE(ellipse.center.equals(expected.center, 1e-1));
+  ASSERT_TRUE(ellipse.radii.equals(expected.radii, 1e-1));
+  ASSERT_NEAR(ellipse.angle, expected.angle, 1e-1);
+}
+
+TYPED_TEST(FittingTest, EllipseInPixels) {
+  using T = TypeParam;
+  const Ellipse2<T> expected(Vec2<T>(1000, 500), Vec2<T>(20, 10), T(0.3));
+  std::vector<Vec2<T>> points;
+  expected.sample(200, std::back_inserter(points));
+  EllipseFitter<T> fitter;
+  for (const auto& point : points) {
+    fitter.add(point);
+  }
+  const auto ellipse = fitter.ellipse();
+  ASSERT_TRUE(ellipse.center.equals(expected.center, 1e-2));
+  ASSERT_TRUE(ellipse.radii.equals(expected.radii, 1e-2));
+  ASSERT_NEAR(ellipse.angle, expected.angle, 1e-3);
+}
+
+TYPED_TEST(FittingTest, EllipseMerge) {
+  using T = TypeParam;
+  const Ellipse2<T> expected(Vec2<T>(2, 1), Vec2<T>(2, 1), T(0.2));
+  std::vector<Vec2<T>> points;
+  expected.sample(20, std::back_inserter(points));
+  EllipseFitter<T> whole;
+  EllipseFitter<T> first;
+  EllipseFitter<T> second;
+  whole.add(points.begin(), points.end());
+  first.add(points.begin(), points.begin() + 7);
+  second.add(points.begin() + 7, points.end());
+  first.merge(second);
+  ASSERT_EQ(first.count(), whole.count());
+  ASSERT_TRUE(first.ellipse().equals(whole.ellipse(), 1e-3));
+  // Fitters over separate ranges have separate origins
+  EllipseFitter<T> lower(points.begin(), points.begin() + 7);
+  lower.merge(EllipseFitter<T>(points.begin() + 7, points.end()));
+  ASSERT_EQ(lower.count(), whole.count());
+  ASSERT_TRUE(lower.ellipse().equals(whole.ellipse(), 1e-3));
+  first.reset();
+  ASSERT_EQ(first.count(), 0);
+  ASSERT_TRUE(first.ellipse().empty());
+}
+
+}  // namespace math
+}  // namespace takram
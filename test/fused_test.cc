@@ -0,0 +1,85 @@
+//
+//  fused_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cmath>
+#include <type_traits>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/fused.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class FusedTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(FusedTest, Types);
+
+TYPED_TEST(FusedTest, FMA) {
+  using T = TypeParam;
+  const Vec3<T> a(1, 2, 3);
+  const Vec3<T> b(4, 5, 6);
+  const Vec3<T> c(7, 8, 9);
+  ASSERT_EQ(multiplyAdd(a, b, c), a * b + c);
+  ASSERT_EQ(multiplyAdd(a, T(2), c), a * 2 + c);
+  const Vec4<T> d(1, 2, 3, 4);
+  ASSERT_TRUE(multiplyAdd(d - d.lerp(Vec4<T>(), 1), T(0.5), d)
+      .equals(d.lerp(d * 2, 0.5), 1e-6));
+  const Vec<T, 6> e{1, 2, 3, 4, 5, 6};
+  ASSERT_EQ(multiplyAdd(e, e, e), e * e + e);
+}
+
+TYPED_TEST(FusedTest, Combine) {
+  using T = TypeParam;
+  const Vec2<T> a(1, 2);
+  const Vec2<T> b(3, 5);
+  ASSERT_EQ(combine(a, T(2), b, T(3)), a * 2 + b * 3);
+  const T t = 0.25;
+  ASSERT_TRUE(combine(a, 1 - t, b, t).equals(a.lerp(b, t), 1e-6));
+}
+
+TEST(FusedTest, Promotion) {
+  const Vec3<float> a(1, 2, 3);
+  const Vec3<double> b(0.5, 0.5, 0.5);
+  const auto result = multiplyAdd(a, 2, b);
+  ASSERT_TRUE((std::is_same<decltype(result), const Vec3<double>>::value));
+  ASSERT_EQ(result, Vec3<double>(2.5, 4.5, 6.5));
+  ASSERT_TRUE((std::is_same<
+      decltype(multiplyAdd(a, 2.f, a)), Vec3<float>>::value));
+}
+
+TYPED_TEST(FusedTest, Scalar) {
+  using T = TypeParam;
+  // The scalar fma() must stay visible to unqualified calls in this namespace
+  ASSERT_EQ(fma(T(2), T(3), T(4)), T(10));
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,76 @@
+//
+//  fwd_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <type_traits>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/fwd.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+T lengthSquared(const Vec2<T>& vector);
+
+TEST(FwdTest, Declarations) {
+  ASSERT_TRUE((std::is_same<Vec3f, Vec<float, 3>>::value));
+  ASSERT_TRUE((std::is_same<Rect2d, Rect<double, 2>>::value));
+  ASSERT_TRUE((std::is_same<Mat4f, Mat<float, 4>>::value));
+  ASSERT_TRUE((std::is_same<decltype(&lengthSquared<float>),
+                            float (*)(const Vec2f&)>::value));
+}
+
+}  // namespace math
+}  // namespace takram
+
+#include "takram/math/random.h"
+#include "takram/math/size.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+inline T lengthSquared(const Vec2<T>& vector) {
+  return vector.magnitudeSquared();
+}
+
+TEST(FwdTest, Definitions) {
+  ASSERT_EQ(lengthSquared(Vec2f(3, 4)), 25);
+  ASSERT_EQ(&sharedRandom<float>(), &Random<>::shared());
+  random::seed<DefaultRandomEngine>(1);
+  const auto a = Vec3d::random(-1, 1);
+  random::seed<DefaultRandomEngine>(1);
+  ASSERT_EQ(Vec3d::random(-1, 1), a);
+  const auto size = Size2f::random(1, 2);
+  ASSERT_GE(size.width, 1);
+  ASSERT_LE(size.width, 2);
+}
+
+}  // namespace math
+}  // namespace takram
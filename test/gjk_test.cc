@@ -0,0 +1,163 @@
+//
+//  gjk_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/circle.h"
+#include "takram/math/gjk.h"
+#include "takram/math/line.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/support.h"
+#include "takram/math/triangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class GJKTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(GJKTest, Types);
+
+TEST(GJKTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<GJK3d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<GJK3d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<GJK3d>::value);
+  ASSERT_TRUE(std::is_move_constructible<GJK3d>::value);
+  ASSERT_TRUE(std::is_move_assignable<GJK3d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<GJK3d>::value);
+}
+
+TYPED_TEST(GJKTest, Support) {
+  using T = TypeParam;
+  const Rect2<T> rect(0, 0, 2, 1);
+  ASSERT_EQ(support(rect, Vec2<T>(1, 1)), Vec2<T>(2, 1));
+  ASSERT_EQ(support(rect, Vec2<T>(-1, 1)), Vec2<T>(T(), 1));
+  const Triangle3<T> triangle({0, 0, 0}, {1, 0, 0}, {0, 0, 1});
+  ASSERT_EQ(support(triangle, Vec3<T>(0, 0, 1)), triangle.c);
+  const Circle2<T> circle(Vec2<T>(1, 1), 2);
+  ASSERT_TRUE(support(circle, Vec2<T>(T(), 5)).equals(Vec2<T>(1, 3), 1e-5));
+}
+
+TYPED_TEST(GJKTest, Distance2) {
+  using T = TypeParam;
+  GJK<T, 2> gjk;
+  const Circle2<T> circle(Vec2<T>(), 1);
+  const Rect2<T> rect(3, -1, 2, 2);
+  ASSERT_FALSE(gjk.intersects(circle, rect));
+  ASSERT_NEAR(gjk.distance(circle, rect), 2, 1e-3);
+  ASSERT_NEAR(gjk.closestA().x, 1, 1e-3);
+  ASSERT_NEAR(gjk.closestB().x, 3, 1e-3);
+  const Triangle2<T> triangle({0, 0}, {4, 0}, {0, 4});
+  ASSERT_TRUE(gjk.intersects(triangle, rect.translated(T(-2), T(0))));
+  ASSERT_FALSE(gjk.intersects(triangle, Rect2<T>(3, 3, 1, 1)));
+}
+
+TYPED_TEST(GJKTest, Penetration2) {
+  using T = TypeParam;
+  GJK<T, 2> gjk;
+  const Rect2<T> a(0, 0, 4, 4);
+  const Rect2<T> b(3, 1, 4, 2);
+  ASSERT_TRUE(gjk.penetration(a, b));
+  ASSERT_NEAR(gjk.depth(), 1, 1e-3);
+  ASSERT_TRUE(gjk.normal().equals(Vec2<T>(1, 0), 1e-3));
+}
+
+TYPED_TEST(GJKTest, Distance3) {
+  using T = TypeParam;
+  GJK<T, 3> gjk;
+  const auto sphere = makeRounded(Vec3<T>(0, 0, 0), T(1));
+  const auto capsule = makeRounded(Line3<T>({4, -1, 0}, {4, 1, 0}), T(1));
+  ASSERT_FALSE(gjk.intersects(sphere, capsule));
+  ASSERT_NEAR(gjk.distance(sphere, capsule), 2, 1e-3);
+  const Triangle3<T> triangle({-1, -1, 0}, {1, -1, 0}, {0, 1, 0});
+  ASSERT_NEAR(gjk.distance(triangle, Vec3<T>(0, 0, 3)), 3, 1e-3);
+  ASSERT_TRUE(gjk.intersects(triangle, sphere));
+}
+
+TYPED_TEST(GJKTest, Penetration3) {
+  using T = TypeParam;
+  const std::vector<Vec3<T>> box{
+    {0, 0, 0}, {2, 0, 0}, {0, 2, 0}, {2, 2, 0},
+    {0, 0, 2}, {2, 0, 2}, {0, 2, 2}, {2, 2, 2}
+  };
+  GJK<T, 3> gjk;
+  const auto hull = makeHull(box.begin(), box.end());
+  const auto sphere = makeRounded(Vec3<T>(1, 1, 2.5), T(1));
+  ASSERT_TRUE(gjk.penetration(hull, sphere));
+  ASSERT_NEAR(gjk.depth(), 0.5, 1e-2);
+  ASSERT_TRUE(gjk.normal().equals(Vec3<T>(0, 0, 1), 1e-2));
+}
+
+TYPED_TEST(GJKTest, WarmStart) {
+  using T = TypeParam;
+  const std::vector<Vec3<T>> box{
+    {0, 0, 0}, {2, 0, 0}, {0, 2, 0}, {2, 2, 0},
+    {0, 0, 2}, {2, 0, 2}, {0, 2, 2}, {2, 2, 2}
+  };
+  GJK<T, 3> gjk;
+  const auto hull = makeHull(box.begin(), box.end());
+  Triangle3<T> triangle({3, 1, 1}, {5, 3, 1}, {4, -1, 3});
+  ASSERT_NEAR(gjk.distance(hull, triangle), 1, 1e-3);
+  const int cold = gjk.iterations();
+  triangle.a.x -= T(0.01);
+  triangle.b.x -= T(0.01);
+  triangle.c.x -= T(0.01);
+  ASSERT_NEAR(gjk.distance(hull, triangle), 0.99, 1e-3);
+  ASSERT_LE(gjk.iterations(), cold);
+  ASSERT_LE(gjk.iterations(), 2);
+}
+
+TYPED_TEST(GJKTest, WarmStartIntersecting) {
+  using T = TypeParam;
+  const std::vector<Vec3<T>> box{
+    {0, 0, 0}, {2, 0, 0}, {0, 2, 0}, {2, 2, 0},
+    {0, 0, 2}, {2, 0, 2}, {0, 2, 2}, {2, 2, 2}
+  };
+  GJK<T, 3> gjk;
+  const auto hull = makeHull(box.begin(), box.end());
+  Triangle3<T> triangle({1.5, 1, 1}, {3.5, 3, 1}, {2.5, -1, 3});
+  ASSERT_TRUE(gjk.penetration(hull, triangle));
+  const int cold = gjk.iterations();
+  ASSERT_GT(cold, 1);
+  for (int i = 0; i < 3; ++i) {
+    triangle.a.x -= T(0.01);
+    triangle.b.x -= T(0.01);
+    triangle.c.x -= T(0.01);
+    ASSERT_TRUE(gjk.intersects(hull, triangle));
+    ASSERT_EQ(gjk.iterations(), 1);
+  }
+  ASSERT_TRUE(gjk.penetration(hull, triangle));
+  ASSERT_EQ(gjk.iterations(), 1);
+  ASSERT_NEAR(gjk.depth(), 0.53, 1e-2);
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,135 @@
+//
+//  homography_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/homography.h"
+#include "takram/math/matrix.h"
+#include "takram/math/random.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/size.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class HomographyTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(HomographyTest, Types);
+
+TYPED_TEST(HomographyTest, FourPoints) {
+  using T = TypeParam;
+  const std::vector<Vec2<T>> source{{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+  const std::vector<Vec2<T>> destination{{10, 10}, {30, 12}, {28, 35}, {8, 30}};
+  Mat3<T> homography;
+  ASSERT_TRUE(estimateHomography(source.begin(), source.end(),
+                                 destination.begin(), &homography));
+  for (std::size_t i = 0; i < source.size(); ++i) {
+    ASSERT_TRUE(warp(homography, source[i]).equals(destination[i], 1e-3));
+  }
+  const std::vector<Vec2<T>> collinear{{0, 0}, {1, 1}, {2, 2}, {3, 3}};
+  ASSERT_FALSE(estimateHomography(collinear.begin(), collinear.end(),
+                                  destination.begin(), &homography));
+}
+
+TYPED_TEST(HomographyTest, LeastSquares) {
+  using T = TypeParam;
+  const Mat3<T> expected{1.2, 0.1, 300, -0.05, 0.9, 200, 1e-4, 2e-4, 1};
+  Random<> random(1);
+  std::vector<Vec2<T>> source;
+  std::vector<Vec2<T>> destination;
+  for (int i = 0; i < 100; ++i) {
+    source.emplace_back(random.uniform<T>(0, 1920),
+                        random.uniform<T>(0, 1080));
+    destination.push_back(warp(expected, source.back()) +
+                          Vec2<T>(random.gaussian<T>(0, 0.1),
+                                  random.gaussian<T>(0, 0.1)));
+  }
+  Mat3<T> homography;
+  ASSERT_TRUE(estimateHomography(source.begin(), source.end(),
+                                 destination.begin(), &homography));
+  for (std::size_t i = 0; i < source.size(); ++i) {
+    ASSERT_TRUE(warp(homography, source[i]).equals(
+        warp(expected, source[i]), 0.2));
+  }
+}
+
+TYPED_TEST(HomographyTest, RANSAC) {
+  using T = TypeParam;
+  const Mat3<T> expected{1.2, 0.1, 300, -0.05, 0.9, 200, 1e-4, 2e-4, 1};
+  Random<> random(1);
+  std::vector<Vec2<T>> source;
+  std::vector<Vec2<T>> destination;
+  for (int i = 0; i < 100; ++i) {
+    source.emplace_back(random.uniform<T>(0, 1920),
+                        random.uniform<T>(0, 1080));
+    if (i % 3) {
+      destination.push_back(warp(expected, source.back()));
+    } else {
+      destination.emplace_back(random.uniform<T>(0, 1920),
+                               random.uniform<T>(0, 1080));
+    }
+  }
+  Mat3<T> homography;
+  const auto inliers = estimateHomography(source.begin(), source.end(),
+                                          destination.begin(), T(1), 500,
+                                          &random, &homography);
+  ASSERT_GE(inliers, 66);
+  for (std::size_t i = 1; i < source.size(); i += 3) {
+    ASSERT_TRUE(warp(homography, source[i]).equals(destination[i], 0.5));
+  }
+}
+
+TYPED_TEST(HomographyTest, Grid) {
+  using T = TypeParam;
+  const Mat3<T> homography{1.2, 0.1, 30, -0.05, 0.9, 20, 1e-3, 2e-3, 1};
+  const Rect2<T> rect(10, 20, 64, 32);
+  const Size2i size(16, 8);
+  std::vector<Vec2<T>> grid;
+  warp(homography, rect, size, std::back_inserter(grid));
+  ASSERT_EQ(grid.size(), 16 * 8);
+  std::vector<Vec2<T>> centers;
+  for (int j = 0; j < size.height; ++j) {
+    for (int i = 0; i < size.width; ++i) {
+      centers.emplace_back(rect.x + 4 * i + 2, rect.y + 4 * j + 2);
+    }
+  }
+  std::vector<Vec2<T>> points(centers.size());
+  warp(homography, centers.begin(), centers.end(), points.begin());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_TRUE(grid[i].equals(points[i], 1e-3));
+  }
+}
+
+}  // namespace math
+}  // namespace takram
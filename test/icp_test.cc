@@ -0,0 +1,144 @@
+//
+//  icp_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/icp.h"
+#include "takram/math/matrix.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class ICPTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(ICPTest, Types);
+
+namespace {
+
+template <class T>
+std::vector<Vec3<T>> makeSurface() {
+  std::vector<Vec3<T>> points;
+  for (int i = -15; i <= 15; ++i) {
+    for (int j = -15; j <= 15; ++j) {
+      const T x = T(i) / 10;
+      const T y = T(j) / 10;
+      points.emplace_back(x, y, std::sin(2 * x) * std::cos(3 * y) / 2);
+    }
+  }
+  return points;
+}
+
+template <class T>
+Mat3<T> makeRotation(T angle) {
+  const T c = std::cos(angle);
+  const T s = std::sin(angle);
+  return Mat3<T>({c, -s, 0, s, c, 0, 0, 0, 1});
+}
+
+}  // namespace
+
+TEST(ICPTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<ICPd>::value);
+  ASSERT_TRUE(std::is_copy_constructible<ICPd>::value);
+  ASSERT_TRUE(std::is_copy_assignable<ICPd>::value);
+  ASSERT_TRUE(std::is_move_constructible<ICPd>::value);
+  ASSERT_TRUE(std::is_move_assignable<ICPd>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<ICPd>::value);
+}
+
+TYPED_TEST(ICPTest, PointToPoint) {
+  using T = TypeParam;
+  const auto target = makeSurface<T>();
+  const Mat3<T> rotation = makeRotation(T(0.1));
+  const Vec3<T> translation(0.05, -0.03, 0.02);
+  std::vector<Vec3<T>> source;
+  for (const auto& point : target) {
+    source.push_back(rotation.transposed() * (point - translation));
+  }
+  ICP<T> icp;
+  icp.setTarget(target.begin(), target.end());
+  icp.setMaxIterations(100);
+  ASSERT_TRUE(icp.align(source.begin(), source.end()));
+  ASSERT_TRUE(icp.rotation().equals(rotation, 1e-3));
+  ASSERT_TRUE(icp.translation().equals(translation, 1e-3));
+  ASSERT_LT(icp.error(), 1e-3);
+}
+
+TYPED_TEST(ICPTest, PointToPlane) {
+  using T = TypeParam;
+  const auto target = makeSurface<T>();
+  const Mat3<T> rotation = makeRotation(T(0.1));
+  const Vec3<T> translation(0.05, -0.03, 0.02);
+  std::vector<Vec3<T>> source;
+  for (const auto& point : target) {
+    source.push_back(rotation.transposed() * (point - translation));
+  }
+  ICP<T> icp;
+  icp.setMetric(ICPMetric::POINT_TO_PLANE);
+  icp.setTarget(target.begin(), target.end());
+  ASSERT_TRUE(icp.align(source.begin(), source.end()));
+  ASSERT_TRUE(icp.rotation().equals(rotation, 1e-3));
+  ASSERT_TRUE(icp.translation().equals(translation, 1e-3));
+  const int cold = icp.iterations();
+  // Warm start from the previous result
+  ASSERT_TRUE(icp.align(source.begin(), source.end()));
+  ASSERT_LE(icp.iterations(), cold);
+}
+
+TYPED_TEST(ICPTest, Subsampling) {
+  using T = TypeParam;
+  const auto target = makeSurface<T>();
+  const Vec3<T> translation(0.03, 0.02, -0.01);
+  std::vector<Vec3<T>> source;
+  for (const auto& point : target) {
+    source.push_back(point - translation);
+  }
+  ICP<T> icp;
+  icp.random().seed(1);
+  icp.setMetric(ICPMetric::POINT_TO_PLANE);
+  icp.setSamples(200);
+  icp.setTolerance(1e-4);
+  icp.setTarget(target.begin(), target.end());
+  icp.align(source.begin(), source.end());
+  ASSERT_EQ(icp.correspondences(), 200);
+  ASSERT_TRUE(icp.translation().equals(translation, 1e-3));
+  ASSERT_TRUE(icp.transform().equals(
+      Mat4<T>({1, 0, 0, translation.x,
+               0, 1, 0, translation.y,
+               0, 0, 1, translation.z,
+               0, 0, 0, 1}), 1e-3));
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,301 @@
+//
+//  kd_tree_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/kd_tree.h"
+#include "takram/math/random.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class KDTreeTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(KDTreeTest, Types);
+
+TEST(KDTreeTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<KDTree3d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<KDTree3d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<KDTree3d>::value);
+  ASSERT_TRUE(std::is_move_constructible<KDTree3d>::value);
+  ASSERT_TRUE(std::is_move_assignable<KDTree3d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<KDTree3d>::value);
+}
+
+TEST(KDTreeTest, ViewConcepts) {
+  ASSERT_TRUE(std::is_default_constructible<KDTreeView3d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<KDTreeView3d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<KDTreeView3d>::value);
+  ASSERT_TRUE(std::is_move_constructible<KDTreeView3d>::value);
+  ASSERT_TRUE(std::is_move_assignable<KDTreeView3d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<KDTreeView3d>::value);
+}
+
+TYPED_TEST(KDTreeTest, MatchesBruteForce) {
+  using T = TypeParam;
+  Random<> random(1);
+  std::vector<Vec3<T>> points(500);
+  for (auto& point : points) {
+    point.set(random.uniform<T>(-1, 1),
+              random.uniform<T>(-1, 1),
+              random.uniform<T>(-1, 1));
+  }
+  const KDTree3<T> tree(points.begin(), points.end());
+  ASSERT_EQ(tree.size(), points.size());
+  for (int i = 0; i < 50; ++i) {
+    const Vec3<T> query(random.uniform<T>(-1.2, 1.2),
+                        random.uniform<T>(-1.2, 1.2),
+                        random.uniform<T>(-1.2, 1.2));
+    std::vector<std::size_t> order(points.size());
+    for (std::size_t j = 0; j < order.size(); ++j) {
+      order[j] = j;
+    }
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+      return points[a].distanceSquared(query) <
+             points[b].distanceSquared(query);
+    });
+    ASSERT_EQ(tree.nearest(query), order[0]);
+    std::vector<std::size_t> neighbors;
+    tree.nearest(query, 5, std::back_inserter(neighbors));
+    ASSERT_EQ(neighbors, std::vector<std::size_t>(order.begin(),
+                                                  order.begin() + 5));
+    std::vector<std::size_t> within;
+    const T radius = T(0.3);
+    tree.within(query, radius, std::back_inserter(within));
+    std::sort(within.begin(), within.end());
+    std::vector<std::size_t> expected;
+    for (std::size_t j = 0; j < points.size(); ++j) {
+      if (points[j].distanceSquared(query) <= radius * radius) {
+        expected.push_back(j);
+      }
+    }
+    ASSERT_EQ(within, expected);
+  }
+}
+
+TYPED_TEST(KDTreeTest, Incremental) {
+  using T = TypeParam;
+  Random<> random(2);
+  std::vector<Vec3<T>> points(300);
+  for (auto& point : points) {
+    point.set(random.uniform<T>(-1, 1),
+              random.uniform<T>(-1, 1),
+              random.uniform<T>(-1, 1));
+  }
+  const KDTree3<T> complete(points.begin(), points.end());
+  ASSERT_TRUE(complete.complete());
+  KDTree3<T> tree;
+  tree.beginBuild(points.begin(), points.end());
+  ASSERT_EQ(tree.size(), points.size());
+  ASSERT_FALSE(tree.complete());
+  ASSERT_FALSE(tree.continueBuild(std::chrono::microseconds(0)));
+  int steps = 0;
+  do {
+    for (int i = 0; i < 10; ++i) {
+      const Vec3<T> query(random.uniform<T>(-1.2, 1.2),
+                          random.uniform<T>(-1.2, 1.2),
+                          random.uniform<T>(-1.2, 1.2));
+      ASSERT_EQ(tree.nearest(query), complete.nearest(query));
+      std::vector<std::size_t> expected;
+      std::vector<std::size_t> actual;
+      complete.nearest(query, 4, std::back_inserter(expected));
+      tree.nearest(query, 4, std::back_inserter(actual));
+      ASSERT_EQ(actual, expected);
+      expected.clear();
+      actual.clear();
+      complete.within(query, T(0.4), std::back_inserter(expected));
+      tree.within(query, T(0.4), std::back_inserter(actual));
+      std::sort(expected.begin(), expected.end());
+      std::sort(actual.begin(), actual.end());
+      ASSERT_EQ(actual, expected);
+    }
+    ++steps;
+  } while (!tree.continueBuild(200));
+  ASSERT_GT(steps, 1);
+  ASSERT_TRUE(tree.complete());
+  ASSERT_TRUE(tree.continueBuild(std::chrono::microseconds(0)));
+}
+
+TYPED_TEST(KDTreeTest, Budget) {
+  using T = TypeParam;
+  Random<> random(4);
+  std::vector<Vec3<T>> points(20000);
+  for (auto& point : points) {
+    point.set(random.uniform<T>(-1, 1),
+              random.uniform<T>(-1, 1),
+              random.uniform<T>(-1, 1));
+  }
+  // Every range, including the first one over all the points, is suspended
+  // where the budget runs out
+  const std::size_t budget = 64;
+  KDTree3<T> tree;
+  tree.beginBuild(points.begin(), points.end());
+  std::size_t calls = 0;
+  std::size_t total = 0;
+  std::size_t done;
+  do {
+    tree.continueBuild(budget, &done);
+    ASSERT_LE(done, budget);
+    ASSERT_GT(done, 0);
+    ++calls;
+    total += done;
+  } while (!tree.complete());
+  ASSERT_GE(total, points.size());
+  ASSERT_GE(calls, points.size() / budget);
+  ASSERT_TRUE(tree.continueBuild(budget, &done));
+  ASSERT_EQ(done, 0);
+  const KDTree3<T> complete(points.begin(), points.end());
+  for (int i = 0; i < 20; ++i) {
+    const Vec3<T> query(random.uniform<T>(-1.2, 1.2),
+                        random.uniform<T>(-1.2, 1.2),
+                        random.uniform<T>(-1.2, 1.2));
+    ASSERT_EQ(tree.nearest(query), complete.nearest(query));
+  }
+}
+
+TYPED_TEST(KDTreeTest, Snapshot) {
+  using T = TypeParam;
+  Random<> random(3);
+  std::vector<Vec3<T>> points(200);
+  for (auto& point : points) {
+    point.set(random.uniform<T>(-1, 1),
+              random.uniform<T>(-1, 1),
+              random.uniform<T>(-1, 1));
+  }
+  const KDTree3<T> tree(points.begin(), points.end());
+  std::ostringstream stream;
+  tree.writeSnapshot(std::ostreambuf_iterator<char>(stream));
+  const std::string bytes = stream.str();
+  ASSERT_EQ(bytes.size(), tree.snapshotSize());
+
+  // Copy into storage aligned to 8 bytes, as a mapped file would be
+  std::vector<std::uint64_t> storage(bytes.size() / 8 + 1);
+  const auto data = reinterpret_cast<char *>(storage.data());
+  std::memcpy(data, bytes.data(), bytes.size());
+  KDTreeView3<T> view;
+  ASSERT_TRUE(view.open(data, bytes.size(), true));
+  ASSERT_EQ(view.size(), tree.size());
+  for (int i = 0; i < 20; ++i) {
+    const Vec3<T> query(random.uniform<T>(-1.2, 1.2),
+                        random.uniform<T>(-1.2, 1.2),
+                        random.uniform<T>(-1.2, 1.2));
+    ASSERT_EQ(view.nearest(query), tree.nearest(query));
+    std::vector<std::size_t> expected;
+    std::vector<std::size_t> actual;
+    tree.nearest(query, 3, std::back_inserter(expected));
+    view.nearest(query, 3, std::back_inserter(actual));
+    ASSERT_EQ(actual, expected);
+    expected.clear();
+    actual.clear();
+    tree.within(query, T(0.5), std::back_inserter(expected));
+    view.within(query, T(0.5), std::back_inserter(actual));
+    ASSERT_EQ(actual, expected);
+  }
+
+  // Mismatching type, truncation and misalignment
+  ASSERT_FALSE(KDTreeView2<T>().open(data, bytes.size()));
+  ASSERT_FALSE(view.open(data, bytes.size() - 1));
+  ASSERT_TRUE(view.empty());
+  ASSERT_FALSE(view.open(data + 1, bytes.size()));
+
+  // The checksum is validated only when requested
+  const auto header = kd_tree::snapshotHeader<T, 3>(tree.size());
+  data[header.points] ^= 1;
+  ASSERT_TRUE(view.open(data, bytes.size()));
+  ASSERT_FALSE(view.open(data, bytes.size(), true));
+
+  // Axes and indices out of range are rejected even without verification
+  const auto axes = reinterpret_cast<std::uint8_t *>(data + header.axes);
+  const auto indices = reinterpret_cast<std::uint64_t *>(data + header.indices);
+  const auto axis = axes[0];
+  axes[0] = 3;
+  ASSERT_FALSE(view.open(data, bytes.size()));
+  axes[0] = kd_tree::unsplit;
+  ASSERT_FALSE(view.open(data, bytes.size()));
+  axes[0] = axis;
+  const auto index = indices[0];
+  indices[0] = tree.size();
+  ASSERT_FALSE(view.open(data, bytes.size()));
+  indices[0] = index;
+  ASSERT_TRUE(view.open(data, bytes.size()));
+
+  // Nothing is written until the tree is complete
+  KDTree3<T> partial;
+  partial.beginBuild(points.begin(), points.end());
+  partial.continueBuild(50);
+  ASSERT_FALSE(partial.complete());
+  std::ostringstream empty;
+  partial.writeSnapshot(std::ostreambuf_iterator<char>(empty));
+  ASSERT_TRUE(empty.str().empty());
+}
+
+TEST(KDTreeTest, SnapshotScalar) {
+  const std::vector<Vec2<unsigned>> points{{0, 0}, {4, 0}, {0, 4}};
+  const KDTree2<unsigned> tree(points.begin(), points.end());
+  std::ostringstream stream;
+  tree.writeSnapshot(std::ostreambuf_iterator<char>(stream));
+  const std::string bytes = stream.str();
+  std::vector<std::uint64_t> storage(bytes.size() / 8 + 1);
+  const auto data = reinterpret_cast<char *>(storage.data());
+  std::memcpy(data, bytes.data(), bytes.size());
+  ASSERT_TRUE(KDTreeView2<unsigned>().open(data, bytes.size(), true));
+  ASSERT_FALSE(KDTreeView2<int>().open(data, bytes.size()));
+  ASSERT_FALSE(KDTreeView2<float>().open(data, bytes.size()));
+}
+
+TYPED_TEST(KDTreeTest, Radius) {
+  using T = TypeParam;
+  const std::vector<Vec2<T>> points{{0, 0}, {4, 0}, {0, 4}};
+  KDTree2<T> tree(points.begin(), points.end());
+  ASSERT_EQ(tree.nearest(Vec2<T>(3, 1)), 1);
+  ASSERT_EQ(tree.nearest(Vec2<T>(2, 2), 1), tree.size());
+  std::vector<std::size_t> neighbors;
+  tree.nearest(Vec2<T>(3, 1), std::numeric_limits<std::size_t>::max(),
+               std::back_inserter(neighbors));
+  ASSERT_EQ(neighbors, (std::vector<std::size_t>{1, 0, 2}));
+  tree.reset();
+  ASSERT_TRUE(tree.empty());
+  ASSERT_EQ(tree.nearest(Vec2<T>()), 0);
+}
+
+}  // namespace math
+}  // namespace takram
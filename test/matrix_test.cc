@@ -0,0 +1,192 @@
+//
+//  matrix_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/decomposition.h"
+#include "takram/math/matrix.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class MatrixTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(MatrixTest, Types);
+
+TEST(MatrixTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Mat3d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Mat3d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Mat3d>::value);
+  ASSERT_TRUE(std::is_move_constructible<Mat3d>::value);
+  ASSERT_TRUE(std::is_move_assignable<Mat3d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Mat3d>::value);
+}
+
+TYPED_TEST(MatrixTest, Construction) {
+  using T = TypeParam;
+  const Mat3<T> m{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  ASSERT_EQ(m(0, 1), 2);
+  ASSERT_EQ(m(2, 0), 7);
+  ASSERT_EQ(m.row(1), Vec3<T>(4, 5, 6));
+  ASSERT_EQ(m.column(2), Vec3<T>(3, 6, 9));
+  ASSERT_EQ(m.diagonal(), Vec3<T>(1, 5, 9));
+  ASSERT_EQ(m.transposed(),
+            Mat3<T>::fromColumns({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}));
+  ASSERT_EQ(Mat3<T>::identity(), Mat3<T>::diagonal(Vec3<T>(1, 1, 1)));
+  ASSERT_EQ(Mat2<T>::outer(Vec2<T>(1, 2), Vec2<T>(3, 4)),
+            Mat2<T>({3, 4, 6, 8}));
+}
+
+TYPED_TEST(MatrixTest, Arithmetic) {
+  using T = TypeParam;
+  const Mat2<T> a{1, 2, 3, 4};
+  const Mat2<T> b{0, 1, 1, 0};
+  ASSERT_EQ(a * b, Mat2<T>({2, 1, 4, 3}));
+  ASSERT_EQ(b * a, Mat2<T>({3, 4, 1, 2}));
+  ASSERT_EQ(a * Vec2<T>(1, 1), Vec2<T>(3, 7));
+  ASSERT_EQ(a + b, Mat2<T>({1, 3, 4, 4}));
+  ASSERT_EQ(a * T(2), Mat2<T>({2, 4, 6, 8}));
+  ASSERT_EQ(a.trace(), 5);
+  ASSERT_EQ(a.determinant(), -2);
+}
+
+TYPED_TEST(MatrixTest, Inverse) {
+  using T = TypeParam;
+  const Mat3<T> m{2, 0, 1, 1, 3, 0, 0, 1, 4};
+  ASSERT_NEAR(m.determinant(), 25, 1e-4);
+  ASSERT_TRUE((m * m.inverted()).equals(Mat3<T>::identity(), 1e-5));
+  const Mat4<T> n{4, 0, 0, 1, 0, 2, 0, 0, 0, 1, 3, 0, 1, 0, 0, 2};
+  ASSERT_NEAR(n.determinant(), 42, 1e-3);
+  ASSERT_TRUE((n.inverted() * n).equals(Mat4<T>::identity(), 1e-5));
+  ASSERT_EQ(Mat2<T>({1, 2, 2, 4}).inverted(), Mat2<T>());
+}
+
+TYPED_TEST(MatrixTest, DecomposeSymmetric2) {
+  using T = TypeParam;
+  const Mat2<T> m{2, 1, 1, 2};
+  Vec2<T> values;
+  Mat2<T> vectors;
+  decomposeSymmetric(m, &values, &vectors);
+  ASSERT_TRUE(values.equals(Vec2<T>(3, 1), 1e-5));
+  ASSERT_NEAR(vectors.determinant(), 1, 1e-5);
+  for (int i = 0; i < 2; ++i) {
+    const auto v = vectors.column(i);
+    ASSERT_TRUE((m * v).equals(v * values[i], 1e-5));
+  }
+}
+
+TYPED_TEST(MatrixTest, DecomposeSymmetric3) {
+  using T = TypeParam;
+  const Mat3<T> matrices[] = {
+    {4, 1, 2, 1, 3, 0, 2, 0, 5},
+    {2, 0, 0, 0, 3, 0, 0, 0, 1},
+    {2, 1, 1, 1, 2, 1, 1, 1, 2},  // Repeated eigenvalue
+    {1, 0, 0, 0, 1, 0, 0, 0, 1},
+  };
+  for (const auto& m : matrices) {
+    Vec3<T> values;
+    Mat3<T> vectors;
+    decomposeSymmetric(m, &values, &vectors);
+    ASSERT_GE(values.x, values.y);
+    ASSERT_GE(values.y, values.z);
+    ASSERT_NEAR(values.x + values.y + values.z, m.trace(), 1e-4);
+    ASSERT_NEAR(vectors.determinant(), 1, 1e-4);
+    for (int i = 0; i < 3; ++i) {
+      const auto v = vectors.column(i);
+      ASSERT_TRUE((m * v).equals(v * values[i], 1e-4));
+    }
+  }
+}
+
+TYPED_TEST(MatrixTest, DecomposeJacobi) {
+  using T = TypeParam;
+  const Mat3<T> matrices[] = {
+    {4, 1, 2, 1, 3, 0, 2, 0, 5},
+    {2, 1, 1, 1, 2, 1, 1, 1, 2},
+    {1, 1e-4, 0, 1e-4, 1, 0, 0, 0, 1},
+  };
+  std::vector<Vec3<T>> values(3);
+  std::vector<Mat3<T>> vectors(3);
+  decomposeJacobi(std::begin(matrices), std::end(matrices),
+                  values.begin(), vectors.begin());
+  for (int i = 0; i < 3; ++i) {
+    const auto& m = matrices[i];
+    Vec3<T> expected;
+    decomposeSymmetric(m, &expected, nullptr);
+    ASSERT_TRUE(values[i].equals(expected, 1e-4));
+    ASSERT_NEAR(vectors[i].determinant(), 1, 1e-4);
+    ASSERT_TRUE((vectors[i] * Mat3<T>::diagonal(values[i]) *
+                 vectors[i].transposed()).equals(m, 1e-4));
+  }
+}
+
+TYPED_TEST(MatrixTest, DecomposeSingular) {
+  using T = TypeParam;
+  const Mat3<T> matrices[] = {
+    {2, -1, 0, 4, 3, -2, 1, 0, 5},
+    {1, 2, 3, 2, 4, 6, 1, 0, 1},  // Rank 2
+    {-1, 0, 0, 0, 2, 0, 0, 0, 3},  // Reflection
+  };
+  std::vector<Mat3<T>> u(3);
+  std::vector<Vec3<T>> sigma(3);
+  std::vector<Mat3<T>> v(3);
+  decomposeSingular(std::begin(matrices), std::end(matrices),
+                    u.begin(), sigma.begin(), v.begin());
+  for (int i = 0; i < 3; ++i) {
+    const auto& m = matrices[i];
+    ASSERT_NEAR(u[i].determinant(), 1, 1e-4);
+    ASSERT_NEAR(v[i].determinant(), 1, 1e-4);
+    ASSERT_GE(sigma[i].x, std::abs(sigma[i].y));
+    ASSERT_GE(sigma[i].y, std::abs(sigma[i].z));
+    ASSERT_TRUE((u[i] * Mat3<T>::diagonal(sigma[i]) *
+                 v[i].transposed()).equals(m, 1e-4));
+  }
+  ASSERT_NEAR(sigma[1].z, 0, 1e-4);
+  ASSERT_TRUE(sigma[2].equals(Vec3<T>(3, 2, -1), 1e-5));
+}
+
+TYPED_TEST(MatrixTest, DecomposePolar) {
+  using T = TypeParam;
+  const T s = std::sqrt(T(0.5));
+  const Mat3<T> rotation{s, -s, 0, s, s, 0, 0, 0, 1};
+  const Mat3<T> stretch{2, 0.5, 0, 0.5, 1, 0, 0, 0, 3};
+  Mat3<T> r;
+  Mat3<T> p;
+  decomposePolar(rotation * stretch, &r, &p);
+  ASSERT_TRUE(r.equals(rotation, 1e-4));
+  ASSERT_TRUE(p.equals(stretch, 1e-4));
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,102 @@
+//
+//  neighbors_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/neighbors.h"
+#include "takram/math/random.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class NeighborsTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(NeighborsTest, Types);
+
+TYPED_TEST(NeighborsTest, Nearest) {
+  using T = TypeParam;
+  using V = Vec<T, 16>;
+  std::vector<V> points;
+  for (int i = 0; i < 10; ++i) {
+    points.emplace_back(T(i));
+  }
+  std::vector<std::size_t> indices;
+  nearestNeighbors(points.begin(), points.end(), V(T(6.2)), 3,
+                   std::back_inserter(indices));
+  ASSERT_EQ(indices, (std::vector<std::size_t>{6, 7, 5}));
+  indices.clear();
+  nearestNeighbors(points.begin(), points.begin() + 2, V(), 3,
+                   std::back_inserter(indices));
+  ASSERT_EQ(indices, (std::vector<std::size_t>{0, 1}));
+  indices.clear();
+  nearestNeighbors(points.begin(), points.end(), V(), 0,
+                   std::back_inserter(indices));
+  ASSERT_TRUE(indices.empty());
+}
+
+TYPED_TEST(NeighborsTest, Batch) {
+  using T = TypeParam;
+  using V = Vec<T, 12>;
+  Random<> random(1);
+  std::vector<V> points(200);
+  for (auto& point : points) {
+    for (auto& value : point) {
+      value = random.uniform<T>(-1, 1);
+    }
+  }
+  const std::vector<V> queries(points.begin(), points.begin() + 20);
+  const std::size_t k = 5;
+  std::vector<std::size_t> indices;
+  nearestNeighbors(points.begin(), points.end(),
+                   queries.begin(), queries.end(), k,
+                   std::back_inserter(indices));
+  ASSERT_EQ(indices.size(), queries.size() * k);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    const auto neighbors = indices.begin() + i * k;
+    ASSERT_EQ(neighbors[0], i);
+    std::vector<T> distances;
+    for (const auto& point : points) {
+      distances.emplace_back(queries[i].distanceSquared(point));
+    }
+    std::sort(distances.begin(), distances.end());
+    for (std::size_t j = 0; j < k; ++j) {
+      ASSERT_EQ(queries[i].distanceSquared(points[neighbors[j]]),
+                distances[j]);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,122 @@
+//
+//  oriented_rectangle_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <type_traits>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/constants.h"
+#include "takram/math/matrix.h"
+#include "takram/math/oriented_rectangle.h"
+#include "takram/math/rectangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class OrientedRectTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(OrientedRectTest, Types);
+
+TEST(OrientedRectTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<OrientedRect2d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<OrientedRect2d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<OrientedRect2d>::value);
+  ASSERT_TRUE(std::is_move_constructible<OrientedRect2d>::value);
+  ASSERT_TRUE(std::is_move_assignable<OrientedRect2d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<OrientedRect2d>::value);
+  ASSERT_TRUE(std::is_default_constructible<OrientedRect3d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<OrientedRect3d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<OrientedRect3d>::value);
+  ASSERT_TRUE(std::is_move_constructible<OrientedRect3d>::value);
+  ASSERT_TRUE(std::is_move_assignable<OrientedRect3d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<OrientedRect3d>::value);
+}
+
+TYPED_TEST(OrientedRectTest, Attributes2) {
+  using T = TypeParam;
+  const OrientedRect2<T> rect(Vec2<T>(1, 2), Vec2<T>(2, 1), pi<T>() / 2);
+  ASSERT_NEAR(rect.area(), 8, 1e-5);
+  ASSERT_NEAR(rect.perimeter(), 12, 1e-5);
+  ASSERT_TRUE(rect.bounds().equals(Rect2<T>(0, 0, 2, 4), 1e-5));
+  ASSERT_TRUE(rect.corner(0).equals(Vec2<T>(2, 0), 1e-5));
+  ASSERT_TRUE(rect.corner(2).equals(Vec2<T>(T(), 4), 1e-5));
+  ASSERT_TRUE(rect.contains(Vec2<T>(1.5, 3.5)));
+  ASSERT_FALSE(rect.contains(Vec2<T>(2.5, 2)));
+  const OrientedRect2<T> converted(Rect2<T>(1, 1, 4, 2));
+  ASSERT_EQ(converted, OrientedRect2<T>(Vec2<T>(3, 2), Vec2<T>(2, 1)));
+}
+
+TYPED_TEST(OrientedRectTest, Intersects2) {
+  using T = TypeParam;
+  const OrientedRect2<T> a(Vec2<T>(), Vec2<T>(2, 0.5), pi<T>() / 4);
+  // Overlapping bounds but separated along the diagonal of a
+  ASSERT_TRUE(a.bounds().intersects(Rect2<T>(1, -2, 1, 1)));
+  ASSERT_FALSE(a.intersects(Rect2<T>(1, -2, 1, 1)));
+  ASSERT_TRUE(a.intersects(Rect2<T>(1, 0, 1, 1)));
+  const OrientedRect2<T> b(Vec2<T>(3, 3), Vec2<T>(1, 1), pi<T>() / 4);
+  ASSERT_FALSE(a.intersects(b));
+  ASSERT_FALSE(b.intersects(a));
+  ASSERT_TRUE(a.intersects(OrientedRect2<T>(Vec2<T>(1.5, 1.5), Vec2<T>(1, 1))));
+}
+
+TYPED_TEST(OrientedRectTest, Attributes3) {
+  using T = TypeParam;
+  const Mat3<T> axes{0, -1, 0, 1, 0, 0, 0, 0, 1};
+  const OrientedRect3<T> box(Vec3<T>(1, 1, 1), Vec3<T>(2, 1, 3), axes);
+  ASSERT_NEAR(box.volume(), 48, 1e-4);
+  ASSERT_NEAR(box.area(), 88, 1e-4);
+  ASSERT_EQ(box.axis(0), Vec3<T>(T(), 1, 0));
+  ASSERT_TRUE(box.corner(7).equals(Vec3<T>(T(), 3, 4), 1e-5));
+  ASSERT_TRUE(box.contains(Vec3<T>(1.5, 2.5, -1.5)));
+  ASSERT_FALSE(box.contains(Vec3<T>(2.5, 1, 1)));
+}
+
+TYPED_TEST(OrientedRectTest, Intersects3) {
+  using T = TypeParam;
+  const OrientedRect3<T> a(Vec3<T>(), Vec3<T>(1, 1, 1));
+  const T s = std::sqrt(T(0.5));
+  const Mat3<T> rotation{s, -s, 0, s, s, 0, 0, 0, 1};
+  ASSERT_TRUE(a.intersects(OrientedRect3<T>(Vec3<T>(2.3, 0, 0),
+                                            Vec3<T>(1, 1, 1), rotation)));
+  ASSERT_FALSE(a.intersects(OrientedRect3<T>(Vec3<T>(2.5, 0, 0),
+                                             Vec3<T>(1, 1, 1), rotation)));
+  ASSERT_FALSE(a.intersects(OrientedRect3<T>(Vec3<T>(2.3, 2.3, 0),
+                                             Vec3<T>(1, 1, 1), rotation)));
+  // Separated only by the cross product of edges
+  const Mat3<T> tilted{1, 0, 0, 0, s, -s, 0, s, s};
+  const OrientedRect3<T> b(Vec3<T>(), Vec3<T>(1, 1, 1), tilted);
+  const OrientedRect3<T> c(Vec3<T>(2.5, 2.5, 0), Vec3<T>(1, 1, 1), rotation);
+  ASSERT_FALSE(b.intersects(c));
+  ASSERT_FALSE(c.intersects(b));
+  ASSERT_TRUE(a.intersects(a));
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,153 @@
+//
+//  rasterize_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/line.h"
+#include "takram/math/random.h"
+#include "takram/math/rasterize.h"
+#include "takram/math/rectangle.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class RasterizeTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(RasterizeTest, Types);
+
+TEST(RasterizeTest, Bresenham) {
+  const Rect2i clip(-100, -100, 200, 200);
+  std::vector<std::pair<int, int>> pixels;
+  rasterize(Line2i(0, 0, 5, 2), clip, [&](int x, int y) {
+    pixels.emplace_back(x, y);
+  });
+  const std::vector<std::pair<int, int>> expected{
+    {0, 0}, {1, 0}, {2, 1}, {3, 1}, {4, 2}, {5, 2}
+  };
+  ASSERT_EQ(pixels, expected);
+  pixels.clear();
+  rasterize(Line2i(3, 3, 3, 3), clip, [&](int x, int y) {
+    pixels.emplace_back(x, y);
+  });
+  ASSERT_EQ(pixels, (std::vector<std::pair<int, int>>{{3, 3}}));
+}
+
+TEST(RasterizeTest, BresenhamConnected) {
+  const Rect2i clip(-100, -100, 200, 200);
+  Random<> random;
+  for (int i = 0; i < 100; ++i) {
+    const Line2i line(random.uniform(-50, 50), random.uniform(-50, 50),
+                      random.uniform(-50, 50), random.uniform(-50, 50));
+    std::vector<std::pair<int, int>> pixels;
+    rasterize(line, clip, [&](int x, int y) {
+      pixels.emplace_back(x, y);
+    });
+    ASSERT_EQ(pixels.front(), std::make_pair(line.a.x, line.a.y));
+    ASSERT_EQ(pixels.back(), std::make_pair(line.b.x, line.b.y));
+    for (std::size_t j = 1; j < pixels.size(); ++j) {
+      ASSERT_LE(std::abs(pixels[j].first - pixels[j - 1].first), 1);
+      ASSERT_LE(std::abs(pixels[j].second - pixels[j - 1].second), 1);
+    }
+  }
+}
+
+TEST(RasterizeTest, BresenhamClipped) {
+  const Rect2i all(-100, -100, 200, 200);
+  const Rect2i clip(-7, 3, 20, 11);
+  Random<> random;
+  for (int i = 0; i < 500; ++i) {
+    const Line2i line(random.uniform(-30, 30), random.uniform(-30, 30),
+                      random.uniform(-30, 30), random.uniform(-30, 30));
+    std::vector<std::pair<int, int>> expected;
+    rasterize(line, all, [&](int x, int y) {
+      if (clip.minX() <= x && x < clip.maxX() &&
+          clip.minY() <= y && y < clip.maxY()) {
+        expected.emplace_back(x, y);
+      }
+    });
+    std::vector<std::pair<int, int>> pixels;
+    rasterize(line, clip, [&](int x, int y) {
+      pixels.emplace_back(x, y);
+    });
+    ASSERT_EQ(pixels, expected);
+  }
+}
+
+TEST(RasterizeTest, BresenhamBuffer) {
+  const Rect2i clip(2, 2, 4, 3);
+  std::vector<int> buffer(4 * 3);
+  const std::vector<Line2i> lines{{0, 2, 10, 2}, {3, 0, 3, 10}};
+  rasterize(lines.begin(), lines.end(), clip, 1, buffer.data(), 4);
+  const std::vector<int> expected{
+    1, 1, 1, 1,
+    0, 1, 0, 0,
+    0, 1, 0, 0
+  };
+  ASSERT_EQ(buffer, expected);
+}
+
+TYPED_TEST(RasterizeTest, Wu) {
+  using T = TypeParam;
+  const Rect2i clip(0, 0, 20, 20);
+  std::map<int, T> columns;
+  rasterizeAntialiased(Line2<T>(1, T(2.3), 15, T(7.7)), clip,
+                       [&](int x, int y, T coverage) {
+    ASSERT_GT(coverage, 0);
+    ASSERT_LE(coverage, 1 + 1e-5);
+    columns[x] += coverage;
+  });
+  ASSERT_EQ(columns.begin()->first, 1);
+  ASSERT_EQ(columns.rbegin()->first, 15);
+  for (int x = 2; x < 15; ++x) {
+    ASSERT_NEAR(columns[x], 1, 1e-4);
+  }
+}
+
+TYPED_TEST(RasterizeTest, WuClipped) {
+  using T = TypeParam;
+  const Rect2i clip(4, 4, 4, 4);
+  std::vector<T> buffer(4 * 4);
+  const std::vector<Line2<T>> lines{{-100, T(5.5), 100, T(5.5)}};
+  rasterizeAntialiased(lines.begin(), lines.end(), clip, T(1),
+                       buffer.data(), 4);
+  for (int x = 0; x < 4; ++x) {
+    ASSERT_NEAR(buffer[0 * 4 + x], 0, 1e-5);
+    ASSERT_NEAR(buffer[1 * 4 + x], 0.5, 1e-5);
+    ASSERT_NEAR(buffer[2 * 4 + x], 0.5, 1e-5);
+    ASSERT_NEAR(buffer[3 * 4 + x], 0, 1e-5);
+  }
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,124 @@
+//
+//  skinning_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/constants.h"
+#include "takram/math/matrix.h"
+#include "takram/math/skinning.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class SkinningTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(SkinningTest, Types);
+
+namespace {
+
+template <class T>
+Mat4<T> makeTwist(T angle, const Vec3<T>& translation) {
+  const T c = std::cos(angle);
+  const T s = std::sin(angle);
+  return Mat4<T>({
+    1, 0, 0, translation.x,
+    0, c, -s, translation.y,
+    0, s, c, translation.z,
+    0, 0, 0, 1
+  });
+}
+
+}  // namespace
+
+TEST(SkinningTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Skinnerd>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Skinnerd>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Skinnerd>::value);
+  ASSERT_TRUE(std::is_move_constructible<Skinnerd>::value);
+  ASSERT_TRUE(std::is_move_assignable<Skinnerd>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Skinnerd>::value);
+}
+
+TYPED_TEST(SkinningTest, SingleBone) {
+  using T = TypeParam;
+  const std::vector<Mat4<T>> palette{
+    Mat4<T>::identity(),
+    makeTwist(pi<T>() / 2, Vec3<T>(1, 2, 3)),
+  };
+  const std::vector<Vec3<T>> positions{{1, 1, 0}, {0, 0, 1}};
+  const std::vector<Vec4i> indices{{1, 0, 0, 0}, {0, 1, 0, 0}};
+  const std::vector<Vec4<T>> weights{{1, 0, 0, 0}, {0, 1, 0, 0}};
+  for (const auto method : {SkinningMethod::LINEAR,
+                            SkinningMethod::DUAL_QUATERNION}) {
+    Skinner<T> skinner(method);
+    skinner.setPalette(palette.begin(), palette.end());
+    std::vector<Vec3<T>> result(positions.size());
+    skinner.skinPositions(positions.begin(), positions.end(),
+                          indices.begin(), weights.begin(), result.begin());
+    ASSERT_TRUE(result[0].equals(Vec3<T>(2, 2, 4), 1e-5));
+    ASSERT_TRUE(result[1].equals(Vec3<T>(1, 1, 3), 1e-5));
+    skinner.skinNormals(positions.begin() + 1, positions.end(),
+                        indices.begin() + 1, weights.begin() + 1,
+                        result.begin());
+    ASSERT_TRUE(result[0].equals(Vec3<T>(0, -1, 0), 1e-5));
+  }
+}
+
+TYPED_TEST(SkinningTest, Twist) {
+  using T = TypeParam;
+  // Blending halfway between the identity and a half turn about x collapses
+  // linear blending to the axis, while dual quaternions keep the radius.
+  const std::vector<Mat4<T>> palette{
+    Mat4<T>::identity(),
+    makeTwist(pi<T>() * T(0.9), Vec3<T>()),
+  };
+  const std::vector<Vec3<T>> positions{{0, 1, 0}};
+  const std::vector<Vec4i> indices{{0, 1, 0, 0}};
+  const std::vector<Vec4<T>> weights{{0.5, 0.5, 0, 0}};
+  std::vector<Vec3<T>> linear(1);
+  std::vector<Vec3<T>> dual(1);
+  Skinner<T> skinner;
+  skinner.setPalette(palette.begin(), palette.end());
+  skinner.skinPositions(positions.begin(), positions.end(),
+                        indices.begin(), weights.begin(), linear.begin());
+  skinner.setMethod(SkinningMethod::DUAL_QUATERNION);
+  skinner.skinPositions(positions.begin(), positions.end(),
+                        indices.begin(), weights.begin(), dual.begin());
+  ASSERT_LT(linear[0].magnitude(), 0.2);
+  ASSERT_NEAR(dual[0].magnitude(), 1, 1e-5);
+  ASSERT_NEAR(std::atan2(dual[0].z, dual[0].y), pi<T>() * T(0.45), 1e-4);
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,106 @@
+//
+//  span_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/span.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+namespace {
+
+struct Point {
+  float x;
+  float y;
+};
+
+}  // namespace
+
+template <>
+struct LayoutCompatible<Vec2f, Point> : std::true_type {};
+
+TEST(SpanTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Span<double>>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Span<double>>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Span<double>>::value);
+  ASSERT_TRUE(std::is_move_constructible<Span<double>>::value);
+  ASSERT_TRUE(std::is_move_assignable<Span<double>>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Span<double>>::value);
+  ASSERT_TRUE((std::is_convertible<Span<int>, Span<const int>>::value));
+  ASSERT_FALSE((std::is_convertible<Span<const int>, Span<int>>::value));
+}
+
+TEST(SpanTest, Access) {
+  std::vector<int> values{1, 2, 3};
+  Span<int> span(values.data(), values.size());
+  ASSERT_EQ(span.size(), 3);
+  ASSERT_EQ(span.front(), 1);
+  ASSERT_EQ(span.back(), 3);
+  span[1] = 5;
+  ASSERT_EQ(values[1], 5);
+  const Span<const int> view = span;
+  ASSERT_EQ(std::vector<int>(view.rbegin(), view.rend()),
+            (std::vector<int>{3, 5, 1}));
+  ASSERT_TRUE(Span<int>().empty());
+}
+
+TEST(SpanTest, Reinterpret) {
+  std::vector<Point> points{{1, 2}, {3, 4}};
+  const auto span = reinterpretSpan<Vec2f>(points);
+  ASSERT_EQ(span.data(), static_cast<void *>(points.data()));
+  ASSERT_EQ(span[1], Vec2f(3, 4));
+  span[0].x = 5;
+  ASSERT_EQ(points[0].x, 5);
+  const auto& constant = points;
+  const auto view = reinterpretSpan<const Vec2f>(constant);
+  ASSERT_EQ(view.size(), 2);
+}
+
+TEST(SpanTest, Adapt) {
+  const std::vector<Point> points{{1, 2}, {3, 4}};
+  std::vector<Vec2f> storage;
+  const auto view = adaptSpan(points, &storage);
+  ASSERT_EQ(view.data(), static_cast<const void *>(points.data()));
+  ASSERT_TRUE(storage.empty());
+
+  const std::vector<Vec3f> vectors{{1, 2, 3}, {4, 5, 6}};
+  const auto copy = adaptSpan(vectors, &storage);
+  ASSERT_EQ(copy.data(), storage.data());
+  ASSERT_EQ(copy.size(), 2);
+  ASSERT_EQ(copy[1], Vec2f(4, 5));
+
+  std::vector<Vec2d> doubles;
+  ASSERT_EQ(adaptSpan(storage, &doubles)[0], Vec2d(1, 2));
+}
+
+}  // namespace math
+}  // namespace takram
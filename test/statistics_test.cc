@@ -0,0 +1,132 @@
+//
+//  statistics_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/matrix.h"
+#include "takram/math/statistics.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class StatisticsTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(StatisticsTest, Types);
+
+TEST(StatisticsTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<PointStatistics3d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<PointStatistics3d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<PointStatistics3d>::value);
+  ASSERT_TRUE(std::is_move_constructible<PointStatistics3d>::value);
+  ASSERT_TRUE(std::is_move_assignable<PointStatistics3d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<PointStatistics3d>::value);
+}
+
+TYPED_TEST(StatisticsTest, MeanAndCovariance) {
+  using T = TypeParam;
+  const std::vector<Vec2<T>> points{{1, 1}, {3, 1}, {1, 3}, {3, 3}};
+  const PointStatistics2<T> statistics(points.begin(), points.end());
+  ASSERT_EQ(statistics.count(), 4);
+  ASSERT_TRUE(statistics.mean().equals(Vec2<T>(2, 2), 1e-5));
+  ASSERT_TRUE(statistics.covariance().equals(Mat2<T>({1, 0, 0, 1}), 1e-5));
+}
+
+TYPED_TEST(StatisticsTest, FarFromOrigin) {
+  using T = TypeParam;
+  std::vector<Vec3<T>> points;
+  for (int i = 0; i < 1000; ++i) {
+    points.emplace_back(1e4 + (i % 2 ? 1 : -1), 1e4,
+                        1e4 + (i % 4 < 2 ? 2 : -2));
+  }
+  const PointStatistics3<T> statistics(points.begin(), points.end());
+  const auto covariance = statistics.covariance();
+  ASSERT_NEAR(covariance(0, 0), 1, 1e-2);
+  ASSERT_NEAR(covariance(1, 1), 0, 1e-2);
+  ASSERT_NEAR(covariance(2, 2), 4, 1e-2);
+  ASSERT_NEAR(covariance(0, 2), 0, 1e-2);
+}
+
+TYPED_TEST(StatisticsTest, Blocks) {
+  using T = TypeParam;
+  std::vector<Vec3<T>> points;
+  for (int i = 0; i < 2500; ++i) {
+    points.emplace_back(1e3 + std::sin(T(i)), 1e3 + i % 7, T(i) / 1000);
+  }
+  PointStatistics3<T> expected;
+  for (const auto& point : points) {
+    expected.add(point);
+  }
+  const PointStatistics3<T> statistics(points.begin(), points.end());
+  ASSERT_EQ(statistics.count(), expected.count());
+  ASSERT_TRUE(statistics.mean().equals(expected.mean(), 1e-3));
+  ASSERT_TRUE(statistics.covariance().equals(expected.covariance(), 1e-2));
+  ASSERT_TRUE(statistics.covariance().symmetric());
+}
+
+TYPED_TEST(StatisticsTest, Merge) {
+  using T = TypeParam;
+  std::vector<Vec3<T>> points;
+  for (int i = 0; i < 100; ++i) {
+    points.emplace_back(std::sin(T(i)), i % 7, T(i) / 10);
+  }
+  const PointStatistics3<T> whole(points.begin(), points.end());
+  PointStatistics3<T> merged;
+  PointStatistics3<T> part(points.begin() + 30, points.end());
+  merged.merge(PointStatistics3<T>(points.begin(), points.begin() + 30));
+  merged.merge(part);
+  ASSERT_EQ(merged.count(), whole.count());
+  ASSERT_TRUE(merged.mean().equals(whole.mean(), 1e-4));
+  ASSERT_TRUE(merged.covariance().equals(whole.covariance(), 1e-3));
+  part.reset();
+  ASSERT_EQ(part.count(), 0);
+}
+
+TYPED_TEST(StatisticsTest, PrincipalComponents) {
+  using T = TypeParam;
+  const Vec3<T> axis = Vec3<T>(1, 2, 2).normalized();
+  std::vector<Vec3<T>> points;
+  for (int i = -50; i <= 50; ++i) {
+    points.push_back(Vec3<T>(5, 5, 5) + axis * T(i) / 10 +
+                     Vec3<T>(i % 2 ? 0.01 : -0.01, 0, 0));
+  }
+  const PointStatistics3<T> statistics(points.begin(), points.end());
+  Vec3<T> variances;
+  Mat3<T> axes;
+  statistics.principalComponents(&variances, &axes);
+  ASSERT_GT(variances.x, 100 * variances.y);
+  ASSERT_NEAR(std::abs(axes.column(0).dot(axis)), 1, 1e-4);
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,142 @@
+//
+//  stroke_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/stroke.h"
+#include "takram/math/triangle.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class StrokeTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(StrokeTest, Types);
+
+TEST(StrokeTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Stroker<double>>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Stroker<double>>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Stroker<double>>::value);
+  ASSERT_TRUE(std::is_move_constructible<Stroker<double>>::value);
+  ASSERT_TRUE(std::is_move_assignable<Stroker<double>>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Stroker<double>>::value);
+}
+
+TYPED_TEST(StrokeTest, ButtSegment) {
+  const std::vector<Vec2<TypeParam>> points{{0, 0}, {4, 0}};
+  const Stroker<TypeParam> stroker(2, StrokeJoin::MITER, StrokeCap::BUTT);
+  std::vector<Triangle2<TypeParam>> triangles;
+  stroker.stroke(points.begin(), points.end(), false,
+                 std::back_inserter(triangles));
+  ASSERT_EQ(triangles.size(), 2);
+  TypeParam area{};
+  for (const auto& triangle : triangles) {
+    const auto& t = triangle;
+    ASSERT_GE((t.b - t.a).cross(t.c - t.a), 0);
+    area += t.area();
+  }
+  ASSERT_NEAR(area, 8, 1e-4);
+}
+
+TYPED_TEST(StrokeTest, SquareCapsExtendSegment) {
+  const std::vector<Vec2<TypeParam>> points{{0, 0}, {4, 0}};
+  const Stroker<TypeParam> stroker(2, StrokeJoin::MITER, StrokeCap::SQUARE);
+  std::vector<Triangle2<TypeParam>> triangles;
+  stroker.stroke(points.begin(), points.end(), false,
+                 std::back_inserter(triangles));
+  TypeParam area{};
+  for (const auto& triangle : triangles) {
+    area += triangle.area();
+  }
+  ASSERT_NEAR(area, 12, 1e-4);
+}
+
+TYPED_TEST(StrokeTest, RoundCapsApproximateDisc) {
+  const std::vector<Vec2<TypeParam>> points{{0, 0}, {4, 0}};
+  const Stroker<TypeParam> stroker(2, StrokeJoin::ROUND, StrokeCap::ROUND,
+                                   4, 64);
+  std::vector<Triangle2<TypeParam>> triangles;
+  stroker.stroke(points.begin(), points.end(), false,
+                 std::back_inserter(triangles));
+  TypeParam area{};
+  for (const auto& triangle : triangles) {
+    area += triangle.area();
+  }
+  ASSERT_NEAR(area, 8 + pi<TypeParam>(), 1e-2);
+}
+
+TYPED_TEST(StrokeTest, MiterJoinFallsBackToBevel) {
+  const std::vector<Vec2<TypeParam>> points{{0, 0}, {4, 0}, {0, 1}};
+  std::vector<Triangle2<TypeParam>> miter;
+  std::vector<Triangle2<TypeParam>> bevel;
+  Stroker<TypeParam>(1, StrokeJoin::MITER, StrokeCap::BUTT, 100)
+      .stroke(points.begin(), points.end(), false, std::back_inserter(miter));
+  Stroker<TypeParam>(1, StrokeJoin::MITER, StrokeCap::BUTT, 2)
+      .stroke(points.begin(), points.end(), false, std::back_inserter(bevel));
+  ASSERT_EQ(miter.size(), bevel.size() + 1);
+}
+
+TYPED_TEST(StrokeTest, IndexedMatchesCapacity) {
+  const std::vector<Vec2<TypeParam>> points{
+    {0, 0}, {4, 0}, {4, 4}, {0, 4}, {0, 0}, {2, 2}, {5, 1}
+  };
+  const std::vector<std::size_t> offsets{0, 4, 7};
+  for (const auto join : {StrokeJoin::MITER,
+                          StrokeJoin::ROUND,
+                          StrokeJoin::BEVEL}) {
+    for (const auto cap : {StrokeCap::BUTT,
+                           StrokeCap::ROUND,
+                           StrokeCap::SQUARE}) {
+      const Stroker<TypeParam> stroker(1, join, cap);
+      for (const bool closed : {false, true}) {
+        const auto capacity = stroker.capacity(
+            points.begin(), offsets.begin(), offsets.end(), closed);
+        std::vector<Vec2<TypeParam>> vertices;
+        std::vector<typename Stroker<TypeParam>::Index> indices;
+        stroker.stroke(points.begin(), offsets.begin(), offsets.end(), closed,
+                       &vertices, &indices);
+        ASSERT_LE(vertices.size(), capacity.first);
+        ASSERT_LE(indices.size(), capacity.second);
+        ASSERT_EQ(vertices.capacity(), capacity.first);
+        ASSERT_EQ(indices.size() % 3, 0);
+        for (const auto index : indices) {
+          ASSERT_LT(index, vertices.size());
+        }
+      }
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace takram
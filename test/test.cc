@@ -35,6 +35,7 @@ template class Random<>;
 template class Vec<double, 2>;
 template class Vec<double, 3>;
 template class Vec<double, 4>;
+template class Vec<double, 8>;
 template class Size<double, 2>;
 template class Size<double, 3>;
 template class Line<double, 2>;
@@ -42,7 +43,36 @@ template class Line<double, 3>;
 template class Triangle<double, 2>;
 template class Triangle<double, 3>;
 template class Rect<double, 2>;
+template class OrientedRect<double, 2>;
+template class OrientedRect<double, 3>;
 template class Circle<double, 2>;
+template class Ellipse<double, 2>;
+template class Stroker<double>;
+template class GJK<double, 2>;
+template class GJK<double, 3>;
+template class Voxelizer<double>;
+template class GridTraversal<double, 2>;
+template class GridTraversal<double, 3>;
+template class LineFitter<double>;
+template class CircleFitter<double>;
+template class PlaneFitter<double>;
+template class EllipseFitter<double>;
+template class Mat<double, 2>;
+template class Mat<double, 3>;
+template class Mat<double, 4>;
+template class PointStatistics<double, 2>;
+template class PointStatistics<double, 3>;
+template class KDTree<double, 2>;
+template class KDTree<double, 3>;
+template class KDTreeView<double, 2>;
+template class KDTreeView<double, 3>;
+template class ICP<double>;
+template class Distortion<double>;
+template class UndistortionMap<double>;
+template class Camera<double>;
+template class Skinner<double>;
+template class BlendLayer<double>;
+template class Span<double>;
 
 }  // namespace math
 }  // namespace takram
@@ -0,0 +1,132 @@
+//
+//  traversal_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/line.h"
+#include "takram/math/size.h"
+#include "takram/math/traversal.h"
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class TraversalTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(TraversalTest, Types);
+
+TEST(TraversalTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<GridTraversal3d>::value);
+  ASSERT_TRUE(std::is_copy_constructible<GridTraversal3d>::value);
+  ASSERT_TRUE(std::is_copy_assignable<GridTraversal3d>::value);
+  ASSERT_TRUE(std::is_move_constructible<GridTraversal3d>::value);
+  ASSERT_TRUE(std::is_move_assignable<GridTraversal3d>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<GridTraversal3d>::value);
+}
+
+TYPED_TEST(TraversalTest, Traverse2) {
+  using T = TypeParam;
+  const Line2<T> line({T(0.5), T(0.5)}, {T(3.5), T(1.9)});
+  std::vector<Vec2i> cells;
+  T length{};
+  traverse(line, Vec2<T>(), Size2<T>(1, 1),
+           [&](const GridTraversal<T, 2>& traversal) {
+    cells.emplace_back(traversal.cell());
+    length += traversal.exit() - traversal.entry();
+    return true;
+  });
+  const std::vector<Vec2i> expected{{0, 0}, {1, 0}, {1, 1}, {2, 1}, {3, 1}};
+  ASSERT_EQ(cells, expected);
+  ASSERT_NEAR(length, 1, 1e-5);
+}
+
+TYPED_TEST(TraversalTest, Traverse3) {
+  using T = TypeParam;
+  const Line3<T> line({T(-0.5), T(1.5), T(5)}, {T(-0.5), T(1.5), T(-1)});
+  std::vector<Vec3i> cells;
+  traverse(line, Vec3<T>(), Size3<T>(1, 1, 2),
+           [&](const GridTraversal<T, 3>& traversal) {
+    cells.emplace_back(traversal.cell());
+    return true;
+  });
+  const std::vector<Vec3i> expected{
+    {-1, 1, 2}, {-1, 1, 1}, {-1, 1, 0}, {-1, 1, -1}
+  };
+  ASSERT_EQ(cells, expected);
+}
+
+TYPED_TEST(TraversalTest, Batch) {
+  using T = TypeParam;
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  const std::vector<Line2<T>> lines{
+    {{T(0.5), T(0.5)}, {T(9.5), T(0.5)}},
+    {{T(0.5), T(1.5)}, {T(2.5), T(1.5)}},
+    {{T(0.5), T(2.5)}, {T(0.5), T(2.5)}},
+    {{nan, T(3.5)}, {T(0.5), T(3.5)}}
+  };
+  std::vector<std::vector<int>> visited(lines.size());
+  traverse(lines.begin(), lines.end(), Vec2<T>(), Size2<T>(1, 1),
+           [&](std::size_t index, const GridTraversal<T, 2>& traversal) {
+    visited[index].emplace_back(traversal.cell().x);
+    return traversal.cell().x < 4;
+  });
+  ASSERT_EQ(visited[0], (std::vector<int>{0, 1, 2, 3, 4}));
+  ASSERT_EQ(visited[1], (std::vector<int>{0, 1, 2}));
+  ASSERT_EQ(visited[2], (std::vector<int>{0}));
+  ASSERT_TRUE(visited[3].empty());
+}
+
+TYPED_TEST(TraversalTest, Unbounded) {
+  using T = TypeParam;
+  const T far = T(1e20);
+  const int limit = 1 << 30;
+  GridTraversal<T, 2> traversal(Line2<T>({-far, T(0.5)}, {far, T(0.5)}),
+                                Vec2<T>(), Size2<T>(1, 1));
+  ASSERT_FALSE(traversal.done());
+  ASSERT_EQ(traversal.cell(), Vec2i(-limit, 0));
+  traversal.set(Line2<T>({T(0.5), T(0.5)}, {far, T(0.5)}),
+                Vec2<T>(), Size2<T>(1, 1));
+  std::vector<int> cells;
+  for (; !traversal.done() && cells.size() < 3; traversal.next()) {
+    cells.emplace_back(traversal.cell().x);
+  }
+  ASSERT_EQ(cells, (std::vector<int>{0, 1, 2}));
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  traversal.set(Line2<T>({nan, T(0.5)}, {T(0.5), T(0.5)}),
+                Vec2<T>(), Size2<T>(1, 1));
+  ASSERT_TRUE(traversal.done());
+}
+
+}  // namespace math
+}  // namespace takram
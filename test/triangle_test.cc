@@ -380,5 +380,34 @@ TYPED_TEST(TriangleTest, ImplicitlyConvertibleFromOtherTypes) {
   }
 }
 
+TYPED_TEST(TriangleTest, IntersectsTriangle) {
+  using T = TypeParam;
+  const Triangle3<T> triangle({0, 0, 0}, {4, 0, 0}, {0, 4, 0});
+  ASSERT_TRUE(triangle.intersects(
+      Triangle3<T>({1, 1, 0}, {1, 1, 2}, {2, 1, 1})));
+  ASSERT_TRUE(triangle.intersects(
+      Triangle3<T>({1, 1, 0}, {2, 1, 0}, {1, 2, 0})));
+  ASSERT_TRUE(triangle.intersects(
+      Triangle3<T>({4, 0, 0}, {5, 0, 0}, {5, 1, 0})));
+  ASSERT_FALSE(triangle.intersects(
+      Triangle3<T>({3, 3, 0}, {5, 3, 0}, {3, 5, 0})));
+  ASSERT_FALSE(triangle.intersects(
+      Triangle3<T>({0, 0, 1}, {4, 0, 1}, {0, 4, 1})));
+  ASSERT_FALSE(triangle.intersects(
+      Triangle3<T>({3, 3, 0}, {3, 3, 2}, {4, 4, 1})));
+}
+
+TYPED_TEST(TriangleTest, IntersectsBox) {
+  using T = TypeParam;
+  const Triangle3<T> triangle({0, 0, 0}, {4, 0, 0}, {0, 4, 0});
+  const Vec3<T> extent(1, 1, 1);
+  ASSERT_TRUE(triangle.intersects(Vec3<T>(1, 1, 1), extent));
+  ASSERT_TRUE(triangle.intersects(Vec3<T>(3, 3, 0), extent));
+  ASSERT_TRUE(triangle.intersects(Vec3<T>(5, 1, 1), extent));
+  ASSERT_FALSE(triangle.intersects(Vec3<T>(1, 1, 3), extent));
+  ASSERT_FALSE(triangle.intersects(Vec3<T>(4, 4, 1), extent));
+  ASSERT_FALSE(triangle.intersects(Vec3<T>(6, 1, 0), extent));
+}
+
 }  // namespace math
 }  // namespace takram
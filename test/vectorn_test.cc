@@ -0,0 +1,134 @@
+//
+//  vectorn_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <sstream>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/vector.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class VecNTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(VecNTest, Types);
+
+TEST(VecNTest, Concepts) {
+  using V = Vec<double, 8>;
+  ASSERT_TRUE(std::is_default_constructible<V>::value);
+  ASSERT_TRUE(std::is_copy_constructible<V>::value);
+  ASSERT_TRUE(std::is_copy_assignable<V>::value);
+  ASSERT_TRUE(std::is_move_constructible<V>::value);
+  ASSERT_TRUE(std::is_move_assignable<V>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<V>::value);
+  ASSERT_EQ(sizeof(V), sizeof(double) * 8);
+}
+
+TYPED_TEST(VecNTest, Construction) {
+  using T = TypeParam;
+  const Vec<T, 7> zero;
+  ASSERT_TRUE(zero.empty());
+  const Vec<T, 7> filled(2);
+  for (const auto value : filled) {
+    ASSERT_EQ(value, 2);
+  }
+  const Vec<T, 7> partial{1, 2, 3};
+  ASSERT_EQ(partial[2], 3);
+  ASSERT_EQ(partial[3], 0);
+  ASSERT_EQ(partial.back(), 0);
+  const T values[]{1, 2, 3, 4, 5, 6, 7};
+  const Vec<T, 7> array(values);
+  ASSERT_EQ(array.front(), 1);
+  ASSERT_EQ(array.back(), 7);
+  ASSERT_NE(array, partial);
+  ASSERT_LT(partial, array);
+  ASSERT_EQ((Vec<T, 7>(Vec<int, 7>(3))), (Vec<T, 7>(3)));
+}
+
+TYPED_TEST(VecNTest, Arithmetic) {
+  using T = TypeParam;
+  const Vec<T, 6> a{1, 2, 3, 4, 5, 6};
+  const Vec<T, 6> b(2);
+  ASSERT_EQ(a + b, (Vec<T, 6>{3, 4, 5, 6, 7, 8}));
+  ASSERT_EQ(a - b, (Vec<T, 6>{-1, 0, 1, 2, 3, 4}));
+  ASSERT_EQ(a * b, a * 2);
+  ASSERT_EQ(a / b, a / 2);
+  ASSERT_EQ(2 * a, a + a);
+  ASSERT_EQ(-a, a * -1);
+  ASSERT_EQ(10 - a, (Vec<T, 6>{9, 8, 7, 6, 5, 4}));
+}
+
+TYPED_TEST(VecNTest, Metrics) {
+  using T = TypeParam;
+  Vec<T, 9> a;
+  Vec<T, 9> b;
+  T dot{};
+  T distance{};
+  for (int i = 0; i < 9; ++i) {
+    a[i] = i + 1;
+    b[i] = 9 - i;
+    dot += a[i] * b[i];
+    distance += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  ASSERT_EQ(a.dot(b), dot);
+  ASSERT_EQ(a.distanceSquared(b), distance);
+  ASSERT_NEAR(a.distance(b), std::sqrt(distance), 1e-5);
+  ASSERT_NEAR(a.magnitudeSquared(), 285, 1e-5);
+  ASSERT_NEAR(a.normalized().magnitude(), 1, 1e-5);
+  ASSERT_NEAR(a.limited(2).magnitude(), 2, 1e-5);
+  ASSERT_TRUE(a.lerp(b, 0.5).equals(Vec<T, 9>(5), 1e-5));
+  ASSERT_TRUE((Vec<T, 9>().normalized().empty()));
+}
+
+TYPED_TEST(VecNTest, Iteration) {
+  using T = TypeParam;
+  Vec<T, 6> a{1, 2, 3, 4, 5, 6};
+  const Vec<T, 6>& b = a;
+  ASSERT_EQ(std::vector<T>(a.begin(), a.end()),
+            (std::vector<T>{1, 2, 3, 4, 5, 6}));
+  ASSERT_EQ(std::vector<T>(a.rbegin(), a.rend()),
+            (std::vector<T>{6, 5, 4, 3, 2, 1}));
+  ASSERT_EQ(std::vector<T>(b.rbegin(), b.rend()),
+            (std::vector<T>{6, 5, 4, 3, 2, 1}));
+}
+
+TEST(VecNTest, Stream) {
+  std::ostringstream stream;
+  stream << Vec<int, 5>{1, 2, 3, 4, 5};
+  ASSERT_EQ(stream.str(), "( 1, 2, 3, 4, 5 )");
+  std::unordered_set<Vec<int, 5>> set{Vec<int, 5>(1), Vec<int, 5>(1)};
+  ASSERT_EQ(set.size(), 1);
+}
+
+}  // namespace math
+}  // namespace takram
@@ -0,0 +1,117 @@
+//
+//  voxelizer_test.cc
+//
+//  The MIT License
+//
+//  Copyright (C) 2016 Shota Matsuda
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a
+//  copy of this software and associated documentation files (the "Software"),
+//  to deal in the Software without restriction, including without limitation
+//  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//  and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+//  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+//  DEALINGS IN THE SOFTWARE.
+//
+
+
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "takram/math/size.h"
+#include "takram/math/triangle.h"
+#include "takram/math/vector.h"
+#include "takram/math/voxelizer.h"
+
+namespace takram {
+namespace math {
+
+template <class T>
+class VoxelizerTest : public ::testing::Test {};
+
+using Types = ::testing::Types<float, double>;
+TYPED_TEST_CASE(VoxelizerTest, Types);
+
+TEST(VoxelizerTest, Concepts) {
+  ASSERT_TRUE(std::is_default_constructible<Voxelizerd>::value);
+  ASSERT_TRUE(std::is_copy_constructible<Voxelizerd>::value);
+  ASSERT_TRUE(std::is_copy_assignable<Voxelizerd>::value);
+  ASSERT_TRUE(std::is_move_constructible<Voxelizerd>::value);
+  ASSERT_TRUE(std::is_move_assignable<Voxelizerd>::value);
+  ASSERT_FALSE(std::has_virtual_destructor<Voxelizerd>::value);
+}
+
+TYPED_TEST(VoxelizerTest, Plane) {
+  using T = TypeParam;
+  Voxelizer<T> voxelizer(Vec3<T>(), Vec3<T>(1, 1, 1), Size3i(8, 8, 8));
+  const Triangle3<T> triangle({0, 0, T(4.5)}, {8, 0, T(4.5)}, {8, 8, T(4.5)});
+  voxelizer.add(triangle);
+  for (int y = 0; y < 8; ++y) {
+    for (int x = 0; x < 8; ++x) {
+      ASSERT_EQ(voxelizer.contains(x, y, 4), x >= y || x + 1 == y);
+      ASSERT_FALSE(voxelizer.contains(x, y, 3));
+      ASSERT_FALSE(voxelizer.contains(x, y, 5));
+    }
+  }
+}
+
+TYPED_TEST(VoxelizerTest, LargeTriangle) {
+  using T = TypeParam;
+  Voxelizer<T> voxelizer(Vec3<T>(), Vec3<T>(1, 1, 1), Size3i(4, 4, 4));
+  const T far = T(1e12);
+  voxelizer.add(Triangle3<T>({-far, -far, T(1.5)},
+                             {far, -far, T(1.5)},
+                             {0, far, T(1.5)}));
+  ASSERT_EQ(voxelizer.count(), 16);
+  for (int y = 0; y < 4; ++y) {
+    for (int x = 0; x < 4; ++x) {
+      ASSERT_TRUE(voxelizer.contains(x, y, 1));
+    }
+  }
+}
+
+TYPED_TEST(VoxelizerTest, NaN) {
+  using T = TypeParam;
+  Voxelizer<T> voxelizer(Vec3<T>(), Vec3<T>(1, 1, 1), Size3i(4, 4, 4));
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  voxelizer.add(Triangle3<T>({nan, 0, 1}, {3, 0, 1}, {0, 3, 1}));
+  voxelizer.add(Triangle3<T>({0, 0, 1}, {3, nan, 1}, {0, 3, 1}));
+  voxelizer.add(Triangle3<T>({0, 0, 1}, {3, 0, 1}, {0, 3, nan}));
+  ASSERT_EQ(voxelizer.count(), 0);
+}
+
+TYPED_TEST(VoxelizerTest, Merge) {
+  using T = TypeParam;
+  const std::vector<Triangle3<T>> triangles{
+    {{-1, -1, 1}, {9, -1, 1}, {-1, 9, 1}},
+    {{T(2.5), 0, 0}, {T(2.5), 8, 0}, {T(2.5), 0, 8}},
+    {{20, 20, 20}, {21, 20, 20}, {20, 21, 20}}
+  };
+  Voxelizer<T> whole(Vec3<T>(), Vec3<T>(1, 1, 1), Size3i(4, 4, 4));
+  whole.add(triangles.begin(), triangles.end());
+  Voxelizer<T> first(whole.origin(), whole.cell(), whole.resolution());
+  Voxelizer<T> second(first);
+  first.add(triangles.begin(), triangles.begin() + 1);
+  second.add(triangles.begin() + 1, triangles.end());
+  first.merge(second);
+  ASSERT_EQ(first.words(), whole.words());
+  ASSERT_EQ(whole.count(), 16 + 16 + 16 - 4 - 4);
+  whole.clear();
+  ASSERT_EQ(whole.count(), 0);
+}
+
+}  // namespace math
+}  // namespace takram